@@ -0,0 +1,36 @@
+#ifndef COMPILER_BENCHMARK_HELPERS_HPP
+#define COMPILER_BENCHMARK_HELPERS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+/// Run Fn Iterations times and return the best wall time in seconds.
+/// The best run is taken to filter out noise from other processes.
+template <typename Function>
+double MeasureBest(unsigned Iterations, Function &&Fn) {
+  double Best = 1e100;
+  for (unsigned It = 0U; It < Iterations; ++It) {
+    auto Start = std::chrono::steady_clock::now();
+    Fn();
+    auto End = std::chrono::steady_clock::now();
+    Best = std::min(Best, std::chrono::duration<double>(End - Start).count());
+  }
+  return Best;
+}
+
+/// Prevent compiler from optimizing out computations with unused result.
+template <typename T> void DoNotOptimize(const T &Value) {
+  asm volatile("" : : "g"(&Value) : "memory");
+}
+
+inline void ReportThroughput(const char *Name, std::size_t Bytes,
+                             double Seconds) {
+  std::printf("%-40s %10.1f MB/s\n", Name, Bytes / Seconds / 1e6);
+}
+
+inline void ReportTime(const char *Name, double Seconds) {
+  std::printf("%-40s %10.3f ms\n", Name, Seconds * 1e3);
+}
+
+#endif // COMPILER_BENCHMARK_HELPERS_HPP
@@ -0,0 +1,219 @@
+#include "BenchmarkHelpers.hpp"
+#include "FrontEnd/AST/ASTBinaryOperator.hpp"
+#include "FrontEnd/AST/ASTBooleanLiteral.hpp"
+#include "FrontEnd/AST/ASTBreakStmt.hpp"
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTContinueStmt.hpp"
+#include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTErrorNode.hpp"
+#include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
+#include "FrontEnd/AST/ASTForStmt.hpp"
+#include "FrontEnd/AST/ASTFunctionCall.hpp"
+#include "FrontEnd/AST/ASTFunctionDecl.hpp"
+#include "FrontEnd/AST/ASTIfStmt.hpp"
+#include "FrontEnd/AST/ASTIntegerLiteral.hpp"
+#include "FrontEnd/AST/ASTReturnStmt.hpp"
+#include "FrontEnd/AST/ASTStringLiteral.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTUnaryOperator.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/ASTVisitor.hpp"
+#include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include "FrontEnd/AST/FlatAST.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static std::string Repeat(std::string_view Pattern, std::size_t Size) {
+  std::string Result;
+  Result.reserve(Size + Pattern.size());
+  while (Result.size() < Size)
+    Result += Pattern;
+  return Result;
+}
+
+static constexpr std::size_t InputSize = 4U * 1024U * 1024U;
+static constexpr unsigned Iterations = 5U;
+
+namespace {
+
+/// Count all nodes and symbols of tree.
+class CountVisitor : public ASTVisitor {
+public:
+  CountVisitor() : Nodes(0U), Symbols(0U) {}
+
+  void Count(const ASTNode *Node) const {
+    if (!Node)
+      return;
+    ++Nodes;
+    Node->Accept(this);
+  }
+
+  void CountAll(const ASTNodeList &List) const {
+    for (const ASTNode *Node : List)
+      Count(Node);
+  }
+
+  void Visit(const ASTBinaryOperator *Binary) const override {
+    Count(Binary->GetLHS());
+    Count(Binary->GetRHS());
+  }
+  void Visit(const ASTBooleanLiteral *) const override {}
+  void Visit(const ASTBreakStmt *) const override {}
+  void Visit(const ASTCompoundStmt *Stmt) const override {
+    CountAll(Stmt->GetStmts());
+  }
+  void Visit(const ASTContinueStmt *) const override {}
+  void Visit(const ASTDoWhileStmt *Stmt) const override {
+    Count(Stmt->GetBody());
+    Count(Stmt->GetCondition());
+  }
+  void Visit(const ASTErrorNode *) const override {}
+  void Visit(const ASTFloatingPointLiteral *) const override {}
+  void Visit(const ASTForStmt *Stmt) const override {
+    Count(Stmt->GetInit());
+    Count(Stmt->GetCondition());
+    Count(Stmt->GetIncrement());
+    Count(Stmt->GetBody());
+  }
+  void Visit(const ASTFunctionDecl *Decl) const override {
+    CountAll(Decl->GetArguments());
+    Count(Decl->GetBody());
+  }
+  void Visit(const ASTFunctionCall *Call) const override {
+    CountAll(Call->GetArguments());
+  }
+  void Visit(const ASTIfStmt *Stmt) const override {
+    Count(Stmt->GetCondition());
+    Count(Stmt->GetThenBody());
+    Count(Stmt->GetElseBody());
+  }
+  void Visit(const ASTIntegerLiteral *) const override {}
+  void Visit(const ASTReturnStmt *Stmt) const override {
+    Count(Stmt->GetOperand());
+  }
+  void Visit(const ASTStringLiteral *) const override {}
+  void Visit(const ASTSymbol *) const override { ++Symbols; }
+  void Visit(const ASTUnaryOperator *Unary) const override {
+    Count(Unary->GetOperand());
+  }
+  void Visit(const ASTVarDecl *Decl) const override {
+    Count(Decl->GetDeclareBody());
+  }
+  void Visit(const ASTWhileStmt *Stmt) const override {
+    Count(Stmt->GetCondition());
+    Count(Stmt->GetBody());
+  }
+
+  mutable std::size_t Nodes;
+  mutable std::size_t Symbols;
+};
+
+/// The same, but with dispatch by switch on node type.
+class StaticCountVisitor : public RecursiveASTVisitor<StaticCountVisitor> {
+public:
+  StaticCountVisitor() : Nodes(0U), Symbols(0U) {}
+
+  using RecursiveASTVisitor::Visit;
+
+  void Traverse(const ASTNode *Node) {
+    if (!Node)
+      return;
+    ++Nodes;
+    RecursiveASTVisitor::Traverse(Node);
+  }
+
+  void Visit(const ASTSymbol *) { ++Symbols; }
+
+  std::size_t Nodes;
+  std::size_t Symbols;
+};
+
+} // namespace
+
+/// Walk of flat AST by child links, as tree walk does.
+static void CountFlat(const FlatAST &AST, FlatAST::NodeIndex I,
+                      std::size_t &Nodes, std::size_t &Symbols) {
+  if (AST.GetType(I) == ASTType::BASE_NODE)
+    return;
+  ++Nodes;
+  if (AST.GetType(I) == ASTType::SYMBOL)
+    ++Symbols;
+  for (FlatAST::NodeIndex C = AST.GetFirstChild(I); C != FlatAST::None;
+       C = AST.GetNextSibling(C))
+    CountFlat(AST, C, Nodes, Symbols);
+}
+
+/// Count nodes and symbols of the whole tree.
+static void TraversalTime(const std::string &Input) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  ASTContext Context;
+  ASTNode *AST = Parser(&Context, &Buffer, &S, Tokens.data(),
+                        Tokens.data() + Tokens.size())
+                     .Parse();
+
+  double Seconds =
+      MeasureBest(Iterations, [&] { DoNotOptimize(FlatAST(AST)); });
+  ReportTime("  flatten", Seconds);
+  FlatAST Flat(AST);
+  std::printf("  %u nodes, with placeholders\n", Flat.Size());
+
+  Seconds = MeasureBest(Iterations, [&] {
+    CountVisitor Visitor;
+    Visitor.Count(AST);
+    DoNotOptimize(Visitor.Nodes + Visitor.Symbols);
+  });
+  ReportTime("  virtual visitor", Seconds);
+
+  Seconds = MeasureBest(Iterations, [&] {
+    StaticCountVisitor Visitor;
+    Visitor.Traverse(AST);
+    DoNotOptimize(Visitor.Nodes + Visitor.Symbols);
+  });
+  ReportTime("  static visitor", Seconds);
+
+  Seconds = MeasureBest(Iterations, [&] {
+    std::size_t Nodes = 0U;
+    std::size_t Symbols = 0U;
+    CountFlat(Flat, 0U, Nodes, Symbols);
+    DoNotOptimize(Nodes + Symbols);
+  });
+  ReportTime("  flat, child links", Seconds);
+
+  Seconds = MeasureBest(Iterations, [&] {
+    std::size_t Nodes = 0U;
+    std::size_t Symbols = 0U;
+    for (FlatAST::NodeIndex I = 0U; I < Flat.Size(); ++I) {
+      Nodes += Flat.GetType(I) != ASTType::BASE_NODE;
+      Symbols += Flat.GetType(I) == ASTType::SYMBOL;
+    }
+    DoNotOptimize(Nodes + Symbols);
+  });
+  ReportTime("  flat, linear scan", Seconds);
+}
+
+int main() {
+  std::string Source = Repeat("int function(int number, int other) {\n"
+                              "    int result = number * 2 + other;\n"
+                              "    while (result < 100) {\n"
+                              "        result += number << 1;\n"
+                              "        if (result == 50) {\n"
+                              "            break;\n"
+                              "        }\n"
+                              "    }\n"
+                              "    string message = \"done\";\n"
+                              "    float coefficient = 1.618;\n"
+                              "    return result - (number + 1) * 3;\n"
+                              "}\n\n",
+                              InputSize);
+
+  std::printf("AST traversal, source:\n");
+  TraversalTime(Source);
+}
@@ -0,0 +1,151 @@
+#include "BenchmarkHelpers.hpp"
+#include "FrontEnd/Lex/CharClass.hpp"
+#include "FrontEnd/Lex/IncrementalLexer.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/ParallelLexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static std::string Repeat(std::string_view Pattern, std::size_t Size) {
+  std::string Result;
+  Result.reserve(Size + Pattern.size());
+  while (Result.size() < Size)
+    Result += Pattern;
+  return Result;
+}
+
+static constexpr std::size_t InputSize = 16U * 1024U * 1024U;
+static constexpr unsigned Iterations = 5U;
+
+static void LexerThroughput(const char *Name, const std::string &Input) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  double Seconds = MeasureBest(Iterations, [&] {
+    Storage S;
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    DoNotOptimize(Tokens);
+  });
+  ReportThroughput(Name, Input.size(), Seconds);
+}
+
+static void ParallelLexerThroughput(const char *Name, const std::string &Input,
+                                    unsigned Threads) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  weak::ThreadPool Pool(Threads);
+  double Seconds = MeasureBest(Iterations, [&] {
+    Storage S;
+    auto Tokens = ParallelLexer(&S, &Buffer, &Pool).Analyze();
+    DoNotOptimize(Tokens);
+  });
+  ReportThroughput(Name, Input.size(), Seconds);
+}
+
+/// Type one character in the middle of input and erase it, lexing input
+/// after each edit either from scratch or incrementally.
+static void RelexTime(const std::string &Input) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  auto Middle = static_cast<SourceLocation>(Input.find('\n', Input.size() / 2));
+  TextEdit Type{Middle, /*RemovedLength=*/0U, /*InsertedText=*/"x"};
+  std::string Edited = ApplyEdit(Input, Type);
+  SourceBuffer EditedBuffer("<benchmark>", Edited);
+  TextEdit Erase{Middle, /*RemovedLength=*/1U, /*InsertedText=*/""};
+
+  double Full = MeasureBest(Iterations, [&] {
+    Storage S;
+    auto Tokens = Lexer(&S, &EditedBuffer).Analyze();
+    DoNotOptimize(Tokens);
+    Tokens = Lexer(&S, &Buffer).Analyze();
+    DoNotOptimize(Tokens);
+  });
+  ReportTime("  full", Full);
+
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  double Incremental = MeasureBest(Iterations, [&] {
+    Tokens = IncrementalLexer(&S, &EditedBuffer).Relex(std::move(Tokens), Type);
+    DoNotOptimize(Tokens);
+    Tokens = IncrementalLexer(&S, &Buffer).Relex(std::move(Tokens), Erase);
+    DoNotOptimize(Tokens);
+  });
+  ReportTime("  incremental", Incremental);
+}
+
+/// Run skip function over whole input, restarting after each stop,
+/// like the lexer does.
+template <typename SkipFunction>
+static void SkipThroughput(const char *Name, const std::string &Input,
+                           SkipFunction &&Skip) {
+  const char *Start = Input.data();
+  const char *End = Input.data() + Input.size();
+  double Seconds = MeasureBest(Iterations, [&] {
+    for (const char *Ptr = Start; Ptr != End;) {
+      Ptr = Skip(Ptr, End);
+      if (Ptr != End)
+        ++Ptr;
+    }
+  });
+  ReportThroughput(Name, Input.size(), Seconds);
+}
+
+template <typename CountFunction>
+static void CountThroughput(const char *Name, const std::string &Input,
+                            CountFunction &&Count) {
+  double Seconds = MeasureBest(Iterations, [&] {
+    std::size_t Lines = Count(Input.data(), Input.data() + Input.size());
+    DoNotOptimize(Lines);
+  });
+  ReportThroughput(Name, Input.size(), Seconds);
+}
+
+int main() {
+  std::string Source = Repeat("int fibonacci(int number) {\n"
+                              "    if (number <= 1) {\n"
+                              "        return number;\n"
+                              "    }\n"
+                              "    string message = \"computing next\";\n"
+                              "    float coefficient = 1.618;\n"
+                              "    return fibonacci(number - 1) +\n"
+                              "           fibonacci(number - 2);\n"
+                              "}\n\n",
+                              InputSize);
+  std::string Indented =
+      Repeat("                                        x = 1;\n", InputSize);
+  std::string Identifiers =
+      Repeat("very_long_identifier_name_used_in_some_program_1 ", InputSize);
+  std::string Strings = Repeat(
+      "\"a fairly long string literal, that contains no escapes at all\" ",
+      InputSize);
+
+  std::printf("Lexer:\n");
+  LexerThroughput("  source", Source);
+  LexerThroughput("  indented", Indented);
+  LexerThroughput("  identifiers", Identifiers);
+  LexerThroughput("  strings", Strings);
+
+  std::printf("Parallel lexer, source:\n");
+  ParallelLexerThroughput("  1 thread", Source, 1U);
+  ParallelLexerThroughput("  2 threads", Source, 2U);
+  ParallelLexerThroughput("  4 threads", Source, 4U);
+  ParallelLexerThroughput("  8 threads", Source, 8U);
+
+  std::printf("Relexing after typing and erasing one character:\n");
+  RelexTime(Source);
+
+  std::printf("Whitespace runs:\n");
+  SkipThroughput("  scalar", Indented, scan::SkipWhitespaceScalar);
+  SkipThroughput("  SIMD", Indented, scan::SkipWhitespace);
+
+  std::printf("Identifier bodies:\n");
+  SkipThroughput("  scalar", Identifiers, scan::SkipIdentifierBodyScalar);
+  SkipThroughput("  SIMD", Identifiers, scan::SkipIdentifierBody);
+
+  std::printf("String literal bodies:\n");
+  SkipThroughput("  scalar", Strings, scan::SkipStringLiteralBodyScalar);
+  SkipThroughput("  SIMD", Strings, scan::SkipStringLiteralBody);
+
+  std::printf("Newline counting:\n");
+  CountThroughput("  scalar", Source, scan::CountNewlinesScalar);
+  CountThroughput("  SIMD", Source, scan::CountNewlines);
+}
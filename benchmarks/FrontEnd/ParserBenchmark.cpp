@@ -0,0 +1,195 @@
+#include "BenchmarkHelpers.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTReader.hpp"
+#include "FrontEnd/AST/ASTWriter.hpp"
+#include "FrontEnd/Lex/IncrementalLexer.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/IncrementalParser.hpp"
+#include "FrontEnd/Parse/ParallelParser.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static std::string Repeat(std::string_view Pattern, std::size_t Size) {
+  std::string Result;
+  Result.reserve(Size + Pattern.size());
+  while (Result.size() < Size)
+    Result += Pattern;
+  return Result;
+}
+
+static constexpr std::size_t InputSize = 4U * 1024U * 1024U;
+static constexpr unsigned Iterations = 5U;
+
+static ASTNode *Parse(ASTContext *Context, const SourceBuffer *Buffer,
+                      const Storage *S, const std::vector<Token> &Tokens) {
+  return Parser(Context, Buffer, S, Tokens.data(),
+                Tokens.data() + Tokens.size())
+      .Parse();
+}
+
+/// Parse already lexed input, so only parser and allocation of nodes are
+/// measured. Context is destroyed after each iteration.
+static void ParserThroughput(const std::string &Input) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  double Seconds = MeasureBest(Iterations, [&] {
+    ASTContext Context;
+    ASTNode *AST = Parse(&Context, &Buffer, &S, Tokens);
+    DoNotOptimize(AST);
+  });
+  ReportThroughput("  parse and destroy", Input.size(), Seconds);
+
+  std::vector<std::unique_ptr<ASTContext>> Contexts;
+  for (unsigned It = 0U; It < Iterations; ++It) {
+    Contexts.push_back(std::make_unique<ASTContext>());
+    Parse(Contexts.back().get(), &Buffer, &S, Tokens);
+  }
+  std::printf("  %zu bytes in %zu slabs\n", Contexts.back()->TotalAllocated(),
+              Contexts.back()->TotalSlabs());
+  Seconds = MeasureBest(Iterations, [&] { Contexts.pop_back(); });
+  ReportTime("  destroy", Seconds);
+}
+
+static void ParallelParserThroughput(const char *Name, const std::string &Input,
+                                     unsigned Threads) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  weak::ThreadPool Pool(Threads);
+  double Seconds = MeasureBest(Iterations, [&] {
+    ASTContext Context;
+    ASTNode *AST = ParallelParser(&Context, &Buffer, &S, Tokens.data(),
+                                  Tokens.data() + Tokens.size(), &Pool)
+                       .Parse();
+    DoNotOptimize(AST);
+  });
+  ReportThroughput(Name, Input.size(), Seconds);
+}
+
+/// Change one digit in the middle and back, so one function of many is
+/// edited.
+static void ReparseTime(const std::string &Input) {
+  std::size_t Middle = Input.find("* 2", Input.size() / 2) + 2U;
+  TextEdit Edit{static_cast<SourceLocation>(Middle), /*RemovedLength=*/1U,
+                /*InsertedText=*/"3"};
+  std::string Edited = ApplyEdit(Input, Edit);
+  SourceBuffer Buffer("<benchmark>", Input);
+  SourceBuffer EditedBuffer("<benchmark>", Edited);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  auto EditedTokens = Lexer(&S, &EditedBuffer).Analyze();
+
+  double Full = MeasureBest(Iterations, [&] {
+    ASTContext Context;
+    DoNotOptimize(Parse(&Context, &EditedBuffer, &S, EditedTokens));
+    DoNotOptimize(Parse(&Context, &Buffer, &S, Tokens));
+  });
+  ReportTime("  full", Full);
+
+  IncrementalParser Reparser;
+  Reparser.Reparse(&Buffer, &S, Tokens.data(), Tokens.data() + Tokens.size());
+  double Incremental = MeasureBest(Iterations, [&] {
+    DoNotOptimize(Reparser.Reparse(&EditedBuffer, &S, EditedTokens.data(),
+                                   EditedTokens.data() + EditedTokens.size()));
+    DoNotOptimize(Reparser.Reparse(&Buffer, &S, Tokens.data(),
+                                   Tokens.data() + Tokens.size()));
+  });
+  ReportTime("  incremental", Incremental);
+}
+
+/// Load tree from AST file instead of lexing and parsing the source.
+static void ASTFileThroughput(const std::string &Input) {
+  SourceBuffer Buffer("<benchmark>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  ASTContext ParseContext;
+  auto *AST = static_cast<ASTCompoundStmt *>(
+      Parse(&ParseContext, &Buffer, &S, Tokens));
+
+  std::string Data;
+  double Seconds = MeasureBest(Iterations, [&] {
+    std::ostringstream Stream;
+    ASTWrite(AST, Stream);
+    Data = Stream.str();
+  });
+  ReportThroughput("  write", Input.size(), Seconds);
+  std::printf("  %zu bytes of source, %zu bytes of AST file\n", Input.size(),
+              Data.size());
+
+  Seconds = MeasureBest(Iterations, [&] {
+    Storage LexStorage;
+    auto LexedTokens = Lexer(&LexStorage, &Buffer).Analyze();
+    ASTContext Context;
+    DoNotOptimize(Parse(&Context, &Buffer, &LexStorage, LexedTokens));
+  });
+  ReportThroughput("  lex and parse", Input.size(), Seconds);
+
+  Seconds = MeasureBest(Iterations, [&] {
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    Reader.OpenBuffer(Data);
+    DoNotOptimize(Reader.ReadAll());
+  });
+  ReportThroughput("  read", Input.size(), Seconds);
+
+  Seconds = MeasureBest(Iterations, [&] {
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    Reader.OpenBuffer(Data);
+    DoNotOptimize(Reader.GetFunction(Reader.GetFunctionCount() / 2U));
+  });
+  ReportTime("  read one function", Seconds);
+}
+
+int main() {
+  std::string Source = Repeat("int function(int number, int other) {\n"
+                              "    int result = number * 2 + other;\n"
+                              "    while (result < 100) {\n"
+                              "        result += number << 1;\n"
+                              "        if (result == 50) {\n"
+                              "            break;\n"
+                              "        }\n"
+                              "    }\n"
+                              "    string message = \"done\";\n"
+                              "    float coefficient = 1.618;\n"
+                              "    return result - (number + 1) * 3;\n"
+                              "}\n\n",
+                              InputSize);
+
+  std::string Expressions =
+      Repeat("void expressions() {\n"
+             "    a = b * c + d / e - f % g;\n"
+             "    x = (a << 2) | (b >> 3) & c ^ d;\n"
+             "    y = a < b && c >= d || e == f && g != h;\n"
+             "    z = ((a + 1) * (b - 2)) / ((c + 3) * (d - 4));\n"
+             "    w = a + b + c + d + e + f + g + h + i + j + k;\n"
+             "    v = 1 + 2.5 * x - y / 3 + z % 4 - w;\n"
+             "}\n\n",
+             InputSize);
+
+  std::printf("Parser, source:\n");
+  ParserThroughput(Source);
+
+  std::printf("Parser, expressions:\n");
+  ParserThroughput(Expressions);
+
+  std::printf("Parallel parser, source:\n");
+  ParallelParserThroughput("  1 thread", Source, 1U);
+  ParallelParserThroughput("  2 threads", Source, 2U);
+  ParallelParserThroughput("  4 threads", Source, 4U);
+  ParallelParserThroughput("  8 threads", Source, 8U);
+
+  std::printf("Reparse after one character edit:\n");
+  ReparseTime(Source);
+
+  std::printf("AST file, source:\n");
+  ASTFileThroughput(Source);
+}
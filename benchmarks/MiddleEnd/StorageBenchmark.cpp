@@ -0,0 +1,62 @@
+#include "BenchmarkHelpers.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include <string>
+#include <vector>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static constexpr unsigned Identifiers = 100000U;
+static constexpr unsigned Iterations = 5U;
+
+/// Add all names, then look up each of them once more.
+static void AddAndLookup(const std::vector<std::string> &Names) {
+  double Seconds = MeasureBest(Iterations, [&] {
+    Storage S;
+    for (const std::string &Name : Names)
+      DoNotOptimize(S.AddSymbol(Name));
+    for (const std::string &Name : Names)
+      DoNotOptimize(S.AddSymbol(Name));
+  });
+  ReportTime("  add and look up", Seconds);
+}
+
+/// Open scope per name, add the name in it and close all scopes.
+static void DeepNesting(const std::vector<std::string> &Names) {
+  double Seconds = MeasureBest(Iterations, [&] {
+    Storage S;
+    for (const std::string &Name : Names) {
+      S.ScopeBegin();
+      DoNotOptimize(S.AddSymbol(Name));
+    }
+    for (unsigned I = 0U; I < Names.size(); ++I)
+      S.ScopeEnd();
+    DoNotOptimize(S.TotalVariables());
+  });
+  ReportTime("  nested scopes", Seconds);
+}
+
+/// Lexer adds each symbol it meets.
+static void Lexing(const std::vector<std::string> &Names) {
+  std::string Input;
+  for (const std::string &Name : Names)
+    Input += "int " + Name + " = " + Name + " + 1;\n";
+  SourceBuffer Buffer("<benchmark>", Input);
+  double Seconds = MeasureBest(Iterations, [&] {
+    Storage S;
+    DoNotOptimize(Lexer(&S, &Buffer).Analyze());
+  });
+  ReportThroughput("  lexing", Input.size(), Seconds);
+}
+
+int main() {
+  std::vector<std::string> Names;
+  for (unsigned I = 0U; I < Identifiers; ++I)
+    Names.push_back("variable" + std::to_string(I));
+
+  std::printf("Storage, %u distinct identifiers:\n", Identifiers);
+  AddAndLookup(Names);
+  DeepNesting(Names);
+  Lexing(Names);
+}
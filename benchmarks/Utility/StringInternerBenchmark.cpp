@@ -0,0 +1,49 @@
+#include "BenchmarkHelpers.hpp"
+#include "Utility/StringInterner.hpp"
+#include "Utility/ThreadPool.hpp"
+#include <string>
+#include <vector>
+
+using namespace weak;
+
+static constexpr unsigned Identifiers = 100000U;
+static constexpr unsigned Threads = 4U;
+static constexpr unsigned Iterations = 5U;
+
+/// Intern all names, then intern them again, as lexer does for repeated
+/// identifiers.
+static void Sequential(const std::vector<std::string> &Names) {
+  double Seconds = MeasureBest(Iterations, [&] {
+    StringInterner Interner;
+    for (unsigned Repeat = 0U; Repeat < 2U; ++Repeat)
+      for (const std::string &Name : Names)
+        DoNotOptimize(Interner.Intern(Name));
+  });
+  ReportTime("  intern, 1 thread", Seconds);
+}
+
+/// Each thread interns all names twice and reads them back.
+static void Parallel(const std::vector<std::string> &Names) {
+  ThreadPool Pool(Threads);
+  double Seconds = MeasureBest(Iterations, [&] {
+    StringInterner Interner;
+    for (unsigned T = 0U; T < Threads; ++T)
+      Pool.Submit([&] {
+        for (unsigned Repeat = 0U; Repeat < 2U; ++Repeat)
+          for (const std::string &Name : Names)
+            DoNotOptimize(Interner.GetString(Interner.Intern(Name)));
+      });
+    Pool.Wait();
+  });
+  ReportTime("  intern and look up, 4 threads", Seconds);
+}
+
+int main() {
+  std::vector<std::string> Names;
+  for (unsigned I = 0U; I < Identifiers; ++I)
+    Names.push_back("variable" + std::to_string(I));
+
+  std::printf("StringInterner, %u distinct strings:\n", Identifiers);
+  Sequential(Names);
+  Parallel(Names);
+}
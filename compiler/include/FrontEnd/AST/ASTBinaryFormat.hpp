@@ -0,0 +1,70 @@
+/* ASTBinaryFormat.hpp - Layout of binary AST files.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_BINARY_FORMAT_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Binary AST file, written by \ref ASTWrite and read by
+/// \ref ASTReader.
+///
+/// All integers are LEB128 varints, signed ones are zigzag-encoded first.
+/// Floating point values are 8 bytes of IEEE 754 representation in
+/// little-endian order, so they are restored exactly.
+/// File consists of:
+///   - header: magic bytes and format version;
+///   - string table: count of strings, length of each string, and then
+///     all strings one after another;
+///   - function table: count of top-level nodes and encoded size of each;
+///   - encoded top-level nodes.
+///
+/// Node is encoded as ASTType tag, line (as difference with line of the
+/// previous node of the same function), column and then fields in order
+/// of constructor parameters. Children are encoded in place, strings are
+/// indices in string table, and absent optional child is single
+/// BASE_NODE tag. Symbol and variable declaration are followed by index
+/// of declaration plus one (see \ref ASTVarDecl::GetDeclaration), so
+/// unresolved symbol has 0.
+///
+/// There are no absolute offsets, so file may be mapped at any address,
+/// and each function is decoded without looking at others.
+namespace astBinary {
+
+constexpr char Magic[4] = {'W', 'A', 'S', 'T'};
+
+/// Should be changed on any change of layout or numbering of ASTType or
+/// TokenType, so old files are rejected instead of misread.
+constexpr std::uint64_t Version = 2U;
+
+inline void WriteVarint(std::string &Out, std::uint64_t Value) {
+  while (Value >= 0x80U) {
+    Out.push_back(static_cast<char>(Value | 0x80U));
+    Value >>= 7U;
+  }
+  Out.push_back(static_cast<char>(Value));
+}
+
+/// Map small negative numbers to small unsigned ones: 0, -1, 1, -2, ...
+inline std::uint64_t ZigZagEncode(std::int64_t Value) {
+  return (static_cast<std::uint64_t>(Value) << 1U) ^
+         static_cast<std::uint64_t>(Value >> 63U);
+}
+
+inline std::int64_t ZigZagDecode(std::uint64_t Value) {
+  return static_cast<std::int64_t>(Value >> 1U) ^
+         -static_cast<std::int64_t>(Value & 1U);
+}
+
+} // namespace astBinary
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_BINARY_FORMAT_HPP
@@ -17,7 +17,6 @@ public:
   ASTBooleanLiteral(bool TheValue, unsigned TheLineNo = 0U,
                     unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   bool GetValue() const;
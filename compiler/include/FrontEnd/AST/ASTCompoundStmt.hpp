@@ -8,25 +8,21 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_COMPOUND_STMT_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
-#include <memory>
-#include <vector>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTCompoundStmt : public ASTNode {
 public:
-  ASTCompoundStmt(std::vector<std::unique_ptr<ASTNode>> &&stmts,
-                  unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
+  ASTCompoundStmt(ASTNodeList TheStmts, unsigned TheLineNo = 0U,
+                  unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  std::vector<std::unique_ptr<ASTNode>> &&GetStmts();
-  const std::vector<std::unique_ptr<ASTNode>> &GetStmts() const;
+  ASTNodeList GetStmts() const;
 
 private:
-  std::vector<std::unique_ptr<ASTNode>> Stmts;
+  ASTNodeList Stmts;
 };
 
 } // namespace frontEnd
@@ -0,0 +1,94 @@
+/* ASTContext.hpp - Owner of all AST nodes of translation unit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_CONTEXT_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_CONTEXT_HPP
+
+#include "FrontEnd/AST/ASTNode.hpp"
+#include "Utility/Uncopyable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Bump allocator for AST.
+///
+/// Nodes, their names and child lists are placed one after another in large
+/// slabs. Nothing is freed separately, since nodes of translation unit live
+/// as long as the whole tree. Nodes are trivially destructible, so the tree
+/// is destroyed by freeing slabs, without walking it.
+class ASTContext : private Uncopyable {
+public:
+  ASTContext();
+
+  /// Allocate node and construct it in place.
+  ///
+  /// \return pointer, valid until context destruction.
+  template <typename T, typename... Args> T *Make(Args &&...Arguments) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Destructors of AST nodes are never called");
+    void *Memory = Allocate(sizeof(T), alignof(T));
+    return new (Memory) T(std::forward<Args>(Arguments)...);
+  }
+
+  /// Copy string to context.
+  std::string_view MakeString(std::string_view String);
+
+  /// Copy child nodes to context.
+  ASTNodeList MakeList(const std::vector<ASTNode *> &Nodes);
+
+  /// Allocate Size bytes aligned by Align, which should be power of two.
+  void *Allocate(std::size_t Size, std::size_t Align) {
+    std::uintptr_t Current = reinterpret_cast<std::uintptr_t>(SlabPtr);
+    std::uintptr_t Aligned = (Current + Align - 1U) & ~(Align - 1U);
+    std::uintptr_t End = reinterpret_cast<std::uintptr_t>(SlabEnd);
+    if (Aligned > End || Size > End - Aligned)
+      return AllocateSlow(Size, Align);
+    SlabPtr = reinterpret_cast<char *>(Aligned + Size);
+    BytesAllocated += Size;
+    return reinterpret_cast<void *>(Aligned);
+  }
+
+  /// Take ownership of all memory of other context, so its nodes live as
+  /// long as this one. Other context is left empty.
+  void Adopt(ASTContext &Other);
+
+  /// \return count of allocated slabs.
+  std::size_t TotalSlabs() const;
+
+  /// \return count of bytes, requested from context.
+  std::size_t TotalAllocated() const;
+
+private:
+  /// Start new slab and allocate from it.
+  void *AllocateSlow(std::size_t Size, std::size_t Align);
+
+  /// Size of usual slab. Larger allocations get slab of their own size.
+  static constexpr std::size_t SlabSize = 64U * 1024U;
+
+  /// All memory owned by context.
+  std::vector<std::unique_ptr<char[]>> Slabs;
+
+  /// First free byte of current slab.
+  char *SlabPtr;
+
+  /// End of current slab.
+  char *SlabEnd;
+
+  /// Sum of all requested sizes.
+  std::size_t BytesAllocated;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_CONTEXT_HPP
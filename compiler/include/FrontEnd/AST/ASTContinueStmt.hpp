@@ -16,7 +16,6 @@ class ASTContinueStmt : public ASTNode {
 public:
   ASTContinueStmt(unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 };
 
@@ -15,21 +15,17 @@ namespace frontEnd {
 
 class ASTDoWhileStmt : public ASTNode {
 public:
-  ASTDoWhileStmt(std::unique_ptr<ASTCompoundStmt> &&TheBody,
-                 std::unique_ptr<ASTNode> &&TheCondition,
+  ASTDoWhileStmt(ASTCompoundStmt *TheBody, ASTNode *TheCondition,
                  unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  std::unique_ptr<ASTCompoundStmt> &&GetBody();
-  const std::unique_ptr<ASTCompoundStmt> &GetBody() const;
-  std::unique_ptr<ASTNode> &&GetCondition();
-  const std::unique_ptr<ASTNode> &GetCondition() const;
+  ASTCompoundStmt *GetBody() const;
+  ASTNode *GetCondition() const;
 
 private:
-  std::unique_ptr<ASTCompoundStmt> Body;
-  std::unique_ptr<ASTNode> Condition;
+  ASTCompoundStmt *Body;
+  ASTNode *Condition;
 };
 
 } // namespace frontEnd
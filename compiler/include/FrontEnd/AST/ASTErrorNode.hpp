@@ -0,0 +1,29 @@
+/* ASTErrorNode.hpp - AST node in place of malformed code.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_ERROR_NODE_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_ERROR_NODE_HPP
+
+#include "FrontEnd/AST/ASTNode.hpp"
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Placeholder for statement or expression, that failed to parse.
+///
+/// Created by parser in error recovery mode, so the rest of tree is still
+/// available. Tree with such nodes should not be compiled further.
+class ASTErrorNode : public ASTNode {
+public:
+  ASTErrorNode(unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
+
+  void Accept(const ASTVisitor *) const override;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_ERROR_NODE_HPP
\ No newline at end of file
@@ -17,7 +17,6 @@ public:
   ASTFloatingPointLiteral(double TheValue, unsigned TheLineNo = 0U,
                           unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   double GetValue() const;
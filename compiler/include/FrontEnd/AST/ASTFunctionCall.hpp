@@ -8,27 +8,24 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_FUNCTION_CALL_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
-#include <string>
-#include <vector>
+#include <string_view>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTFunctionCall : public ASTNode {
 public:
-  ASTFunctionCall(std::string &&TheName,
-                  std::vector<std::unique_ptr<ASTNode>> &&TheArguments,
+  ASTFunctionCall(std::string_view TheName, ASTNodeList TheArguments,
                   unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  const std::string &GetName() const;
-  const std::vector<std::unique_ptr<ASTNode>> &GetArguments() const;
+  std::string_view GetName() const;
+  ASTNodeList GetArguments() const;
 
 private:
-  std::string Name;
-  std::vector<std::unique_ptr<ASTNode>> Arguments;
+  std::string_view Name;
+  ASTNodeList Arguments;
 };
 
 } // namespace frontEnd
@@ -10,35 +10,29 @@
 #include "FrontEnd/AST/ASTCompoundStmt.hpp"
 #include "FrontEnd/AST/ASTNode.hpp"
 #include "FrontEnd/Lex/Token.hpp"
-#include <memory>
-#include <string>
-#include <vector>
+#include <string_view>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTFunctionDecl : public ASTNode {
 public:
-  ASTFunctionDecl(TokenType TheReturnType, std::string &&TheName,
-                  std::vector<std::unique_ptr<ASTNode>> &&TheArguments,
-                  std::unique_ptr<ASTCompoundStmt> &&TheBody,
+  ASTFunctionDecl(TokenType TheReturnType, std::string_view TheName,
+                  ASTNodeList TheArguments, ASTCompoundStmt *TheBody,
                   unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   TokenType GetReturnType() const;
-  const std::string &GetName() const;
-  std::vector<std::unique_ptr<ASTNode>> &&GetArguments();
-  const std::vector<std::unique_ptr<ASTNode>> &GetArguments() const;
-  std::unique_ptr<ASTCompoundStmt> &&GetBody();
-  const std::unique_ptr<ASTCompoundStmt> &GetBody() const;
+  std::string_view GetName() const;
+  ASTNodeList GetArguments() const;
+  ASTCompoundStmt *GetBody() const;
 
 private:
   TokenType ReturnType;
-  std::string Name;
-  std::vector<std::unique_ptr<ASTNode>> Arguments;
-  std::unique_ptr<ASTCompoundStmt> Body;
+  std::string_view Name;
+  ASTNodeList Arguments;
+  ASTCompoundStmt *Body;
 };
 
 } // namespace frontEnd
@@ -8,27 +8,67 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_NODE_HPP
 
 #include "FrontEnd/AST/ASTTypesEnum.hpp"
-#include <memory>
+#include "FrontEnd/Lex/Token.hpp"
 
 namespace weak {
 namespace frontEnd {
 
 class ASTVisitor;
 
+/// \brief Base of all AST nodes.
+///
+/// Nodes are allocated in \ref ASTContext and never destroyed one by one,
+/// so destructor is not virtual and cannot be called through base.
 class ASTNode {
 public:
-  virtual ~ASTNode() noexcept = default;
-  virtual ASTType GetASTType() const;
+  /// Not virtual, so switch on type, as in \ref RecursiveASTVisitor,
+  /// costs no indirect call.
+  ASTType GetASTType() const { return Type; }
+
   virtual void Accept(const ASTVisitor *) const = 0;
 
   unsigned GetLineNo() const;
   unsigned GetColumnNo() const;
 
+  /// Move node to other line. Used when subtree is reused after edit of
+  /// text above it.
+  void SetLineNo(unsigned TheLineNo);
+
+  /// \return data type of expression, computed by semantic analysis, or
+  ///         NONE for statements and not analyzed nodes.
+  TokenType GetExprType() const { return ExprType; }
+
+  /// Set by semantic analysis, which is the only pass changing types.
+  void SetExprType(TokenType TheExprType) { ExprType = TheExprType; }
+
 protected:
-  ASTNode(unsigned TheLineNo, unsigned TheColumnNo);
+  ASTNode(ASTType TheType, unsigned TheLineNo, unsigned TheColumnNo);
+  ~ASTNode() = default;
 
+  ASTType Type;
   unsigned LineNo;
   unsigned ColumnNo;
+
+  /// Fits in padding after position, so annotation costs no memory.
+  TokenType ExprType;
+};
+
+/// \brief Non-owning array of child nodes, allocated in \ref ASTContext.
+class ASTNodeList {
+public:
+  ASTNodeList() : Data(nullptr), Size(0U) {}
+  ASTNodeList(ASTNode **TheData, unsigned TheSize)
+      : Data(TheData), Size(TheSize) {}
+
+  ASTNode **begin() const { return Data; }
+  ASTNode **end() const { return Data + Size; }
+  ASTNode *operator[](unsigned Index) const { return Data[Index]; }
+  unsigned size() const { return Size; }
+  bool empty() const { return Size == 0U; }
+
+private:
+  ASTNode **Data;
+  unsigned Size;
 };
 
 } // namespace frontEnd
@@ -8,15 +8,19 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_PRETTY_PRINT_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
-#include <memory>
+#include <ostream>
 
 namespace weak {
 namespace frontEnd {
 
+class FlatAST;
+
 /// Show visual representation of Syntax Tree beginning with
 /// RootNode.
-void ASTPrettyPrint(const std::unique_ptr<ASTNode> &RootNode,
-                    std::ostream &OutStream);
+void ASTPrettyPrint(const ASTNode *RootNode, std::ostream &OutStream);
+
+/// The same for flat representation of tree.
+void ASTPrettyPrint(const FlatAST &AST, std::ostream &OutStream);
 
 } // namespace frontEnd
 } // namespace weak
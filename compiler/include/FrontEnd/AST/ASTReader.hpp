@@ -0,0 +1,127 @@
+/* ASTReader.hpp - Deserializer of AST from binary file.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_READER_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_READER_HPP
+
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include "Utility/Uncopyable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace weak {
+namespace frontEnd {
+
+class ASTContext;
+
+/// \brief Reader of files, written by \ref ASTWrite.
+///
+/// File is mapped to memory, and only its header is decoded on open.
+/// Functions are built on first request, so nodes are allocated only for
+/// functions, which are really used. Strings are copied to context, so the
+/// tree outlives reader.
+class ASTReader : private Uncopyable {
+public:
+  /// Nodes are allocated in given context.
+  ASTReader(ASTContext *TheContext);
+
+  ~ASTReader();
+
+  /// Map file to memory.
+  ///
+  /// \return false if file cannot be read, or it is not AST file of
+  ///         current format version. Then file should be parsed again.
+  bool OpenFile(std::string_view Path);
+
+  /// Read file contents, which should outlive reader.
+  ///
+  /// \see OpenFile.
+  bool OpenBuffer(std::string_view TheData);
+
+  unsigned GetFunctionCount() const;
+
+  /// Build Index-th function, or return already built one.
+  ///
+  /// \return nullptr if function data is corrupted. Then file should be
+  ///         parsed again.
+  ASTNode *GetFunction(unsigned Index);
+
+  /// Build all functions.
+  ///
+  /// \return root of the tree, as if it was produced by \ref Parser, or
+  ///         nullptr if some function is corrupted.
+  ASTCompoundStmt *ReadAll();
+
+private:
+  /// Position in function data, being decoded.
+  struct Cursor {
+    const unsigned char *Ptr;
+    const unsigned char *End;
+  };
+
+  static bool ReadVarint(Cursor &C, std::uint64_t &Value);
+
+  /// Read varint not larger than Max.
+  ///
+  /// \return 0 if data is corrupted.
+  std::uint64_t Read(Cursor &C, std::uint64_t Max);
+
+  TokenType ReadToken(Cursor &C);
+
+  std::string_view ReadString(Cursor &C);
+
+  /// \return declaration index or ASTVarDecl::NoDeclaration.
+  unsigned ReadDeclaration(Cursor &C);
+
+  ASTNodeList ReadList(Cursor &C);
+
+  /// \return nullptr if node is absent.
+  ASTNode *ReadNode(Cursor &C);
+
+  /// Read node, which should be present.
+  ///
+  /// \return nullptr if data is corrupted.
+  ASTNode *ReadRequiredNode(Cursor &C);
+
+  /// Read block statement, which should be present, unless Optional is set.
+  ASTCompoundStmt *ReadCompoundStmt(Cursor &C, bool Optional = false);
+
+  /// Stop decoding of function: cursor is moved to the end, so all
+  /// further reads fail without recursion.
+  void MarkCorrupted(Cursor &C);
+
+  ASTContext *Context;
+
+  /// Set if file was mapped with mmap().
+  void *MappedAddress;
+  std::size_t MappedSize;
+
+  /// Strings, copied to context.
+  std::vector<std::string_view> Strings;
+
+  /// Offsets of encoded functions in data. The last one is end of data.
+  std::vector<std::size_t> FunctionOffsets;
+
+  /// Already built functions, or nullptr.
+  std::vector<ASTNode *> Functions;
+
+  std::string_view Data;
+
+  /// Line of the previously decoded node.
+  unsigned LastLineNo;
+
+  /// Set if function, being decoded, is corrupted. Decoding is not stopped
+  /// immediately, so incomplete nodes are built, but never returned.
+  bool Corrupted;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_READER_HPP
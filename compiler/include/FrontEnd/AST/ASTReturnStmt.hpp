@@ -8,23 +8,21 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_RETURN_STMT_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
-#include <memory>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTReturnStmt : public ASTNode {
 public:
-  ASTReturnStmt(std::unique_ptr<ASTNode> &&TheOperand, unsigned TheLineNo = 0U,
+  ASTReturnStmt(ASTNode *TheOperand, unsigned TheLineNo = 0U,
                 unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  const std::unique_ptr<ASTNode> &GetOperand() const;
+  ASTNode *GetOperand() const;
 
 private:
-  std::unique_ptr<ASTNode> Operand;
+  ASTNode *Operand;
 };
 
 } // namespace frontEnd
@@ -8,23 +8,22 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_STRING_LITERAL_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
-#include <string>
+#include <string_view>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTStringLiteral : public ASTNode {
 public:
-  ASTStringLiteral(std::string TheValue, unsigned TheLineNo = 0U,
+  ASTStringLiteral(std::string_view TheValue, unsigned TheLineNo = 0U,
                    unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  const std::string &GetValue() const;
+  std::string_view GetValue() const;
 
 private:
-  std::string Value;
+  std::string_view Value;
 };
 
 } // namespace frontEnd
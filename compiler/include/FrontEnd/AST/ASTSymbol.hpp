@@ -8,27 +8,46 @@
 #define WEAK_COMPILER_FRONTEND_AST_AST_SYMBOL_HPP
 
 #include "FrontEnd/AST/ASTNode.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "Utility/StringInterner.hpp"
 #include <string>
+#include <string_view>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTSymbol : public ASTNode {
 public:
-  ASTSymbol(std::string TheValue, unsigned TheLineNo = 0U,
+  /// Intern name in \ref StringInterner::Global.
+  ASTSymbol(std::string_view TheName, unsigned TheLineNo = 0U,
+            unsigned TheColumnNo = 0U);
+
+  ASTSymbol(StringInterner::ID TheName, unsigned TheLineNo = 0U,
             unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   void SetSSAIndex(int);
 
-  const std::string &GetName() const;
+  std::string_view GetName() const;
+
+  /// \return interned name, equal for all symbols with equal names.
+  StringInterner::ID GetNameID() const;
+
   std::string GetSSAName() const;
 
+  /// Bind symbol to declaration, visible at its place, as given by
+  /// \ref ASTVarDecl::GetDeclaration.
+  void SetDeclaration(unsigned Index);
+
+  /// \return index of declaration or \ref ASTVarDecl::NoDeclaration if
+  ///         symbol was not resolved.
+  unsigned GetDeclaration() const;
+
 private:
-  std::string Value;
+  StringInterner::ID Name;
   int SSAIndex;
+  unsigned Declaration;
 };
 
 } // namespace frontEnd
@@ -0,0 +1,149 @@
+/* ASTTraversal.hpp - Non-recursive AST traversal.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_TRAVERSAL_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_TRAVERSAL_HPP
+
+#include "FrontEnd/AST/ASTNode.hpp"
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Depth-first walk of AST with explicit stack.
+///
+/// Each node is reached twice: when entered, before its children, and
+/// when left, after them. Children are walked in the order of getters of
+/// node (e.g. arguments and then body of function), absent optional
+/// children are skipped. Stack lives on heap, so tree of any depth is
+/// walked in bounded stack space.
+///
+/// \code
+///   for (ASTWalker Walker(Root); Walker.Next();)
+///     if (!Walker.IsLeaving())
+///       Process(Walker.GetNode());
+/// \endcode
+class ASTWalker {
+public:
+  /// Walk subtree of Root. Null root gives empty walk.
+  ASTWalker(const ASTNode *Root);
+
+  /// Move to the next node.
+  ///
+  /// \return false, when root is left.
+  bool Next();
+
+  const ASTNode *GetNode() const { return Path.back(); }
+
+  /// \return parent of current node or nullptr for root.
+  const ASTNode *GetParent() const {
+    return Path.size() > 1U ? Path[Path.size() - 2U] : nullptr;
+  }
+
+  /// \return depth of current node, which is 0 for root.
+  unsigned GetDepth() const { return Path.size() - 1U; }
+
+  /// \return true if node is left, false if it is entered.
+  bool IsLeaving() const { return Leaving; }
+
+  /// Do not enter children of node, which is just entered. The node is
+  /// left at next step.
+  void SkipChildren() { SkipCurrent = true; }
+
+private:
+  /// Nodes from root to current one.
+  std::vector<const ASTNode *> Path;
+
+  /// Nodes to be entered, in reversed order, with depths of their parents
+  /// plus one.
+  std::vector<std::pair<const ASTNode *, std::size_t>> Pending;
+
+  bool Leaving;
+  bool SkipCurrent;
+};
+
+/// \brief Forward iterator over nodes, in pre-order (parents before
+/// children) or post-order (children before parents).
+template <bool PostOrder> class ASTDepthFirstIterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = const ASTNode *;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  /// End iterator.
+  ASTDepthFirstIterator() : Walker(nullptr), Node(nullptr) {}
+
+  ASTDepthFirstIterator(const ASTNode *Root) : Walker(Root), Node(nullptr) {
+    ++*this;
+  }
+
+  reference operator*() const { return Node; }
+
+  const ASTNode *GetParent() const { return Walker.GetParent(); }
+  unsigned GetDepth() const { return Walker.GetDepth(); }
+
+  ASTDepthFirstIterator &operator++() {
+    while (Walker.Next())
+      if (Walker.IsLeaving() == PostOrder) {
+        Node = Walker.GetNode();
+        return *this;
+      }
+    Node = nullptr;
+    return *this;
+  }
+
+  ASTDepthFirstIterator operator++(int) {
+    ASTDepthFirstIterator Copy = *this;
+    ++*this;
+    return Copy;
+  }
+
+  bool operator==(const ASTDepthFirstIterator &RHS) const {
+    return Node == RHS.Node;
+  }
+  bool operator!=(const ASTDepthFirstIterator &RHS) const {
+    return Node != RHS.Node;
+  }
+
+private:
+  ASTWalker Walker;
+
+  /// Current node or nullptr at the end.
+  const ASTNode *Node;
+};
+
+using ASTPreOrderIterator = ASTDepthFirstIterator</*PostOrder=*/false>;
+using ASTPostOrderIterator = ASTDepthFirstIterator</*PostOrder=*/true>;
+
+/// \brief Subtree, which can be used in range-based for.
+template <typename Iterator> class ASTTraversalRange {
+public:
+  ASTTraversalRange(const ASTNode *TheRoot) : Root(TheRoot) {}
+
+  Iterator begin() const { return Iterator(Root); }
+  Iterator end() const { return Iterator(); }
+
+private:
+  const ASTNode *Root;
+};
+
+inline ASTTraversalRange<ASTPreOrderIterator> PreOrder(const ASTNode *Root) {
+  return Root;
+}
+
+inline ASTTraversalRange<ASTPostOrderIterator> PostOrder(const ASTNode *Root) {
+  return Root;
+}
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_TRAVERSAL_HPP
@@ -10,6 +10,8 @@
 namespace weak {
 namespace frontEnd {
 
+/// Values are stored in binary AST files, so new types are added to the
+/// end, see ASTBinaryFormat.hpp.
 enum struct ASTType {
   // Abstract node.
   BASE_NODE,
@@ -57,6 +59,9 @@ enum struct ASTType {
   // Functions.
   FUNCTION_DECL,
   FUNCTION_CALL,
+
+  // Malformed code, skipped by parser in error recovery mode.
+  ERROR_NODE,
 };
 
 } // namespace frontEnd
@@ -9,7 +9,6 @@
 
 #include "FrontEnd/AST/ASTNode.hpp"
 #include "FrontEnd/Lex/Token.hpp"
-#include <memory>
 
 namespace weak {
 namespace frontEnd {
@@ -19,18 +18,17 @@ public:
   enum struct UnaryType { PREFIX, POSTFIX } const PrefixOrPostfix;
 
   ASTUnaryOperator(UnaryType ThePrefixOrPostfix, TokenType TheOperation,
-                   std::unique_ptr<ASTNode> &&TheOperand,
-                   unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
+                   ASTNode *TheOperand, unsigned TheLineNo = 0U,
+                   unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   TokenType GetOperation() const;
-  const std::unique_ptr<ASTNode> &GetOperand() const;
+  ASTNode *GetOperand() const;
 
 private:
   TokenType Operation;
-  std::unique_ptr<ASTNode> Operand;
+  ASTNode *Operand;
 };
 
 } // namespace frontEnd
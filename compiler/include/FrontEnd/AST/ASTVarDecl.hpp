@@ -9,29 +9,47 @@
 
 #include "FrontEnd/AST/ASTNode.hpp"
 #include "FrontEnd/Lex/Token.hpp"
-#include <memory>
-#include <string>
+#include "Utility/StringInterner.hpp"
+#include <cstdint>
+#include <string_view>
 
 namespace weak {
 namespace frontEnd {
 
 class ASTVarDecl : public ASTNode {
 public:
-  ASTVarDecl(TokenType TheDataType, std::string &&TheSymbolName,
-             std::unique_ptr<ASTNode> &&TheDeclareBody, unsigned TheLineNo = 0U,
+  /// Intern name in \ref StringInterner::Global.
+  ASTVarDecl(TokenType TheDataType, std::string_view TheSymbolName,
+             ASTNode *TheDeclareBody, unsigned TheLineNo = 0U,
+             unsigned TheColumnNo = 0U);
+
+  ASTVarDecl(TokenType TheDataType, StringInterner::ID TheSymbolName,
+             ASTNode *TheDeclareBody, unsigned TheLineNo = 0U,
              unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
   TokenType GetDataType() const;
-  const std::string &GetSymbolName() const;
-  const std::unique_ptr<ASTNode> &GetDeclareBody() const;
+  std::string_view GetSymbolName() const;
+  StringInterner::ID GetSymbolNameID() const;
+  ASTNode *GetDeclareBody() const;
+
+  /// Index of declaration, not given by parser.
+  static constexpr unsigned NoDeclaration = UINT32_MAX;
+
+  /// Set index of declaration among declarations of translation unit,
+  /// which are numbered by parser from zero in source order. Variables
+  /// are then distinguished by index even if they have the same name or
+  /// belong to different functions.
+  void SetDeclaration(unsigned Index);
+
+  unsigned GetDeclaration() const;
 
 private:
   TokenType DataType;
-  std::string SymbolName;
-  std::unique_ptr<ASTNode> DeclareBody;
+  StringInterner::ID SymbolName;
+  ASTNode *DeclareBody;
+  unsigned Declaration;
 };
 
 } // namespace frontEnd
@@ -17,6 +17,7 @@ class ASTBreakStmt;
 class ASTCompoundStmt;
 class ASTContinueStmt;
 class ASTDoWhileStmt;
+class ASTErrorNode;
 class ASTFloatingPointLiteral;
 class ASTForStmt;
 class ASTFunctionDecl;
@@ -40,6 +41,7 @@ public:
   virtual void Visit(const ASTCompoundStmt *) const = 0;
   virtual void Visit(const ASTContinueStmt *) const = 0;
   virtual void Visit(const ASTDoWhileStmt *) const = 0;
+  virtual void Visit(const ASTErrorNode *) const = 0;
   virtual void Visit(const ASTFloatingPointLiteral *) const = 0;
   virtual void Visit(const ASTForStmt *) const = 0;
   virtual void Visit(const ASTFunctionDecl *) const = 0;
@@ -15,21 +15,17 @@ namespace frontEnd {
 
 class ASTWhileStmt : public ASTNode {
 public:
-  ASTWhileStmt(std::unique_ptr<ASTNode> &&TheCondition,
-               std::unique_ptr<ASTCompoundStmt> &&TheBody,
+  ASTWhileStmt(ASTNode *TheCondition, ASTCompoundStmt *TheBody,
                unsigned TheLineNo = 0U, unsigned TheColumnNo = 0U);
 
-  ASTType GetASTType() const override;
   void Accept(const ASTVisitor *) const override;
 
-  std::unique_ptr<ASTNode> &&GetCondition();
-  const std::unique_ptr<ASTNode> &GetCondition() const;
-  std::unique_ptr<ASTCompoundStmt> &&GetBody();
-  const std::unique_ptr<ASTCompoundStmt> &GetBody() const;
+  ASTNode *GetCondition() const;
+  ASTCompoundStmt *GetBody() const;
 
 private:
-  std::unique_ptr<ASTNode> Condition;
-  std::unique_ptr<ASTCompoundStmt> Body;
+  ASTNode *Condition;
+  ASTCompoundStmt *Body;
 };
 
 } // namespace frontEnd
@@ -0,0 +1,24 @@
+/* ASTWriter.hpp - Serializer of AST to binary file.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_AST_WRITER_HPP
+#define WEAK_COMPILER_FRONTEND_AST_AST_WRITER_HPP
+
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include <ostream>
+
+namespace weak {
+namespace frontEnd {
+
+/// Write tree of translation unit in binary format, described in
+/// ASTBinaryFormat.hpp. Each statement of RootNode is stored as function,
+/// which can be read back without others.
+void ASTWrite(const ASTCompoundStmt *RootNode, std::ostream &OutStream);
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_AST_WRITER_HPP
@@ -0,0 +1,105 @@
+/* FlatAST.hpp - Structure-of-arrays encoding of AST.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_FLAT_AST_HPP
+#define WEAK_COMPILER_FRONTEND_AST_FLAT_AST_HPP
+
+#include "FrontEnd/AST/ASTNode.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief AST as parallel arrays, indexed by node number.
+///
+/// Nodes are numbered in pre-order, so the whole tree is walked by plain
+/// loop over arrays, and subtree of node is contiguous range after it.
+/// Children are linked with first child and next sibling indices, in the
+/// order of getters of tree nodes (e.g. arguments and then body of
+/// function). Absent optional child (for statement parts, else body,
+/// return operand, variable initializer) is kept as BASE_NODE
+/// placeholder, so children are identified by position.
+///
+/// Payload meaning depends on node type:
+///   - integer literal: value bits;
+///   - boolean literal: 0 or 1;
+///   - floating point literal: index in floats table;
+///   - string literal, symbol, variable, function declaration and call:
+///     index in strings table;
+///   - symbol and variable: also index in declarations table, which
+///     holds their declaration indices (see
+///     \ref ASTVarDecl::GetDeclaration).
+/// Operator or data type of binary, unary, variable and function
+/// declaration nodes is stored separately.
+///
+/// Strings are not copied and live as long as the source tree.
+class FlatAST {
+public:
+  using NodeIndex = std::uint32_t;
+
+  /// Index of absent child or sibling.
+  static constexpr NodeIndex None = ~NodeIndex{0U};
+
+  /// Flatten tree. RootNode gets index 0.
+  FlatAST(ASTNode *RootNode);
+
+  NodeIndex Size() const { return Types.size(); }
+
+  ASTType GetType(NodeIndex I) const { return Types[I]; }
+  unsigned GetLineNo(NodeIndex I) const { return LineNos[I]; }
+  unsigned GetColumnNo(NodeIndex I) const { return ColumnNos[I]; }
+  NodeIndex GetFirstChild(NodeIndex I) const { return FirstChildren[I]; }
+  NodeIndex GetNextSibling(NodeIndex I) const { return NextSiblings[I]; }
+
+  /// \return Index-th child, which should exist.
+  NodeIndex GetChild(NodeIndex I, unsigned Index) const;
+
+  /// \return count of children, including placeholders.
+  unsigned GetChildrenCount(NodeIndex I) const;
+
+  /// Operator of binary and unary nodes, data type of variable and return
+  /// type of function.
+  TokenType GetOperation(NodeIndex I) const { return Operations[I]; }
+
+  signed GetInteger(NodeIndex I) const;
+  bool GetBoolean(NodeIndex I) const;
+  double GetFloat(NodeIndex I) const;
+  std::string_view GetString(NodeIndex I) const;
+
+  /// Declaration of variable or symbol, as set by parser.
+  unsigned GetDeclaration(NodeIndex I) const;
+
+  /// Tree node, I-th node was built from, or nullptr for placeholder.
+  /// Used by passes, which produce IR, referring to tree nodes.
+  ASTNode *GetNode(NodeIndex I) const { return Nodes[I]; }
+
+private:
+  friend class FlatASTBuilder;
+
+  std::vector<ASTType> Types;
+  std::vector<unsigned> LineNos;
+  std::vector<unsigned> ColumnNos;
+  std::vector<NodeIndex> FirstChildren;
+  std::vector<NodeIndex> NextSiblings;
+  std::vector<std::uint32_t> Payloads;
+  std::vector<TokenType> Operations;
+  std::vector<ASTNode *> Nodes;
+
+  std::vector<double> Floats;
+  std::vector<std::string_view> Strings;
+
+  /// Indexed as strings, NoDeclaration for nodes other than symbols and
+  /// variables.
+  std::vector<unsigned> Declarations;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_FLAT_AST_HPP
@@ -0,0 +1,191 @@
+/* RecursiveASTVisitor.hpp - Statically dispatched AST visitor.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_AST_RECURSIVE_AST_VISITOR_HPP
+#define WEAK_COMPILER_FRONTEND_AST_RECURSIVE_AST_VISITOR_HPP
+
+#include "FrontEnd/AST/ASTBinaryOperator.hpp"
+#include "FrontEnd/AST/ASTBooleanLiteral.hpp"
+#include "FrontEnd/AST/ASTBreakStmt.hpp"
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTContinueStmt.hpp"
+#include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTErrorNode.hpp"
+#include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
+#include "FrontEnd/AST/ASTForStmt.hpp"
+#include "FrontEnd/AST/ASTFunctionCall.hpp"
+#include "FrontEnd/AST/ASTFunctionDecl.hpp"
+#include "FrontEnd/AST/ASTIfStmt.hpp"
+#include "FrontEnd/AST/ASTIntegerLiteral.hpp"
+#include "FrontEnd/AST/ASTReturnStmt.hpp"
+#include "FrontEnd/AST/ASTStringLiteral.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTUnaryOperator.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include <type_traits>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Visitor with dispatch by switch on \ref ASTNode::GetASTType.
+///
+/// Derived class hides Visit overloads for nodes it is interested in, and
+/// calls of them are resolved at compile time, so they can be inlined.
+/// Default Visit traverses children in the order of getters of node.
+/// Unlike \ref ASTVisitor, methods are not const, so visitor state does
+/// not need to be mutable.
+///
+/// \code
+///   class SymbolCounter : public RecursiveASTVisitor<SymbolCounter> {
+///   public:
+///     using RecursiveASTVisitor::Visit;
+///     void Visit(const ASTSymbol *) { ++Count; }
+///     unsigned Count = 0U;
+///   };
+/// \endcode
+///
+/// Derived class can also hide Traverse to do something with each node.
+///
+/// Passes, that change nodes, set IsConst to false and get non-const
+/// nodes in Traverse and Visit.
+template <typename Derived, bool IsConst = true> class RecursiveASTVisitor {
+public:
+  /// Pointer to node, const unless visitor changes nodes.
+  template <typename T>
+  using NodePtr = std::conditional_t<IsConst, const T *, T *>;
+
+  /// Call Visit overload of Derived for the type of node. Null node is
+  /// skipped.
+  void Traverse(NodePtr<ASTNode> Node) {
+    if (!Node)
+      return;
+    switch (Node->GetASTType()) {
+    case ASTType::BINARY:
+      return GetDerived().Visit(static_cast<NodePtr<ASTBinaryOperator>>(Node));
+    case ASTType::BOOLEAN_LITERAL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTBooleanLiteral>>(Node));
+    case ASTType::BREAK_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTBreakStmt>>(Node));
+    case ASTType::COMPOUND_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTCompoundStmt>>(Node));
+    case ASTType::CONTINUE_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTContinueStmt>>(Node));
+    case ASTType::DO_WHILE_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTDoWhileStmt>>(Node));
+    case ASTType::ERROR_NODE:
+      return GetDerived().Visit(static_cast<NodePtr<ASTErrorNode>>(Node));
+    case ASTType::FLOATING_POINT_LITERAL:
+      return GetDerived().Visit(
+          static_cast<NodePtr<ASTFloatingPointLiteral>>(Node));
+    case ASTType::FOR_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTForStmt>>(Node));
+    case ASTType::FUNCTION_DECL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTFunctionDecl>>(Node));
+    case ASTType::FUNCTION_CALL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTFunctionCall>>(Node));
+    case ASTType::IF_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTIfStmt>>(Node));
+    case ASTType::INTEGER_LITERAL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTIntegerLiteral>>(Node));
+    case ASTType::RETURN_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTReturnStmt>>(Node));
+    case ASTType::STRING_LITERAL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTStringLiteral>>(Node));
+    case ASTType::SYMBOL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTSymbol>>(Node));
+    case ASTType::PREFIX_UNARY:
+    case ASTType::POSTFIX_UNARY:
+      return GetDerived().Visit(static_cast<NodePtr<ASTUnaryOperator>>(Node));
+    case ASTType::VAR_DECL:
+      return GetDerived().Visit(static_cast<NodePtr<ASTVarDecl>>(Node));
+    case ASTType::WHILE_STMT:
+      return GetDerived().Visit(static_cast<NodePtr<ASTWhileStmt>>(Node));
+    default:
+      return;
+    }
+  }
+
+  void Visit(NodePtr<ASTBinaryOperator> Binary) {
+    GetDerived().Traverse(Binary->GetLHS());
+    GetDerived().Traverse(Binary->GetRHS());
+  }
+
+  void Visit(NodePtr<ASTBooleanLiteral>) {}
+  void Visit(NodePtr<ASTBreakStmt>) {}
+
+  void Visit(NodePtr<ASTCompoundStmt> CompoundStmt) {
+    TraverseAll(CompoundStmt->GetStmts());
+  }
+
+  void Visit(NodePtr<ASTContinueStmt>) {}
+
+  void Visit(NodePtr<ASTDoWhileStmt> DoWhileStmt) {
+    GetDerived().Traverse(DoWhileStmt->GetBody());
+    GetDerived().Traverse(DoWhileStmt->GetCondition());
+  }
+
+  void Visit(NodePtr<ASTErrorNode>) {}
+  void Visit(NodePtr<ASTFloatingPointLiteral>) {}
+
+  void Visit(NodePtr<ASTForStmt> ForStmt) {
+    GetDerived().Traverse(ForStmt->GetInit());
+    GetDerived().Traverse(ForStmt->GetCondition());
+    GetDerived().Traverse(ForStmt->GetIncrement());
+    GetDerived().Traverse(ForStmt->GetBody());
+  }
+
+  void Visit(NodePtr<ASTFunctionDecl> FunctionDecl) {
+    TraverseAll(FunctionDecl->GetArguments());
+    GetDerived().Traverse(FunctionDecl->GetBody());
+  }
+
+  void Visit(NodePtr<ASTFunctionCall> FunctionCall) {
+    TraverseAll(FunctionCall->GetArguments());
+  }
+
+  void Visit(NodePtr<ASTIfStmt> IfStmt) {
+    GetDerived().Traverse(IfStmt->GetCondition());
+    GetDerived().Traverse(IfStmt->GetThenBody());
+    GetDerived().Traverse(IfStmt->GetElseBody());
+  }
+
+  void Visit(NodePtr<ASTIntegerLiteral>) {}
+
+  void Visit(NodePtr<ASTReturnStmt> ReturnStmt) {
+    GetDerived().Traverse(ReturnStmt->GetOperand());
+  }
+
+  void Visit(NodePtr<ASTStringLiteral>) {}
+  void Visit(NodePtr<ASTSymbol>) {}
+
+  void Visit(NodePtr<ASTUnaryOperator> Unary) {
+    GetDerived().Traverse(Unary->GetOperand());
+  }
+
+  void Visit(NodePtr<ASTVarDecl> VarDecl) {
+    GetDerived().Traverse(VarDecl->GetDeclareBody());
+  }
+
+  void Visit(NodePtr<ASTWhileStmt> WhileStmt) {
+    GetDerived().Traverse(WhileStmt->GetCondition());
+    GetDerived().Traverse(WhileStmt->GetBody());
+  }
+
+protected:
+  void TraverseAll(ASTNodeList Nodes) {
+    for (ASTNode *Node : Nodes)
+      GetDerived().Traverse(Node);
+  }
+
+private:
+  Derived &GetDerived() { return *static_cast<Derived *>(this); }
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_AST_RECURSIVE_AST_VISITOR_HPP
@@ -0,0 +1,95 @@
+/* CharClass.hpp - Character classification and bulk scanning for lexer.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_LEX_CHAR_CLASS_HPP
+#define WEAK_COMPILER_FRONTEND_LEX_CHAR_CLASS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace weak {
+namespace frontEnd {
+
+/// Character classes, combined as bit mask.
+enum CharClass : std::uint8_t {
+  CHAR_NONE = 0U,
+  CHAR_SPACE = 1U << 0U,
+  CHAR_DIGIT = 1U << 1U,
+  CHAR_LETTER = 1U << 2U,
+  CHAR_UNDERSCORE = 1U << 3U
+};
+
+/// Unlike std::isalpha and friends, does not depend on locale and is
+/// defined for characters above 127 (which are not classified at all).
+constexpr std::array<std::uint8_t, 256> MakeCharClassTable() {
+  std::array<std::uint8_t, 256> Table{};
+  for (unsigned C = '0'; C <= '9'; ++C)
+    Table[C] = CHAR_DIGIT;
+  for (unsigned C = 'a'; C <= 'z'; ++C)
+    Table[C] = CHAR_LETTER;
+  for (unsigned C = 'A'; C <= 'Z'; ++C)
+    Table[C] = CHAR_LETTER;
+  for (unsigned C : {' ', '\t', '\n', '\v', '\f', '\r'})
+    Table[C] = CHAR_SPACE;
+  Table['_'] = CHAR_UNDERSCORE;
+  return Table;
+}
+
+inline constexpr std::array<std::uint8_t, 256> CharClassTable =
+    MakeCharClassTable();
+
+constexpr bool HasCharClass(char C, std::uint8_t Class) {
+  return CharClassTable[static_cast<unsigned char>(C)] & Class;
+}
+
+constexpr bool IsSpace(char C) { return HasCharClass(C, CHAR_SPACE); }
+
+constexpr bool IsDigit(char C) { return HasCharClass(C, CHAR_DIGIT); }
+
+constexpr bool IsLetter(char C) { return HasCharClass(C, CHAR_LETTER); }
+
+/// Letter, digit or underscore.
+constexpr bool IsIdentifierBody(char C) {
+  return HasCharClass(C, CHAR_LETTER | CHAR_DIGIT | CHAR_UNDERSCORE);
+}
+
+/// \brief Bulk scanning routines.
+///
+/// Each function processes 32 (AVX2) or 16 (SSE2) bytes per step if
+/// supported by CPU, and falls back to one byte per step at the end of
+/// range or if no SIMD available. Functions never read past End.
+namespace scan {
+
+/// \return first non-whitespace character in [Ptr, End) or End.
+const char *SkipWhitespace(const char *Ptr, const char *End);
+
+/// \return first character that cannot continue identifier in [Ptr, End)
+///         or End.
+const char *SkipIdentifierBody(const char *Ptr, const char *End);
+
+/// \return first character in [Ptr, End), that terminates plain part of
+///         string literal (", \, newline or null-terminator), or End.
+const char *SkipStringLiteralBody(const char *Ptr, const char *End);
+
+/// \return count of '\n' in [Ptr, End).
+std::size_t CountNewlines(const char *Ptr, const char *End);
+
+/// \return first '\n' in [Ptr, End) or End.
+const char *FindNewline(const char *Ptr, const char *End);
+
+/// One byte per step implementations, used as fallback and as reference
+/// for testing and benchmarking.
+const char *SkipWhitespaceScalar(const char *Ptr, const char *End);
+const char *SkipIdentifierBodyScalar(const char *Ptr, const char *End);
+const char *SkipStringLiteralBodyScalar(const char *Ptr, const char *End);
+std::size_t CountNewlinesScalar(const char *Ptr, const char *End);
+
+} // namespace scan
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_LEX_CHAR_CLASS_HPP
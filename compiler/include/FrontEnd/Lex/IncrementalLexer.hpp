@@ -0,0 +1,86 @@
+/* IncrementalLexer.hpp - Lexical analyzer, updating tokens after edit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_LEX_INCREMENTAL_LEXER_HPP
+#define WEAK_COMPILER_FRONTEND_LEX_INCREMENTAL_LEXER_HPP
+
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace weak {
+namespace middleEnd {
+class Storage;
+} // namespace middleEnd
+} // namespace weak
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Replacement of text range.
+struct TextEdit {
+  /// Offset of the first replaced character in old text.
+  SourceLocation Offset;
+
+  /// Count of removed characters.
+  SourceLocation RemovedLength;
+
+  /// Text, inserted instead of removed one.
+  std::string_view InsertedText;
+};
+
+/// Make new text from old one and edit.
+std::string ApplyEdit(std::string_view Text, const TextEdit &Edit);
+
+/// \brief Lexical analyzer for edited inputs.
+///
+/// Lexer keeps no state between tokens, so lexing can be restarted from
+/// the end of any token. Tokens, which ended before the edit, are kept as
+/// is. Lexing starts after them and stops, when new token begins at the
+/// same (shifted) place as some old one after the edit, since the rest of
+/// input is the same. So only tokens around the edit are lexed again, the
+/// rest are copied with shifted locations. Literals of replaced tokens are
+/// removed from storage, so it does not grow with each edit.
+class IncrementalLexer {
+public:
+  /// Buffer should already contain the edit. Storage should be the same
+  /// as was used to lex old tokens, so their payloads remain valid.
+  IncrementalLexer(middleEnd::Storage *TheStorage,
+                   const SourceBuffer *TheBuffer);
+
+  /// Make tokens of edited buffer from tokens of old one. Old tokens are
+  /// patched in place, so pass them with std::move() if they are not
+  /// needed anymore.
+  std::vector<Token> Relex(std::vector<Token> Tokens, const TextEdit &Edit);
+
+  /// Do not terminate program on malformed input, see
+  /// \ref Lexer::EnableErrorRecovery. Diagnostics are the ones, referred
+  /// by ERROR tokens of old version.
+  void EnableErrorRecovery(std::vector<LexDiagnostic> OldDiagnostics = {});
+
+  /// Errors of tokens, returned by \ref Relex, in source order. Payload
+  /// of ERROR token is index of its diagnostic here.
+  const std::vector<LexDiagnostic> &GetDiagnostics() const;
+
+private:
+  /// Used to accumulate symbols with their attributes.
+  middleEnd::Storage *Storage;
+
+  /// Edited input.
+  const SourceBuffer *Buffer;
+
+  bool ErrorRecovery;
+
+  std::vector<LexDiagnostic> Diagnostics;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_LEX_INCREMENTAL_LEXER_HPP
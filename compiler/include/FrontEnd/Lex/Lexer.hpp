@@ -7,7 +7,10 @@
 #ifndef WEAK_COMPILER_FRONTEND_LEX_LEXER_HPP
 #define WEAK_COMPILER_FRONTEND_LEX_LEXER_HPP
 
+#include "FrontEnd/Lex/SourceManager.hpp"
 #include "FrontEnd/Lex/Token.hpp"
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace weak {
@@ -19,49 +22,99 @@ class Storage;
 namespace weak {
 namespace frontEnd {
 
+/// \brief Error, recorded by lexer instead of terminating program.
+struct LexDiagnostic {
+  /// Offset of malformed character in source buffer.
+  SourceLocation Loc;
+
+  std::string Message;
+};
+
+/// Print diagnostic as compile error and terminate program.
+[[noreturn]] void ReportLexError(const SourceBuffer *Buffer,
+                                 const LexDiagnostic &D);
+
 /// \brief Lexical analyzer.
 ///
 /// Provides interface to transform plain text
 /// into a stream of tokens.
 class Lexer {
 public:
-  Lexer(middleEnd::Storage *TheStorage, const char *TheBufferStart,
-        const char *TheBufferEnd);
+  Lexer(middleEnd::Storage *TheStorage, const SourceBuffer *TheBuffer);
+
+  /// Lex only [Begin, End) part of buffer. Range must end at the end of
+  /// buffer or right after newline, so no token crosses its end. Token
+  /// locations are still offsets from the beginning of buffer.
+  Lexer(middleEnd::Storage *TheStorage, const SourceBuffer *TheBuffer,
+        SourceLocation Begin, SourceLocation End);
 
   /// Walk through input text and generate stream of tokens.
   std::vector<Token> Analyze();
 
+  /// Lex next token. Returns token with type NONE at the end of input
+  /// and on each call after that.
+  Token Next();
+
+  /// Storage, where symbols and literals are accumulated.
+  middleEnd::Storage *GetStorage() const;
+
+  /// Do not terminate program on malformed input. Instead, record
+  /// diagnostic, emit token of type ERROR in place of malformed input and
+  /// continue right after it.
+  void EnableErrorRecovery();
+
+  /// Errors, recorded in error recovery mode. Payload of ERROR token is
+  /// index of its diagnostic here.
+  const std::vector<LexDiagnostic> &GetDiagnostics() const;
+
 private:
   Token AnalyzeDigit();
   Token AnalyzeStringLiteral();
   Token AnalyzeSymbol();
   Token AnalyzeOperator();
 
+  /// Convert integral literal to value. Returns nothing if it does not
+  /// fit to signed int.
+  std::optional<signed> DecodeIntegral(std::string_view Digit) const;
+
+  /// Convert floating point literal to value. Returns nothing if it does
+  /// not fit to double.
+  std::optional<double> DecodeFloatingPoint(std::string_view Digit) const;
+
   /// Get current character from input range and move forward.
   char PeekNext();
 
   /// Get current character from input without moving to the next one.
   char PeekCurrent() const;
 
-  Token MakeToken(std::string_view Data, TokenType Type) const;
+  /// Terminate program or record diagnostic at given position and make
+  /// ERROR token, depending on error recovery mode.
+  Token MakeError(const char *TokenStart, const char *Position,
+                  std::string Message);
+
+  /// Make token that starts at given position of input and ends at
+  /// current one.
+  Token MakeToken(TokenType Type, const char *TokenStart,
+                  std::uint32_t Payload = 0U) const;
 
   /// Used to accumulate symbols with their attributes.
   middleEnd::Storage *Storage;
 
+  /// Input. Used to compute line and column on error.
+  const SourceBuffer *Buffer;
+
   /// First symbol in buffer.
   const char *BufferStart;
 
-  /// Last symbol in buffer (null-terminator).
+  /// End of lexed range (null-terminator if whole buffer is lexed).
   const char *BufferEnd;
 
   /// Current symbol to be lexed.
   const char *CurrentBufferPtr;
 
-  /// Line number (used for error generating).
-  unsigned CurrentLineNo;
+  bool ErrorRecovery;
 
-  /// Column number (used for error generating).
-  unsigned CurrentColumnNo;
+  std::vector<LexDiagnostic> Diagnostics;
 };
 
 } // namespace frontEnd
@@ -0,0 +1,81 @@
+/* ParallelLexer.hpp - Lexical analyzer, splitting input between threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_LEX_PARALLEL_LEXER_HPP
+#define WEAK_COMPILER_FRONTEND_LEX_PARALLEL_LEXER_HPP
+
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include <utility>
+#include <vector>
+
+namespace weak {
+class ThreadPool;
+} // namespace weak
+
+namespace weak {
+namespace middleEnd {
+class Storage;
+} // namespace middleEnd
+} // namespace weak
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Lexical analyzer for large inputs.
+///
+/// Input is split into chunks at newlines, which are lexed by
+/// \ref Lexer in parallel, each with its own symbol storage. Then the
+/// storages are merged to the given one in chunk order, so that symbol
+/// attributes and the resulting token stream are exactly the same as
+/// produced by \ref Lexer::Analyze. Chunks are always lexed in error
+/// recovery mode and diagnostics are merged in chunk order too, so the
+/// same error is reported regardless of thread scheduling.
+class ParallelLexer {
+public:
+  /// Chunks smaller than this are not worth a thread.
+  static constexpr SourceLocation DefaultMinChunkSize = 1U << 20U;
+
+  ParallelLexer(middleEnd::Storage *TheStorage, const SourceBuffer *TheBuffer,
+                ThreadPool *ThePool,
+                SourceLocation TheMinChunkSize = DefaultMinChunkSize);
+
+  /// Walk through input text and generate stream of tokens.
+  std::vector<Token> Analyze();
+
+  /// \see Lexer::EnableErrorRecovery.
+  void EnableErrorRecovery();
+
+  /// \see Lexer::GetDiagnostics.
+  const std::vector<LexDiagnostic> &GetDiagnostics() const;
+
+private:
+  using Chunk = std::pair<SourceLocation, SourceLocation>;
+
+  /// Split input to at most one chunk per thread, not smaller than
+  /// minimal chunk size.
+  std::vector<Chunk> SplitToChunks() const;
+
+  /// Used to accumulate symbols with their attributes.
+  middleEnd::Storage *Storage;
+
+  /// Input.
+  const SourceBuffer *Buffer;
+
+  ThreadPool *Pool;
+
+  SourceLocation MinChunkSize;
+
+  bool ErrorRecovery;
+
+  std::vector<LexDiagnostic> Diagnostics;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_LEX_PARALLEL_LEXER_HPP
@@ -0,0 +1,114 @@
+/* SourceManager.hpp - Owner of all source buffers.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_LEX_SOURCE_MANAGER_HPP
+#define WEAK_COMPILER_FRONTEND_LEX_SOURCE_MANAGER_HPP
+
+#include "Utility/Uncopyable.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace weak {
+namespace frontEnd {
+
+/// Byte offset in source buffer.
+using SourceLocation = std::uint32_t;
+
+/// Index of buffer in \ref SourceManager.
+using FileID = unsigned;
+
+/// \brief View of source text.
+///
+/// Source positions are stored as plain offsets, so line and column are
+/// computed only on demand (diagnostics, AST construction) from the line
+/// table, built once on the first request.
+///
+/// Buffer is guaranteed to be followed by null-terminator, so lexer is
+/// allowed to look one character past the end.
+class SourceBuffer {
+public:
+  /// Text must be followed by null-terminator, as std::string and string
+  /// literals are. View of a part of a string is not allowed.
+  SourceBuffer(std::string_view TheName, std::string_view TheText);
+
+  std::string_view GetName() const;
+
+  std::string_view GetText() const;
+
+  const char *GetBufferStart() const;
+
+  const char *GetBufferEnd() const;
+
+  /// Translate offset to 1-based line and column.
+  std::pair<unsigned, unsigned> GetLineAndColumn(SourceLocation Loc) const;
+
+  unsigned GetLineNo(SourceLocation Loc) const;
+
+  unsigned GetColumnNo(SourceLocation Loc) const;
+
+private:
+  void ComputeLineOffsets() const;
+
+  std::string Name;
+
+  std::string_view Text;
+
+  /// Offsets of the first character of each line.
+  mutable std::vector<SourceLocation> LineOffsets;
+};
+
+/// \brief Owner of source files.
+///
+/// Files are mapped to memory read-only. If it cannot be done (pipes,
+/// character devices, files of size multiple of page size, which are not
+/// followed by null-terminator), content is read to the heap instead.
+/// Either way, buffer stays at the same address until the manager is
+/// destroyed.
+class SourceManager : private Uncopyable {
+public:
+  SourceManager() = default;
+  ~SourceManager();
+
+  /// Open file. Terminates program with log message on error.
+  FileID AddFile(std::string_view Path);
+
+  /// Read whole standard input.
+  FileID AddStdin();
+
+  /// Take ownership of in-memory text.
+  FileID AddBuffer(std::string_view Name, std::string Text);
+
+  const SourceBuffer *GetBuffer(FileID ID) const;
+
+  unsigned TotalBuffers() const;
+
+private:
+  struct Entry {
+    std::unique_ptr<SourceBuffer> Buffer;
+
+    /// Set if buffer was mapped with mmap().
+    void *MappedAddress{nullptr};
+    std::size_t MappedSize{0U};
+
+    /// Set if buffer was read with read().
+    std::string Content;
+  };
+
+  FileID AddEntry(std::unique_ptr<Entry> &&);
+
+  FileID ReadFromDescriptor(std::string_view Name, int Descriptor);
+
+  std::vector<std::unique_ptr<Entry>> Entries;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_LEX_SOURCE_MANAGER_HPP
@@ -7,13 +7,25 @@
 #ifndef WEAK_COMPILER_FRONTEND_LEX_TOKEN_HPP
 #define WEAK_COMPILER_FRONTEND_LEX_TOKEN_HPP
 
-#include <string>
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace weak {
+namespace middleEnd {
+class Storage;
+} // namespace middleEnd
+} // namespace weak
 
 namespace weak {
 namespace frontEnd {
 
-enum struct TokenType {
+enum struct TokenType : std::uint8_t {
   NONE,
+  // Malformed input, reported by lexer in error recovery mode.
+  ERROR,
+
   // Keywords.
   BOOLEAN,
   BREAK,
@@ -83,30 +95,60 @@ enum struct TokenType {
 
 const char *TokenToString(TokenType Type);
 
+/// \brief Lexical unit.
+///
+/// Token is trivially copyable and has no pointers, so arrays of tokens
+/// can be copied with memcpy(), cached or written to disk as is. Text and
+/// values, that do not fit into token, are kept in side tables: source
+/// buffer and \ref middleEnd::Storage.
 struct Token {
-  Token(std::string_view TheData, TokenType TheType, unsigned TheLineNo,
-        unsigned TheColumnNo, unsigned TheAttribute = 0U);
+  /// Payload of string literal without escape sequences.
+  static constexpr std::uint32_t NoPayload = UINT32_MAX;
 
   bool operator==(const Token &rhs) const;
 
   bool operator!=(const Token &rhs) const;
 
-  /// Data if any (digits, symbols, literals).
-  std::string Data;
-
   /// Token type.
   TokenType Type;
 
-  /// Position in source text.
-  unsigned LineNo;
+  /// Offset of the first token character in source buffer. Line and column
+  /// are computed from it by \ref SourceBuffer when needed.
+  SourceLocation Loc;
+
+  /// Length of token text in source buffer (including quotes of string
+  /// literal).
+  std::uint32_t Length;
+
+  /// Depends on token type:
+  ///   - symbol: integer value used to represent variable in symbol table,
+  ///     used by CFG builder/analyzer and code generator;
+  ///   - integral literal: decoded value;
+  ///   - floating point literal: index of decoded value in storage;
+  ///   - string literal: index of unescaped value in storage, or
+  ///     \ref NoPayload if literal has no escape sequences;
+  ///   - error: index of lexer diagnostic.
+  std::uint32_t Payload;
+};
 
-  /// Position in source text.
-  unsigned ColumnNo;
+static_assert(sizeof(Token) == 16U, "Token should fit in 16 bytes");
+static_assert(std::is_trivially_copyable_v<Token>,
+              "Token should be copyable with memcpy()");
 
-  /// Integer value used to represent variable in symbol table.
-  /// Used by CFG builder/analyzer and code generator.
-  unsigned Attribute;
-};
+/// Text of token as written in source.
+std::string_view GetTokenText(const SourceBuffer *Buffer, const Token &T);
+
+/// Value of string literal: text between quotes, or unescaped value from
+/// storage if literal has escape sequences.
+std::string_view GetStringLiteral(const SourceBuffer *Buffer,
+                                  const middleEnd::Storage *S,
+                                  const Token &T);
+
+/// Value of integral literal.
+signed GetIntegralValue(const Token &T);
+
+/// Value of floating point literal.
+double GetFloatingPointValue(const middleEnd::Storage *S, const Token &T);
 
 } // namespace frontEnd
 } // namespace weak
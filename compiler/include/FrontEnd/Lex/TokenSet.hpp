@@ -0,0 +1,73 @@
+/* TokenSet.hpp - Set of token types.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_LEX_TOKEN_SET_HPP
+#define WEAK_COMPILER_FRONTEND_LEX_TOKEN_SET_HPP
+
+#include "FrontEnd/Lex/Token.hpp"
+#include <cstdint>
+#include <initializer_list>
+
+namespace weak {
+namespace frontEnd {
+
+/// \brief Bit set over TokenType.
+///
+/// Fits in two registers and is built at compile time, so expected token
+/// lists are passed by value without allocations, and membership test is
+/// one shift and mask.
+class TokenSet {
+public:
+  /// Count of token types, that can be stored.
+  static constexpr unsigned Capacity = 128U;
+
+  constexpr TokenSet() : Words{0U, 0U} {}
+
+  /// Implicit, so single token type can be passed where set is expected.
+  constexpr TokenSet(TokenType Type) : Words{0U, 0U} { Insert(Type); }
+
+  constexpr TokenSet(std::initializer_list<TokenType> Types) : Words{0U, 0U} {
+    for (TokenType Type : Types)
+      Insert(Type);
+  }
+
+  constexpr void Insert(TokenType Type) {
+    unsigned Index = static_cast<unsigned>(Type);
+    Words[Index / 64U] |= std::uint64_t{1U} << (Index % 64U);
+  }
+
+  constexpr bool Contains(TokenType Type) const {
+    unsigned Index = static_cast<unsigned>(Type);
+    return (Words[Index / 64U] >> (Index % 64U)) & 1U;
+  }
+
+  constexpr bool Empty() const { return Words[0] == 0U && Words[1] == 0U; }
+
+  constexpr TokenSet operator|(TokenSet Other) const {
+    TokenSet Result;
+    Result.Words[0] = Words[0] | Other.Words[0];
+    Result.Words[1] = Words[1] | Other.Words[1];
+    return Result;
+  }
+
+  constexpr bool operator==(TokenSet Other) const {
+    return Words[0] == Other.Words[0] && Words[1] == Other.Words[1];
+  }
+
+  constexpr bool operator!=(TokenSet Other) const { return !(*this == Other); }
+
+private:
+  std::uint64_t Words[2];
+};
+
+static_assert(static_cast<unsigned>(TokenType::CLOSE_PAREN) <
+                  TokenSet::Capacity,
+              "All token types should fit in TokenSet");
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_LEX_TOKEN_SET_HPP
@@ -0,0 +1,150 @@
+/* IncrementalParser.hpp - Syntax analyzer, reusing functions after edit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_PARSE_INCREMENTAL_PARSER_HPP
+#define WEAK_COMPILER_FRONTEND_PARSE_INCREMENTAL_PARSER_HPP
+
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "Utility/Uncopyable.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace weak {
+namespace middleEnd {
+class Storage;
+} // namespace middleEnd
+} // namespace weak
+
+namespace weak {
+namespace frontEnd {
+
+class ASTContext;
+
+/// \brief Syntax analyzer for edited inputs.
+///
+/// Global functions are found by matching curly brackets, as in
+/// \ref ParallelParser. Function, whose text is byte-identical to some
+/// function of the previous version and starts at the same column, is not
+/// parsed again: its subtree is taken from the previous tree and moved to
+/// the new line if needed. So re-analysis cost depends on size of edited
+/// functions, not of the whole input. Declarations are numbered as by
+/// \ref Parser for the whole input, so functions after edit, which added
+/// or removed declarations, are renumbered as well.
+///
+/// Diagnostics are kept with the function, so reused function with syntax
+/// errors reports them again, moved to its new position.
+///
+/// Nodes are kept in context, owned by parser. Nodes of edited functions
+/// become garbage, and when there is more garbage than live nodes,
+/// everything is parsed again into new context.
+class IncrementalParser : private Uncopyable {
+public:
+  /// Garbage smaller than this (in bytes) is not worth reparsing.
+  static constexpr std::size_t DefaultMinGarbageSize = 1U << 20U;
+
+  IncrementalParser(std::size_t TheMinGarbageSize = DefaultMinGarbageSize);
+
+  ~IncrementalParser();
+
+  /// Parse new version of input. Storage is used to get values of
+  /// literals. Reused subtrees are patched in place, so the previous tree
+  /// is not valid after the call.
+  ///
+  /// \return tree, which lives until the next call or parser destruction.
+  ASTCompoundStmt *Reparse(const SourceBuffer *Source,
+                           const middleEnd::Storage *Storage,
+                           const Token *BufferStart, const Token *BufferEnd);
+
+  /// \see Parser::EnableErrorRecovery.
+  void EnableErrorRecovery(unsigned TheErrorLimit = Parser::DefaultErrorLimit);
+
+  /// \see Parser::EnableDepthLimit.
+  void EnableDepthLimit(unsigned TheDepthLimit = Parser::DefaultDepthLimit);
+
+  /// Errors of the last tree in source order, up to error limit.
+  ///
+  /// \see Parser::GetDiagnostics.
+  const std::vector<ParseDiagnostic> &GetDiagnostics() const;
+
+  /// Content hash of Index-th function of the last tree. It stays the same
+  /// while function text is not edited, so it can be used as key of caches
+  /// of later stages.
+  std::size_t GetFunctionHash(unsigned Index) const;
+
+  /// \return count of functions, reused by the last call to Reparse().
+  unsigned GetReusedCount() const;
+
+private:
+  struct Function {
+    /// Position of text in \ref Text.
+    SourceLocation Offset;
+    SourceLocation Length;
+
+    /// Position of the first token.
+    unsigned LineNo;
+    unsigned ColumnNo;
+
+    std::size_t Hash;
+
+    /// Index of the first declaration and count of declarations.
+    unsigned FirstDeclaration;
+    unsigned TotalDeclarations;
+
+    /// Bytes of context, allocated to parse function.
+    std::size_t Bytes;
+
+    /// Function declaration. With syntax errors, range of function can
+    /// also hold error nodes and other global entities.
+    ASTNodeList Nodes;
+
+    std::vector<ParseDiagnostic> Diagnostics;
+  };
+
+  /// Parse range of tokens of F into context.
+  void ParseFunction(Function &F, const SourceBuffer *Source,
+                     const middleEnd::Storage *Storage, TokenRange Range);
+
+  /// Make new context if it holds more garbage than live nodes.
+  void CollectGarbage();
+
+  /// Owner of all nodes.
+  std::unique_ptr<ASTContext> Context;
+
+  /// Text of the last parsed version.
+  std::string Text;
+
+  /// Functions of the last parsed version, in source order.
+  std::vector<Function> Functions;
+
+  /// Indices in \ref Functions by function hash, in reverse source order.
+  /// Candidates are taken from the back, so copies of the same function
+  /// are matched in source order without rescans.
+  std::unordered_map<std::size_t, std::vector<std::size_t>> FunctionsByHash;
+
+  std::size_t MinGarbageSize;
+
+  unsigned ReusedCount;
+
+  bool ErrorRecovery;
+
+  unsigned ErrorLimit;
+
+  /// Zero means no limit.
+  unsigned DepthLimit;
+
+  std::vector<ParseDiagnostic> Diagnostics;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_PARSE_INCREMENTAL_PARSER_HPP
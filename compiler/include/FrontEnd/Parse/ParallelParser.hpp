@@ -0,0 +1,113 @@
+/* ParallelParser.hpp - Syntax analyzer, splitting input between threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_FRONTEND_PARSE_PARALLEL_PARSER_HPP
+#define WEAK_COMPILER_FRONTEND_PARSE_PARALLEL_PARSER_HPP
+
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Lex/Token.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace weak {
+class ThreadPool;
+} // namespace weak
+
+namespace weak {
+namespace middleEnd {
+class Storage;
+} // namespace middleEnd
+} // namespace weak
+
+namespace weak {
+namespace frontEnd {
+
+class ASTContext;
+
+/// \brief Syntax analyzer for large inputs.
+///
+/// Global entities are functions only, and each function ends with '}'
+/// closing its body. So top-level functions are found by matching curly
+/// brackets in token stream, without parsing. Ranges of consecutive
+/// functions are parsed by \ref Parser in parallel, each into context of
+/// its own, and then nodes of all functions are collected to the root
+/// statement in source order. Declarations of each chunk are renumbered
+/// after chunks before it, so the resulting tree is the same as produced
+/// by \ref Parser::Parse.
+///
+/// If brackets are not balanced, input is parsed sequentially. Otherwise
+/// chunks are always parsed in error recovery mode and diagnostics are
+/// merged in chunk order, so the same error is reported regardless of
+/// thread scheduling.
+class ParallelParser {
+public:
+  /// Ranges smaller than this are not worth a thread.
+  static constexpr std::size_t DefaultMinChunkSize = 1U << 16U;
+
+  /// Storage is used to get values of literals. Nodes are allocated in
+  /// given context.
+  ParallelParser(ASTContext *TheContext, const SourceBuffer *TheSource,
+                 const middleEnd::Storage *TheStorage,
+                 const Token *TheBufferStart, const Token *TheBufferEnd,
+                 ThreadPool *ThePool,
+                 std::size_t TheMinChunkSize = DefaultMinChunkSize);
+
+  /// Transform token stream to AST, which lives as long as context.
+  ASTCompoundStmt *Parse();
+
+  /// \see Parser::EnableErrorRecovery.
+  void EnableErrorRecovery(unsigned TheErrorLimit = Parser::DefaultErrorLimit);
+
+  /// \see Parser::EnableDepthLimit.
+  void EnableDepthLimit(unsigned TheDepthLimit = Parser::DefaultDepthLimit);
+
+  /// \see Parser::GetDiagnostics.
+  const std::vector<ParseDiagnostic> &GetDiagnostics() const;
+
+private:
+  using Chunk = TokenRange;
+
+  /// Split input at function boundaries to at most one chunk per thread,
+  /// not smaller than minimal chunk size (in tokens).
+  ///
+  /// \return empty list if curly brackets are not balanced.
+  std::vector<Chunk> SplitToChunks() const;
+
+  /// Owner of the resulting tree.
+  ASTContext *Context;
+
+  /// Source text, used to restore positions and text of tokens.
+  const SourceBuffer *Source;
+
+  /// Values of literals, which do not fit in tokens.
+  const middleEnd::Storage *Storage;
+
+  /// First token in input stream.
+  const Token *BufferStart;
+
+  /// Last token in input stream.
+  const Token *BufferEnd;
+
+  ThreadPool *Pool;
+
+  std::size_t MinChunkSize;
+
+  bool ErrorRecovery;
+
+  unsigned ErrorLimit;
+
+  /// Zero means no limit.
+  unsigned DepthLimit;
+
+  std::vector<ParseDiagnostic> Diagnostics;
+};
+
+} // namespace frontEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_FRONTEND_PARSE_PARALLEL_PARSER_HPP
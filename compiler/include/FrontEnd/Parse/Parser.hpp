@@ -8,123 +8,268 @@
 #define WEAK_COMPILER_FRONTEND_PARSE_PARSER_HPP
 
 #include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
 #include "FrontEnd/Lex/Token.hpp"
+#include "FrontEnd/Lex/TokenSet.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/StringInterner.hpp"
+#include <array>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace weak {
 namespace frontEnd {
 
-/// \brief LL(1) Syntax analyzer.
+class ASTContext;
+class ASTSymbol;
+class ASTVarDecl;
+class Lexer;
+
+/// \brief Error, recorded by parser instead of terminating program.
+struct ParseDiagnostic {
+  /// Offset of the first token, that cannot be parsed.
+  SourceLocation Loc;
+
+  std::string Message;
+};
+
+/// Print diagnostic as compile error and terminate program.
+[[noreturn]] void ReportParseError(const SourceBuffer *Buffer,
+                                   const ParseDiagnostic &D);
+
+/// Print diagnostics as compile errors and continue.
+void PrintParseErrors(const SourceBuffer *Buffer,
+                      const std::vector<ParseDiagnostic> &D);
+
+/// Tokens [first, second).
+using TokenRange = std::pair<const Token *, const Token *>;
+
+/// Find global functions by matching curly brackets, without parsing. Each
+/// range ends with '}' closing function body, except the last one, which
+/// takes tokens after the last function, if any.
+///
+/// \return empty list if curly brackets are not balanced.
+std::vector<TokenRange> SplitToFunctions(const Token *Begin,
+                                         const Token *End);
+
+/// Move all nodes of subtree by LineDelta lines and add DeclarationDelta
+/// to indices of its declarations and of symbols, bound to them. Used to
+/// put separately parsed part of input to its place in translation unit.
+/// Deltas are added with unsigned overflow, so they can be "negative".
+void ShiftSubtree(ASTNode *Root, unsigned LineDelta,
+                  unsigned DeclarationDelta);
+
+/// \brief LL(2) Syntax analyzer.
+///
+/// Tokens are requested one by one and only the lookahead window is kept,
+/// so memory used for tokens does not depend on input size.
 class Parser {
 public:
-  Parser(const Token *TheBufferStart, const Token *TheBufferEnd);
+  /// Take tokens from lexer on demand. Nodes are allocated in given context.
+  Parser(ASTContext *TheContext, const SourceBuffer *TheSource,
+         Lexer *TheLexer);
+
+  /// Take tokens from already lexed range. Storage is used to get values of
+  /// literals.
+  Parser(ASTContext *TheContext, const SourceBuffer *TheSource,
+         const middleEnd::Storage *TheStorage, const Token *TheBufferStart,
+         const Token *TheBufferEnd);
+
+  /// Transform token stream to AST, which lives as long as context.
+  ASTCompoundStmt *Parse();
+
+  /// Count of errors, after which parsing is stopped in error recovery mode.
+  static constexpr unsigned DefaultErrorLimit = 20U;
+
+  /// Do not terminate program on syntax error. Instead, record diagnostic,
+  /// skip tokens up to the end of malformed statement or function and put
+  /// \ref ASTErrorNode in its place. Parsing is stopped after ErrorLimit
+  /// errors. Statement, broken by ERROR token, is skipped without
+  /// diagnostic, since lexer has reported it already.
+  void EnableErrorRecovery(unsigned TheErrorLimit = DefaultErrorLimit);
+
+  /// Nesting depth, enough for any hand-written code.
+  static constexpr unsigned DefaultDepthLimit = 1024U;
+
+  /// Report error instead of going deeper than DepthLimit nested statements
+  /// and expressions, so parser and recursive passes over the tree need
+  /// bounded stack. Each binary and postfix operator of chain counts as
+  /// one level, since it can make tree one level deeper.
+  void EnableDepthLimit(unsigned TheDepthLimit = DefaultDepthLimit);
+
+  /// Errors, recorded in error recovery mode, in source order.
+  const std::vector<ParseDiagnostic> &GetDiagnostics() const;
 
-  /// Transform token stream to AST.
-  std::unique_ptr<ASTCompoundStmt> Parse();
+  /// Number declarations from First instead of zero. Parser of a part of
+  /// translation unit starts from count of declarations before the part,
+  /// so indices are the same as if the whole unit was parsed at once.
+  void SetFirstDeclaration(unsigned First);
+
+  /// \return count of declarations, numbered by parser.
+  unsigned TotalDeclarations() const;
 
 private:
-  std::unique_ptr<ASTNode> ParseFunctionDecl();
+  ASTNode *ParseFunctionDecl();
 
   /// Function call with optional argument list.
-  std::unique_ptr<ASTNode> ParseFunctionCall();
+  ASTNode *ParseFunctionCall();
 
-  std::unique_ptr<ASTNode> ParseVarDecl();
+  ASTNode *ParseVarDecl();
 
   /// Int, char, string, bool.
-  const Token &ParseType();
+  Token ParseType();
 
   /// All from ParseType() or void.
-  const Token &ParseReturnType();
+  Token ParseReturnType();
 
   /// {Data type} {id}.
-  std::unique_ptr<ASTNode> ParseParameter();
+  ASTNode *ParseParameter();
 
   /// ({Data type} {id} ,?)*
-  std::vector<std::unique_ptr<ASTNode>> ParseParameterList();
+  ASTNodeList ParseParameterList();
 
   /// Block of code between '{' and '}'.
-  std::unique_ptr<ASTCompoundStmt> ParseBlock();
+  ASTCompoundStmt *ParseBlock();
 
   /// Block of code with break and continue statements.
-  std::unique_ptr<ASTCompoundStmt> ParseIterationStmtBlock();
+  ASTCompoundStmt *ParseIterationStmtBlock();
 
   /// Selection, iterative, jump, assignment statement
   /// or unary/binary operator.
-  std::unique_ptr<ASTNode> ParseStatement();
+  ASTNode *ParseStatement();
+
+  /// ParseStatement() without depth check.
+  ASTNode *ParseStatementWithoutNesting();
 
   /// If statement.
-  std::unique_ptr<ASTNode> ParseSelectionStatement();
+  ASTNode *ParseSelectionStatement();
 
   /// For, while or do-while statement.
-  std::unique_ptr<ASTNode> ParseIterationStatement();
+  ASTNode *ParseIterationStatement();
 
-  std::unique_ptr<ASTNode> ParseForStatement();
+  ASTNode *ParseForStatement();
 
-  std::unique_ptr<ASTNode> ParseWhileStatement();
+  ASTNode *ParseWhileStatement();
 
-  std::unique_ptr<ASTNode> ParseDoWhileStatement();
+  ASTNode *ParseDoWhileStatement();
 
   /// ParseStatement, break and continue statements.
-  std::unique_ptr<ASTNode> ParseLoopStatement();
+  ASTNode *ParseLoopStatement();
 
   /// Return statement.
-  std::unique_ptr<ASTNode> ParseJumpStatement();
+  ASTNode *ParseJumpStatement();
 
   /// Unary/binary statement, literal, symbol or function call.
-  std::unique_ptr<ASTNode> ParseExpression();
+  ASTNode *ParseExpression();
 
-  std::unique_ptr<ASTNode> ParseAssignment();
+  /// Assignment or any other binary operator.
+  ASTNode *ParseAssignment();
 
-  std::unique_ptr<ASTNode> ParseLogicalOr();
+  /// Any binary operator, except assignment.
+  ASTNode *ParseLogicalOr();
 
-  std::unique_ptr<ASTNode> ParseLogicalAnd();
+  /// Parse operand with all following binary operators, which bind at least
+  /// as strong as MinPrecedence. One call handles one operator, instead of
+  /// descending through function per precedence level.
+  ASTNode *ParseBinary(unsigned MinPrecedence);
 
-  std::unique_ptr<ASTNode> ParseInclusiveOr();
+  ASTNode *ParsePrefixUnary();
 
-  std::unique_ptr<ASTNode> ParseExclusiveOr();
+  ASTNode *ParsePostfixUnary();
 
-  std::unique_ptr<ASTNode> ParseAnd();
+  ASTNode *ParsePrimary();
 
-  std::unique_ptr<ASTNode> ParseEquality();
+  /// Integral, floating-point, string or boolean literal.
+  ASTNode *ParseConstant();
 
-  std::unique_ptr<ASTNode> ParseRelational();
+  /// Symbol name or number as written in source text.
+  std::string_view GetText(const Token &) const;
 
-  std::unique_ptr<ASTNode> ParseShift();
+  /// Interned name of symbol, taken from storage. Text of other tokens,
+  /// met in error recovery, is interned.
+  StringInterner::ID GetIdentifier(const Token &) const;
 
-  std::unique_ptr<ASTNode> ParseAdditive();
+  /// Add variable to the current scope and number it.
+  void Declare(ASTVarDecl *);
 
-  std::unique_ptr<ASTNode> ParseMultiplicative();
+  /// Bind symbol to the innermost visible declaration. Undeclared symbols
+  /// are left unresolved.
+  void Resolve(ASTSymbol *);
 
-  std::unique_ptr<ASTNode> ParsePrefixUnary();
+  /// Compute position of token in source text.
+  unsigned GetLineNo(const Token &) const;
 
-  std::unique_ptr<ASTNode> ParsePostfixUnary();
+  /// Compute position of token in source text.
+  unsigned GetColumnNo(const Token &) const;
 
-  std::unique_ptr<ASTNode> ParsePrimary();
+  /// Token with type NONE, returned at the end of input.
+  Token MakeEndToken() const;
 
-  /// Integral, floating-point, string or boolean literal.
-  std::unique_ptr<ASTNode> ParseConstant();
+  /// Get next token from lexer or input range.
+  Token Fetch();
+
+  /// Get N-th token after current without consuming anything. Tokens are
+  /// returned by reference to lookahead window, so it is valid only until
+  /// the next call to PeekNext().
+  const Token &PeekAhead(unsigned N);
 
   /// Get current token from input range and move forward.
-  const Token &PeekNext();
+  Token PeekNext();
 
   /// Get current token from input range without moving to the next one.
-  const Token &PeekCurrent() const;
+  Token PeekCurrent();
 
-  /// Return true and move current buffer pointer forward if current token
-  /// matches any of expected, otherwise return false.
-  bool Match(const std::vector<TokenType> &Expected);
+  /// Increase nesting depth.
+  ///
+  /// \return false if depth limit is reached and error is reported.
+  bool EnterNesting(const Token &At);
+
+  /// Decrease nesting depth, increased by the given count of successful
+  /// calls to \ref EnterNesting.
+  void LeaveNesting(unsigned Levels = 1U);
 
   /// Return true and move current buffer pointer forward if current token
-  /// matches given token type, otherwise return false.
-  bool Match(TokenType Expected);
+  /// matches any of expected, otherwise return false.
+  bool Match(TokenSet Expected);
 
   /// Does the Match job, but terminates program with log message on error.
-  const Token &Require(const std::vector<TokenType> &Expected);
+  Token Require(TokenSet Expected);
 
-  /// Does the Match job, but terminates program with log message on error.
-  const Token &Require(TokenType Expected);
+  void CheckIfHaveMoreTokens(const Token &Current);
 
-  void CheckIfHaveMoreTokens() const;
+  /// Terminate program or, in error recovery mode, record diagnostic and
+  /// enter panic mode. In panic mode input is frozen: nothing is consumed,
+  /// Match() and Require() fail, and further errors are not recorded, since
+  /// they are most likely caused by the first one. Loops of parse functions
+  /// stop, so parser quickly returns to the nearest synchronization point.
+  void ReportError(const Token &At, std::string Message);
+
+  /// Leave panic mode after malformed statement. Tokens are skipped until
+  /// ';', '}' closing nested block (both consumed) or '}' closing current
+  /// block (left to the caller).
+  ///
+  /// \return node, that replaces malformed statement.
+  ASTNode *RecoverStatement(const Token &Begin);
+
+  /// Leave panic mode after malformed global entity. Tokens are skipped
+  /// until '}' closing function body (consumed) or type keyword outside of
+  /// any block, that starts next function.
+  ///
+  /// \return node, that replaces malformed function.
+  ASTNode *RecoverFunction(const Token &Begin);
+
+  /// Owner of created nodes.
+  ASTContext *Context;
+
+  /// Source text, used to restore positions and text of tokens.
+  const SourceBuffer *Source;
+
+  /// Values of literals, which do not fit in tokens.
+  const middleEnd::Storage *Storage;
+
+  /// Token producer. Null if tokens are given as range.
+  Lexer *TokenSource;
 
   /// First token in input stream.
   const Token *BufferStart;
@@ -132,11 +277,58 @@ private:
   /// Last token in input stream.
   const Token *BufferEnd;
 
-  /// Current token to be processed.
+  /// Next token to be fetched from input range.
   const Token *CurrentBufferPtr;
 
+  /// Maximum count of tokens needed to choose between alternatives
+  /// (function call is distinguished from other expressions by '('
+  /// after name).
+  static constexpr unsigned LookaheadSize = 2U;
+
+  /// Ring buffer of fetched, but not consumed tokens.
+  std::array<Token, LookaheadSize> Lookahead;
+
+  /// Index of current token in lookahead window.
+  unsigned LookaheadStart;
+
+  /// Count of tokens in lookahead window.
+  unsigned LookaheadCount;
+
+  /// Declarations of open scopes of current function. Blocks and 'for'
+  /// statements open scopes, so inner declaration shadows outer one with
+  /// the same name.
+  middleEnd::Storage Declarations;
+
+  /// Index of the first declaration, made by this parser. Declaration
+  /// index is its attribute in \ref Declarations plus this.
+  unsigned FirstDeclaration;
+
   /// Depth of currently analyzed loop. Needed for 'break', 'continue' parsing.
   std::size_t LoopsDepth;
+
+  /// Current nesting of statements and expressions.
+  unsigned NestingDepth;
+
+  /// Maximum nesting. Zero means no limit.
+  unsigned DepthLimit;
+
+  /// Operands and operators, waiting for their right operands in
+  /// \ref ParseBinary. Operators bind weaker from bottom to top of stack.
+  std::vector<ASTNode *> BinaryOperands;
+  std::vector<Token> BinaryOperators;
+
+  bool ErrorRecovery;
+
+  unsigned ErrorLimit;
+
+  /// Set after error until synchronization point is reached.
+  bool Panicking;
+
+  /// Set after end of input or error limit is reached. Parser stays in
+  /// panic mode up to the end.
+  bool Stopped;
+
+  std::vector<ParseDiagnostic> Diagnostics;
 };
 
 } // namespace frontEnd
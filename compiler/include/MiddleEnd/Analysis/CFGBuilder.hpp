@@ -7,56 +7,94 @@
 #ifndef WEAK_COMPILER_MIDDLE_END_ANALYSIS_CFG_BUILDER_HPP
 #define WEAK_COMPILER_MIDDLE_END_ANALYSIS_CFG_BUILDER_HPP
 
-#include "FrontEnd/AST/ASTVisitor.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/FlatAST.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
 #include "MiddleEnd/Analysis/CFG.hpp"
 #include "MiddleEnd/Analysis/CFGBlock.hpp"
-#include <memory>
+#include "Utility/StringInterner.hpp"
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
 
 namespace weak {
 namespace middleEnd {
 
 /// \brief The builder of Control Flow Graph.
 ///
-/// Implemented as visitor since operates on AST.
-class CFGBuilder : private frontEnd::ASTVisitor {
+/// Implemented as visitor since operates on AST. Flat AST is walked by
+/// switch on node type, and both walks share the code, which makes blocks.
+class CFGBuilder : private frontEnd::RecursiveASTVisitor<CFGBuilder> {
 public:
-  CFGBuilder(const std::vector<std::unique_ptr<frontEnd::ASTNode>> &);
+  CFGBuilder(frontEnd::ASTNodeList);
+
+  /// Build from flat AST, whose root holds functions. IR refers to nodes
+  /// of the tree, flat AST was made from.
+  CFGBuilder(const frontEnd::FlatAST *);
 
   void Build();
 
   CFG &GetCFG() const;
 
 private:
-  void Visit(const frontEnd::ASTBooleanLiteral *) const override {}
-  void Visit(const frontEnd::ASTBreakStmt *) const override {}
-  void Visit(const frontEnd::ASTContinueStmt *) const override {}
-  void Visit(const frontEnd::ASTFloatingPointLiteral *) const override {}
-  void Visit(const frontEnd::ASTFunctionCall *) const override {}
-  void Visit(const frontEnd::ASTSymbol *) const override {}
-  void Visit(const frontEnd::ASTIntegerLiteral *) const override {}
-  void Visit(const frontEnd::ASTReturnStmt *) const override {}
-  void Visit(const frontEnd::ASTStringLiteral *) const override {}
-  void Visit(const frontEnd::ASTUnaryOperator *) const override {}
+  friend class frontEnd::RecursiveASTVisitor<CFGBuilder>;
+
+  void Visit(const frontEnd::ASTBooleanLiteral *) {}
+  void Visit(const frontEnd::ASTBreakStmt *) {}
+  void Visit(const frontEnd::ASTContinueStmt *) {}
+  void Visit(const frontEnd::ASTErrorNode *) {}
+  void Visit(const frontEnd::ASTFloatingPointLiteral *) {}
+  void Visit(const frontEnd::ASTFunctionCall *) {}
+  void Visit(const frontEnd::ASTSymbol *) {}
+  void Visit(const frontEnd::ASTIntegerLiteral *) {}
+  void Visit(const frontEnd::ASTReturnStmt *) {}
+  void Visit(const frontEnd::ASTStringLiteral *) {}
+  void Visit(const frontEnd::ASTUnaryOperator *) {}
 
   /// Insert analyzed variable declaration to \ref BlocksForVariable.
-  void Visit(const frontEnd::ASTVarDecl *) const override;
+  void Visit(const frontEnd::ASTVarDecl *);
 
   /// Insert analyzed variable declaration to \ref BlocksForVariable
   /// if we have an assignment.
-  void Visit(const frontEnd::ASTBinaryOperator *) const override;
-  void Visit(const frontEnd::ASTCompoundStmt *) const override;
-  void Visit(const frontEnd::ASTFunctionDecl *) const override;
-  void Visit(const frontEnd::ASTIfStmt *) const override;
-  void Visit(const frontEnd::ASTWhileStmt *) const override;
-  void Visit(const frontEnd::ASTDoWhileStmt *) const override;
-  void Visit(const frontEnd::ASTForStmt *) const override;
+  void Visit(const frontEnd::ASTBinaryOperator *);
+  void Visit(const frontEnd::ASTCompoundStmt *);
+  void Visit(const frontEnd::ASTFunctionDecl *);
+  void Visit(const frontEnd::ASTIfStmt *);
+  void Visit(const frontEnd::ASTWhileStmt *);
+  void Visit(const frontEnd::ASTDoWhileStmt *);
+  void Visit(const frontEnd::ASTForStmt *);
+
+  /// Visit node of flat AST. Placeholders are skipped.
+  void VisitFlat(frontEnd::FlatAST::NodeIndex);
+
+  /// Walks body of control flow statement.
+  using BodyBuilder = std::function<void()>;
+
+  /// Emit assignment to \ref CurrentBlock and remember, that variable is
+  /// assigned there.
+  void AddAssignment(frontEnd::ASTSymbol *Variable, frontEnd::ASTNode *Operand);
+
+  /// ElseBody is empty, if there is no else branch.
+  void BuildIf(frontEnd::ASTNode *Condition, const BodyBuilder &ThenBody,
+               const BodyBuilder &ElseBody);
+  void BuildWhile(frontEnd::ASTNode *Condition, const BodyBuilder &Body);
+  void BuildDoWhile(frontEnd::ASTNode *Condition, const BodyBuilder &Body);
+
+  /// Body includes increment.
+  void BuildFor(frontEnd::ASTNode *Condition, const BodyBuilder &Init,
+                const BodyBuilder &Body);
+
+  /// Make symbol of variable, bound to its declaration.
+  frontEnd::ASTSymbol *MakeVariable(unsigned Declaration,
+                                    StringInterner::ID Name);
 
   /// Allocate the new block with unique label.
-  CFGBlock *MakeBlock(std::string Label) const;
+  CFGBlock *MakeBlock(std::string Label);
 
   /// Helper function to insert branches to \ref CurrentBlock.
   void MakeBranch(frontEnd::ASTNode *Condition, CFGBlock *ThenBlock,
-                  CFGBlock *ElseBlock) const;
+                  CFGBlock *ElseBlock);
 
   void InsertPhiNodes();
   void BuildSSAForm();
@@ -65,18 +103,32 @@ private:
   /// \todo Reindex CFG blocks numbers.
   void ReduceGraph();
 
-  /// Simple reference to our AST stuff.
-  const std::vector<std::unique_ptr<frontEnd::ASTNode>> &StatementsRef;
+  /// Simple view of our AST stuff.
+  frontEnd::ASTNodeList Statements;
+
+  /// Used instead of statements, if set.
+  const frontEnd::FlatAST *Flat;
+
+  /// Owner of symbols, created for IR instructions.
+  frontEnd::ASTContext SymbolContext;
 
   /// Generated Control Flow Graph.
   mutable CFG CFGraph;
 
   /// Helper pointer to simplify code design.
-  mutable CFGBlock *CurrentBlock;
-
-  /// Mapping variables to blocks where they are assigned. Used
-  /// to decide where to put Phi-nodes.
-  mutable std::map<std::string, std::set<CFGBlock *>> BlocksForVariable;
+  CFGBlock *CurrentBlock;
+
+  /// Variable with blocks where it is assigned.
+  struct AssignedVariable {
+    StringInterner::ID Name;
+    std::set<CFGBlock *> Blocks;
+  };
+
+  /// Mapping declaration indices of variables (see
+  /// \ref frontEnd::ASTVarDecl::GetDeclaration) to blocks where they are
+  /// assigned. Used to decide where to put Phi-nodes. Names are not unique,
+  /// since inner variable can shadow outer one.
+  std::map<unsigned, AssignedVariable> BlocksForVariable;
 };
 
 } // namespace middleEnd
@@ -22,10 +22,12 @@ class SSAForm {
 public:
   SSAForm(CFG *);
 
-  void Compute(std::string_view Variable);
+  /// Number definitions of variable, declared by declaration with given
+  /// index (see \ref frontEnd::ASTVarDecl::GetDeclaration).
+  void Compute(unsigned Declaration);
 
 private:
-  void Compute(CFGBlock *Block, std::string_view Variable);
+  void Compute(CFGBlock *Block, unsigned Declaration);
 
   CFG *CFGraph;
   int SSAIndex;
@@ -0,0 +1,115 @@
+/* SemanticAnalyzer.hpp - Type checking of AST.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_MIDDLE_END_ANALYSIS_SEMANTIC_ANALYZER_HPP
+#define WEAK_COMPILER_MIDDLE_END_ANALYSIS_SEMANTIC_ANALYZER_HPP
+
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace weak {
+namespace middleEnd {
+
+/// \brief Error, found by semantic analysis.
+struct SemanticDiagnostic {
+  unsigned LineNo;
+  unsigned ColumnNo;
+  std::string Message;
+};
+
+/// \brief Single pass type checking.
+///
+/// Symbols are already resolved by parser (see
+/// \ref frontEnd::ASTSymbol::GetDeclaration), so type of variable is found
+/// by index of its declaration, and unresolved symbol is reported as not
+/// declared. Each expression gets its type, stored in node (see
+/// \ref frontEnd::ASTNode::GetExprType), so later passes do not compute
+/// types again. Operands are analyzed before operator, so type of
+/// expression is computed from already stored types of its operands.
+///
+/// Integral and floating point types are converted implicitly, any other
+/// types must match exactly. Expression with error gets type NONE and
+/// errors caused by it are not reported.
+class SemanticAnalyzer
+    : private frontEnd::RecursiveASTVisitor<SemanticAnalyzer,
+                                            /*IsConst=*/false> {
+public:
+  /// Root holds functions, as produced by parser.
+  SemanticAnalyzer(frontEnd::ASTNode *TheRoot);
+
+  /// Annotate whole tree. The first error terminates program, unless
+  /// error recovery is enabled.
+  void Analyze();
+
+  /// Do not terminate program on error. Instead, record diagnostic and
+  /// continue analysis.
+  void EnableErrorRecovery();
+
+  /// Errors, recorded in error recovery mode, in order of traversal.
+  const std::vector<SemanticDiagnostic> &GetDiagnostics() const;
+
+private:
+  friend class frontEnd::RecursiveASTVisitor<SemanticAnalyzer, false>;
+
+  void Visit(frontEnd::ASTBreakStmt *) {}
+  void Visit(frontEnd::ASTContinueStmt *) {}
+  void Visit(frontEnd::ASTErrorNode *) {}
+
+  void Visit(frontEnd::ASTBinaryOperator *);
+  void Visit(frontEnd::ASTBooleanLiteral *);
+  void Visit(frontEnd::ASTCompoundStmt *);
+  void Visit(frontEnd::ASTDoWhileStmt *);
+  void Visit(frontEnd::ASTFloatingPointLiteral *);
+  void Visit(frontEnd::ASTForStmt *);
+  void Visit(frontEnd::ASTFunctionCall *);
+  void Visit(frontEnd::ASTFunctionDecl *);
+  void Visit(frontEnd::ASTIfStmt *);
+  void Visit(frontEnd::ASTIntegerLiteral *);
+  void Visit(frontEnd::ASTReturnStmt *);
+  void Visit(frontEnd::ASTStringLiteral *);
+  void Visit(frontEnd::ASTSymbol *);
+  void Visit(frontEnd::ASTUnaryOperator *);
+  void Visit(frontEnd::ASTVarDecl *);
+  void Visit(frontEnd::ASTWhileStmt *);
+
+  /// Check, that value of type From can be stored in variable of type To.
+  void CheckConversion(const frontEnd::ASTNode *At, frontEnd::TokenType From,
+                       frontEnd::TokenType To);
+
+  /// Check, that control flow statement can branch on condition.
+  void CheckCondition(const frontEnd::ASTNode *Condition);
+
+  /// Check, that expression is a variable, which operator can change.
+  bool CheckAssignable(const frontEnd::ASTNode *Operand);
+
+  void ReportError(const frontEnd::ASTNode *At, std::string Message);
+
+  frontEnd::ASTNode *Root;
+
+  /// Functions by name, collected before analysis, so function can be
+  /// called before its definition.
+  std::unordered_map<std::string_view, const frontEnd::ASTFunctionDecl *>
+      Functions;
+
+  /// Function, whose body is being analyzed.
+  const frontEnd::ASTFunctionDecl *CurrentFunction;
+
+  /// Types of variables by declaration index. Declaration is visited
+  /// before any symbol, resolved to it.
+  std::vector<frontEnd::TokenType> VariableTypes;
+
+  bool ErrorRecovery;
+
+  std::vector<SemanticDiagnostic> Diagnostics;
+};
+
+} // namespace middleEnd
+} // namespace weak
+
+#endif // WEAK_COMPILER_MIDDLE_END_ANALYSIS_SEMANTIC_ANALYZER_HPP
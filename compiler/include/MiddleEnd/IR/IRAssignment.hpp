@@ -15,14 +15,12 @@ namespace middleEnd {
 
 /// \brief Assignment instruction.
 ///
-/// Holds ownership of its variable (actually symbol).
+/// Views its variable (actually symbol) and operand.
 class IRAssignment : public IRNode {
 public:
   IRAssignment(frontEnd::ASTNode *TheVariable,
                frontEnd::ASTNode *TheOperandView);
 
-  ~IRAssignment();
-
   std::string Dump() const override;
 
   void Accept(IRVisitor *) override;
@@ -7,37 +7,28 @@
 #ifndef WEAK_COMPILER_MIDDLE_END_IR_IR_NODE_PRINTER_HPP
 #define WEAK_COMPILER_MIDDLE_END_IR_IR_NODE_PRINTER_HPP
 
-#include "FrontEnd/AST/ASTVisitor.hpp"
+#include "FrontEnd/AST/ASTNode.hpp"
 #include <iosfwd>
 
 namespace weak {
 namespace middleEnd {
 
-class IRNodePrinter : private frontEnd::ASTVisitor {
+/// Print expression in one line. Tree is walked without recursion, so
+/// long chains of operators can be printed.
+class IRNodePrinter {
 public:
   IRNodePrinter(frontEnd::ASTNode *TheRootNode, std::ostream &TheOutStream);
 
   void Print();
 
 private:
-  void Visit(const frontEnd::ASTBinaryOperator *) const override;
-  void Visit(const frontEnd::ASTBooleanLiteral *) const override;
-  void Visit(const frontEnd::ASTBreakStmt *) const override;
-  void Visit(const frontEnd::ASTCompoundStmt *) const override;
-  void Visit(const frontEnd::ASTContinueStmt *) const override;
-  void Visit(const frontEnd::ASTDoWhileStmt *) const override;
-  void Visit(const frontEnd::ASTFloatingPointLiteral *) const override;
-  void Visit(const frontEnd::ASTForStmt *) const override;
-  void Visit(const frontEnd::ASTFunctionDecl *) const override;
-  void Visit(const frontEnd::ASTFunctionCall *) const override;
-  void Visit(const frontEnd::ASTIfStmt *) const override;
-  void Visit(const frontEnd::ASTIntegerLiteral *) const override;
-  void Visit(const frontEnd::ASTReturnStmt *) const override;
-  void Visit(const frontEnd::ASTStringLiteral *) const override;
-  void Visit(const frontEnd::ASTSymbol *) const override;
-  void Visit(const frontEnd::ASTUnaryOperator *) const override;
-  void Visit(const frontEnd::ASTVarDecl *) const override;
-  void Visit(const frontEnd::ASTWhileStmt *) const override;
+  /// Print operand.
+  ///
+  /// \return false if node is not printed with its children.
+  bool Enter(const frontEnd::ASTNode *) const;
+
+  /// Print operator after operand. Parent is nullptr for root.
+  void Leave(const frontEnd::ASTNode *, const frontEnd::ASTNode *Parent) const;
 
   frontEnd::ASTNode *RootNode;
   std::ostream &OutStream;
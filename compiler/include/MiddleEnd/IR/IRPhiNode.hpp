@@ -17,19 +17,17 @@ namespace middleEnd {
 
 /// \brief Phi node.
 ///
-/// Views its CFG blocks, holds ownership of its symbols.
+/// Views its CFG blocks and symbols.
 class IRPhiNode : public IRNode {
 public:
-  IRPhiNode(std::unique_ptr<frontEnd::ASTSymbol> &&TheVariable,
+  IRPhiNode(frontEnd::ASTSymbol *TheVariable,
             std::map<CFGBlock *, frontEnd::ASTSymbol *> VarMap);
 
-  ~IRPhiNode() override;
-
   std::string Dump() const override;
 
   void Accept(IRVisitor *) override {}
 
-  std::unique_ptr<frontEnd::ASTSymbol> Variable;
+  frontEnd::ASTSymbol *Variable;
 
   std::map<CFGBlock *, frontEnd::ASTSymbol *> VariableMap;
 };
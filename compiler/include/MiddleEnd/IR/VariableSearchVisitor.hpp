@@ -7,7 +7,8 @@
 #ifndef WEAK_COMPILER_MIDDLE_END_IR_VARIABLE_SEARCH_VISITOR_HPP
 #define WEAK_COMPILER_MIDDLE_END_IR_VARIABLE_SEARCH_VISITOR_HPP
 
-#include "FrontEnd/AST/ASTVisitor.hpp"
+#include "FrontEnd/AST/ASTNode.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
 #include "MiddleEnd/IR/IRNode.hpp"
 #include "MiddleEnd/IR/IRVisitor.hpp"
 #include <set>
@@ -18,33 +19,18 @@ namespace middleEnd {
 /// \brief Helper to extract variables from AST.
 ///
 /// This simply walks through IR statements and return founded variables.
-class VariableSearchVisitor : private frontEnd::ASTVisitor, private IRVisitor {
+class VariableSearchVisitor : private IRVisitor {
 public:
   std::set<frontEnd::ASTSymbol *> AllVarsUsedInStatement(IRNode *);
 
 private:
-  void Visit(const frontEnd::ASTBooleanLiteral *) const override {}
-  void Visit(const frontEnd::ASTBreakStmt *) const override {}
-  void Visit(const frontEnd::ASTCompoundStmt *) const override {}
-  void Visit(const frontEnd::ASTContinueStmt *) const override {}
-  void Visit(const frontEnd::ASTDoWhileStmt *) const override {}
-  void Visit(const frontEnd::ASTFloatingPointLiteral *) const override {}
-  void Visit(const frontEnd::ASTForStmt *) const override {}
-  void Visit(const frontEnd::ASTFunctionDecl *) const override {}
-  void Visit(const frontEnd::ASTFunctionCall *) const override {}
-  void Visit(const frontEnd::ASTIfStmt *) const override {}
-  void Visit(const frontEnd::ASTIntegerLiteral *) const override {}
-  void Visit(const frontEnd::ASTReturnStmt *) const override {}
-  void Visit(const frontEnd::ASTStringLiteral *) const override {}
-  void Visit(const frontEnd::ASTUnaryOperator *) const override {}
-  void Visit(const frontEnd::ASTVarDecl *) const override {}
-  void Visit(const frontEnd::ASTWhileStmt *) const override {}
-
-  void Visit(const frontEnd::ASTSymbol *) const override;
-  void Visit(const frontEnd::ASTBinaryOperator *) const override;
   void Visit(const IRAssignment *) const override;
   void Visit(const IRBranch *) const override;
 
+  /// Walk through symbols and binary operators of expression without
+  /// recursion.
+  void Search(const frontEnd::ASTNode *) const;
+
   mutable std::set<frontEnd::ASTSymbol *> Variables;
 };
 
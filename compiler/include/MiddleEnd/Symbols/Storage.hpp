@@ -8,7 +8,11 @@
 #define WEAK_COMPILER_MIDDLE_END_SYMBOLS_STORAGE_HPP
 
 #include "FrontEnd/Lex/Token.hpp"
-#include <map>
+#include "Utility/StringInterner.hpp"
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
 
 namespace weak {
 namespace middleEnd {
@@ -33,40 +37,163 @@ private:
     /// This is used by IR generator.
     unsigned TemporaryLabel;
 
-    /// The name of variable.
-    std::string Name;
+    /// The name of variable, interned in \ref StringInterner::Global.
+    StringInterner::ID Name;
+
+    /// Attribute of variable with the same name, hidden by this one until
+    /// the end of scope, or \ref NoAttribute.
+    unsigned Shadowed;
+
+    /// Scope of variable has ended. Record is kept only to get its name
+    /// and type by attribute.
+    bool Closed;
 
     /// Data type of stored variable, used for type checking.
     frontEnd::TokenType DataType;
   };
 
-  using RecordMap = std::map</*Attribute=*/unsigned, Record>;
-
 public:
+  Storage();
+
   /// Open new scope.
   void ScopeBegin();
 
   /// Terminate scope and destroy all variables, presented inside it.
+  /// Takes time proportional to count of these variables.
   void ScopeEnd();
 
   /// Add record to table without specifying any information about type,
-  /// value etc.
+  /// value etc. Visible variable with the same name is returned instead of
+  /// new one, whatever scope it belongs to.
   unsigned AddSymbol(std::string_view Name);
 
-  /// Specify variable type.
+  /// Add declaration of variable to the current scope. Unlike
+  /// \ref AddSymbol, always creates new record, which shadows variable
+  /// with the same name from outer scope until the end of current scope.
+  ///
+  /// \return attribute of declaration, unique in this storage.
+  unsigned AddDeclaration(StringInterner::ID Name);
+
+  /// \return attribute of the innermost visible variable with given name
+  ///         or \ref NoAttribute.
+  unsigned Lookup(StringInterner::ID Name) const;
+
+  /// \return attribute, that will be given to the next added variable.
+  unsigned NextAttribute() const { return Records.size(); }
+
+  /// \return interned name of variable, used to create AST symbol
+  /// without hashing its text again.
+  StringInterner::ID GetSymbolName(unsigned Attribute) const;
+
+  /// Specify type of variable from open scope, even if it is shadowed.
   void SetSymbolType(unsigned Attribute, frontEnd::TokenType Type);
 
-  unsigned TotalVariables() { return Records.size(); }
+  /// \return type, given by \ref SetSymbolType, or NONE.
+  frontEnd::TokenType GetSymbolType(unsigned Attribute) const;
+
+  /// Add all symbols of other storage in order of their attributes, as if
+  /// they were added here directly. Used to combine storages filled
+  /// independently by different threads.
+  ///
+  /// \return table, that maps attribute in Other to attribute here.
+  std::vector<unsigned> MergeSymbols(const Storage &Other);
+
+  /// Take ownership of string literal, whose value differs from its source
+  /// text (e.g has escape sequences).
+  ///
+  /// \return index of literal, used as token payload. Index of removed
+  ///         literal may be given again.
+  unsigned AddStringLiteral(std::string &&Literal);
+
+  /// Free literal, which is not referred by any token anymore.
+  void RemoveStringLiteral(unsigned Index);
+
+  /// \return view of stored literal, valid until storage destruction.
+  std::string_view GetStringLiteral(unsigned Index) const;
+
+  /// Store decoded floating point literal, which does not fit in token.
+  ///
+  /// \return index of literal, used as token payload.
+  unsigned AddFloatingPointLiteral(double Value);
+
+  /// \see RemoveStringLiteral.
+  void RemoveFloatingPointLiteral(unsigned Index);
+
+  double GetFloatingPointLiteral(unsigned Index) const;
+
+  /// Indices of the first literals, merged from other storage.
+  struct LiteralOffsets {
+    unsigned StringLiteral;
+    unsigned FloatingPointLiteral;
+  };
+
+  /// Append all literals of other storage. Their indices are shifted by
+  /// the returned offsets.
+  LiteralOffsets MergeLiterals(const Storage &Other);
+
+  /// \return count of variables in open scopes.
+  unsigned TotalVariables() { return ScopeLog.size(); }
+
+  static constexpr unsigned NoAttribute = UINT32_MAX;
 
 private:
   friend class CodeGen;
 
+  unsigned AddInternedSymbol(StringInterner::ID Name);
+
   Record *GetSymbol(unsigned Attribute);
   Record *GetByName(std::string_view Name);
 
-  unsigned CurrentScopeDepth{0U};
-  unsigned CurrentAttribute{0U};
-  RecordMap Records;
+  /// Create record, visible until the end of current scope. Innermost is
+  /// entry of \ref Visible for the name.
+  unsigned AddRecord(StringInterner::ID Name, unsigned &Innermost);
+
+  /// Entry of \ref Visible.
+  struct VisibleName {
+    StringInterner::ID Name;
+    unsigned Attribute;
+  };
+
+  /// Name of free entry of \ref Visible.
+  static constexpr StringInterner::ID NoName = UINT32_MAX;
+
+  static std::size_t HashName(StringInterner::ID Name);
+
+  /// \return attribute of the innermost visible variable with given name,
+  ///         which is added as \ref NoAttribute if not found.
+  unsigned &GetVisible(StringInterner::ID Name);
+
+  /// All records ever added, indexed by attribute. Records of terminated
+  /// scopes are kept, so attributes are never reused.
+  std::vector<Record> Records;
+
+  /// Attributes of the innermost visible variables by interned name, in
+  /// hash table with linear probing. Only names, ever added to this
+  /// storage, are kept, so its size does not depend on count of all
+  /// interned names. Names without visible variables stay as
+  /// \ref NoAttribute.
+  std::vector<VisibleName> Visible;
+
+  /// Count of used entries of \ref Visible.
+  std::size_t VisibleNames;
+
+  /// Attributes of variables of open scopes in order of addition. Scope
+  /// end undoes additions, made since its beginning, and makes shadowed
+  /// variables visible again.
+  std::vector<unsigned> ScopeLog;
+
+  /// Size of \ref ScopeLog at the beginning of each open scope.
+  std::vector<std::size_t> ScopeStarts;
+
+  /// Deque guarantees that stored strings never move, so views to them
+  /// stay valid.
+  std::deque<std::string> StringLiterals;
+
+  std::vector<double> FloatingPointLiterals;
+
+  /// Indices of removed literals, reused by the next additions.
+  std::vector<unsigned> FreeStringLiterals;
+  std::vector<unsigned> FreeFloatingPointLiterals;
 };
 
 } // namespace middleEnd
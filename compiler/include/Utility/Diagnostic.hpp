@@ -35,6 +35,10 @@ OstreamRAII CompileError();
 /// Print diagnostic message with ERROR flag and terminate program.
 OstreamRAII CompileError(unsigned LineNo, unsigned ColumnNo);
 
+/// Print diagnostic message with ERROR flag and continue. Used to report
+/// errors, collected in error recovery mode.
+void PrintError(unsigned LineNo, unsigned ColumnNo, const char *Message);
+
 } // namespace weak
 
 #endif // WEAK_COMPILER_UTILITY_DIAGNOSTIC_HPP
\ No newline at end of file
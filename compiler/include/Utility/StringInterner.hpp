@@ -0,0 +1,116 @@
+/* StringInterner.hpp - Table of unique strings.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_UTILITY_STRING_INTERNER_HPP
+#define WEAK_COMPILER_UTILITY_STRING_INTERNER_HPP
+
+#include "Utility/Uncopyable.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace weak {
+
+/// \brief Table of unique strings.
+///
+/// Each distinct string is hashed and copied to arena once and gets 32-bit
+/// identifier, so equal strings are compared as integers. Identifiers are
+/// dense and given in order of first interning.
+///
+/// Interning is safe to call from different threads. Strings are split
+/// between shards by hash, each with its own lock, so threads interning
+/// different strings rarely wait for each other. Lookup of string by
+/// identifier takes no lock at all.
+class StringInterner : private Uncopyable {
+public:
+  using ID = std::uint32_t;
+
+  StringInterner();
+
+  ~StringInterner();
+
+  /// \return identifier of string, which is the same for all equal strings.
+  ID Intern(std::string_view String);
+
+  /// \return stored string, valid until interner destruction.
+  std::string_view GetString(ID Identifier) const;
+
+  /// \return count of distinct strings.
+  unsigned Size() const;
+
+  /// Interner for identifiers, shared by lexer, AST and IR. Lives until
+  /// program exit, so views to its strings are always valid.
+  static StringInterner &Global();
+
+private:
+  static constexpr ID EmptyBucket = UINT32_MAX;
+
+  /// Size of usual chunk. Longer strings get chunk of their own size.
+  static constexpr std::size_t ChunkSize = 64U * 1024U;
+
+  /// Low bits of hash are enough to filter out most of mismatches and to
+  /// place string when shard grows.
+  struct Bucket {
+    std::uint32_t Hash;
+    ID Identifier;
+  };
+
+  /// Part of table, that holds strings with the same high bits of hash.
+  struct Shard {
+    Shard();
+
+    /// \return identifier of stored string or \ref EmptyBucket. Index of
+    ///         the bucket, where probing stopped, is written to I.
+    ID Find(const StringInterner &Interner, std::string_view String,
+            std::uint32_t Hash, std::size_t &I) const;
+
+    /// Copy string to arena.
+    std::string_view Store(std::string_view String);
+
+    /// Double count of buckets and reinsert all strings.
+    void Grow();
+
+    std::vector<std::unique_ptr<char[]>> Chunks;
+    char *ChunkPtr;
+    char *ChunkEnd;
+
+    /// Open addressing with linear probing. Count of buckets is power of
+    /// two and at least twice the count of strings.
+    std::vector<Bucket> Buckets;
+    std::size_t Count;
+
+    mutable std::shared_mutex Lock;
+  };
+
+  /// Make string visible to \ref GetString.
+  void Publish(ID Identifier, std::string_view String);
+
+  static constexpr unsigned ShardBits = 4U;
+  static constexpr unsigned ShardsCount = 1U << ShardBits;
+
+  std::array<Shard, ShardsCount> Shards;
+
+  /// Strings, indexed by identifier, are kept in pages, which are never
+  /// moved, so readers do not race with growth. Page is allocated by the
+  /// first thread, that needs it.
+  static constexpr unsigned PageBits = 16U;
+  static constexpr std::size_t PageSize = std::size_t(1U) << PageBits;
+  static constexpr std::size_t PagesCount =
+      (std::size_t(UINT32_MAX) >> PageBits) + 1U;
+
+  std::unique_ptr<std::atomic<std::string_view *>[]> Pages;
+
+  std::atomic<ID> NextIdentifier;
+};
+
+} // namespace weak
+
+#endif // WEAK_COMPILER_UTILITY_STRING_INTERNER_HPP
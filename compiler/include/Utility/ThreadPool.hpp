@@ -0,0 +1,63 @@
+/* ThreadPool.hpp - Fixed-size pool of worker threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_UTILITY_THREAD_POOL_HPP
+#define WEAK_COMPILER_UTILITY_THREAD_POOL_HPP
+
+#include "Utility/Uncopyable.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace weak {
+
+/// \brief Pool of threads, executing tasks in order of submission.
+///
+/// Tasks are not allowed to submit other tasks and wait for them, since
+/// it can lead to deadlock if all workers are waiting.
+class ThreadPool : private Uncopyable {
+public:
+  /// Create pool of given size. Zero means the number of hardware threads.
+  explicit ThreadPool(unsigned TheThreads = 0U);
+
+  /// Wait for all submitted tasks and join workers.
+  ~ThreadPool();
+
+  /// Schedule task for execution.
+  void Submit(std::function<void()> Task);
+
+  /// Block until all submitted tasks are completed.
+  void Wait();
+
+  unsigned TotalThreads() const;
+
+private:
+  void WorkerLoop();
+
+  std::vector<std::thread> Workers;
+
+  std::deque<std::function<void()>> Tasks;
+
+  std::mutex Mutex;
+
+  /// Signalled when new task is submitted or pool is stopping.
+  std::condition_variable TaskAvailable;
+
+  /// Signalled when the last running task is completed.
+  std::condition_variable TasksDone;
+
+  /// Submitted, but not yet completed tasks.
+  unsigned PendingTasks{0U};
+
+  bool Stopping{false};
+};
+
+} // namespace weak
+
+#endif // WEAK_COMPILER_UTILITY_THREAD_POOL_HPP
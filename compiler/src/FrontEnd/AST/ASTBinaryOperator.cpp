@@ -10,14 +10,11 @@
 namespace weak {
 namespace frontEnd {
 
-ASTBinaryOperator::ASTBinaryOperator(TokenType TheOperation,
-                                     std::unique_ptr<ASTNode> &&TheLHS,
-                                     std::unique_ptr<ASTNode> &&TheRHS,
-                                     unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Operation(TheOperation),
-      LHS(std::move(TheLHS)), RHS(std::move(TheRHS)) {}
-
-ASTType ASTBinaryOperator::GetASTType() const { return ASTType::BINARY; }
+ASTBinaryOperator::ASTBinaryOperator(TokenType TheOperation, ASTNode *TheLHS,
+                                     ASTNode *TheRHS, unsigned TheLineNo,
+                                     unsigned TheColumnNo)
+    : ASTNode(ASTType::BINARY, TheLineNo, TheColumnNo), Operation(TheOperation),
+      LHS(TheLHS), RHS(TheRHS) {}
 
 void ASTBinaryOperator::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -25,12 +22,9 @@ void ASTBinaryOperator::Accept(const ASTVisitor *Visitor) const {
 
 TokenType ASTBinaryOperator::GetOperation() const { return Operation; }
 
-const std::unique_ptr<ASTNode> &ASTBinaryOperator::GetLHS() const {
-  return LHS;
-}
-const std::unique_ptr<ASTNode> &ASTBinaryOperator::GetRHS() const {
-  return RHS;
-}
+ASTNode *ASTBinaryOperator::GetLHS() const { return LHS; }
+
+ASTNode *ASTBinaryOperator::GetRHS() const { return RHS; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
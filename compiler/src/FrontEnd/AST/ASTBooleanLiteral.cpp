@@ -12,11 +12,8 @@ namespace frontEnd {
 
 ASTBooleanLiteral::ASTBooleanLiteral(bool TheValue, unsigned TheLineNo,
                                      unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Value(TheValue) {}
-
-ASTType ASTBooleanLiteral::GetASTType() const {
-  return ASTType::BOOLEAN_LITERAL;
-}
+    : ASTNode(ASTType::BOOLEAN_LITERAL, TheLineNo, TheColumnNo),
+      Value(TheValue) {}
 
 void ASTBooleanLiteral::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -11,9 +11,7 @@ namespace weak {
 namespace frontEnd {
 
 ASTBreakStmt::ASTBreakStmt(unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo) {}
-
-ASTType ASTBreakStmt::GetASTType() const { return ASTType::BREAK_STMT; }
+    : ASTNode(ASTType::BREAK_STMT, TheLineNo, TheColumnNo) {}
 
 void ASTBreakStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -10,23 +10,16 @@
 namespace weak {
 namespace frontEnd {
 
-ASTCompoundStmt::ASTCompoundStmt(std::vector<std::unique_ptr<ASTNode>> &&stmts,
-                                 unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Stmts(std::move(stmts)) {}
-
-ASTType ASTCompoundStmt::GetASTType() const { return ASTType::COMPOUND_STMT; }
+ASTCompoundStmt::ASTCompoundStmt(ASTNodeList TheStmts, unsigned TheLineNo,
+                                 unsigned TheColumnNo)
+    : ASTNode(ASTType::COMPOUND_STMT, TheLineNo, TheColumnNo),
+      Stmts(TheStmts) {}
 
 void ASTCompoundStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-std::vector<std::unique_ptr<ASTNode>> &&ASTCompoundStmt::GetStmts() {
-  return std::move(Stmts);
-}
-
-const std::vector<std::unique_ptr<ASTNode>> &ASTCompoundStmt::GetStmts() const {
-  return Stmts;
-}
+ASTNodeList ASTCompoundStmt::GetStmts() const { return Stmts; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
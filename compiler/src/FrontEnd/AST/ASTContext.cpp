@@ -0,0 +1,61 @@
+/* ASTContext.cpp - Owner of all AST nodes of translation unit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/ASTContext.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace weak {
+namespace frontEnd {
+
+ASTContext::ASTContext()
+    : Slabs(), SlabPtr(nullptr), SlabEnd(nullptr), BytesAllocated(0U) {}
+
+std::string_view ASTContext::MakeString(std::string_view String) {
+  if (String.empty())
+    return {};
+  char *Memory = static_cast<char *>(Allocate(String.size(), alignof(char)));
+  std::memcpy(Memory, String.data(), String.size());
+  return {Memory, String.size()};
+}
+
+ASTNodeList ASTContext::MakeList(const std::vector<ASTNode *> &Nodes) {
+  if (Nodes.empty())
+    return {};
+  void *Memory = Allocate(Nodes.size() * sizeof(ASTNode *), alignof(ASTNode *));
+  auto **Data = static_cast<ASTNode **>(Memory);
+  std::copy(Nodes.begin(), Nodes.end(), Data);
+  return {Data, static_cast<unsigned>(Nodes.size())};
+}
+
+void ASTContext::Adopt(ASTContext &Other) {
+  /// Slabs are only moved between owners, current slab of this context
+  /// stays the same.
+  Slabs.insert(Slabs.end(), std::make_move_iterator(Other.Slabs.begin()),
+               std::make_move_iterator(Other.Slabs.end()));
+  BytesAllocated += Other.BytesAllocated;
+  Other.Slabs.clear();
+  Other.SlabPtr = nullptr;
+  Other.SlabEnd = nullptr;
+  Other.BytesAllocated = 0U;
+}
+
+std::size_t ASTContext::TotalSlabs() const { return Slabs.size(); }
+
+std::size_t ASTContext::TotalAllocated() const { return BytesAllocated; }
+
+void *ASTContext::AllocateSlow(std::size_t Size, std::size_t Align) {
+  std::size_t NewSlabSize = std::max(SlabSize, Size + Align);
+  /// Not value-initialized, memory is always written before use.
+  Slabs.emplace_back(new char[NewSlabSize]);
+  SlabPtr = Slabs.back().get();
+  SlabEnd = SlabPtr + NewSlabSize;
+  return Allocate(Size, Align);
+}
+
+} // namespace frontEnd
+} // namespace weak
@@ -11,9 +11,7 @@ namespace weak {
 namespace frontEnd {
 
 ASTContinueStmt::ASTContinueStmt(unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo) {}
-
-ASTType ASTContinueStmt::GetASTType() const { return ASTType::CONTINUE_STMT; }
+    : ASTNode(ASTType::CONTINUE_STMT, TheLineNo, TheColumnNo) {}
 
 void ASTContinueStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
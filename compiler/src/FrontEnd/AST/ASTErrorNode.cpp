@@ -0,0 +1,21 @@
+/* ASTErrorNode.cpp - AST node in place of malformed code.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/ASTErrorNode.hpp"
+#include "FrontEnd/AST/ASTVisitor.hpp"
+
+namespace weak {
+namespace frontEnd {
+
+ASTErrorNode::ASTErrorNode(unsigned TheLineNo, unsigned TheColumnNo)
+    : ASTNode(ASTType::ERROR_NODE, TheLineNo, TheColumnNo) {}
+
+void ASTErrorNode::Accept(const ASTVisitor *Visitor) const {
+  Visitor->Visit(this);
+}
+
+} // namespace frontEnd
+} // namespace weak
\ No newline at end of file
@@ -13,11 +13,8 @@ namespace frontEnd {
 ASTFloatingPointLiteral::ASTFloatingPointLiteral(double TheValue,
                                                  unsigned TheLineNo,
                                                  unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Value(TheValue) {}
-
-ASTType ASTFloatingPointLiteral::GetASTType() const {
-  return ASTType::FLOATING_POINT_LITERAL;
-}
+    : ASTNode(ASTType::FLOATING_POINT_LITERAL, TheLineNo, TheColumnNo),
+      Value(TheValue) {}
 
 void ASTFloatingPointLiteral::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -10,48 +10,23 @@
 namespace weak {
 namespace frontEnd {
 
-ASTForStmt::ASTForStmt(std::unique_ptr<ASTNode> &&TheInit,
-                       std::unique_ptr<ASTNode> &&TheCondition,
-                       std::unique_ptr<ASTNode> &&TheIncrement,
-                       std::unique_ptr<ASTCompoundStmt> &&TheBody,
+ASTForStmt::ASTForStmt(ASTNode *TheInit, ASTNode *TheCondition,
+                       ASTNode *TheIncrement, ASTCompoundStmt *TheBody,
                        unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Init(std::move(TheInit)),
-      Condition(std::move(TheCondition)), Increment(std::move(TheIncrement)),
-      Body(std::move(TheBody)) {}
-
-ASTType ASTForStmt::GetASTType() const { return ASTType::FOR_STMT; }
+    : ASTNode(ASTType::FOR_STMT, TheLineNo, TheColumnNo), Init(TheInit),
+      Condition(TheCondition), Increment(TheIncrement), Body(TheBody) {}
 
 void ASTForStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-std::unique_ptr<ASTNode> &&ASTForStmt::GetInit() { return std::move(Init); }
-
-const std::unique_ptr<ASTNode> &ASTForStmt::GetInit() const { return Init; }
-
-std::unique_ptr<ASTNode> &&ASTForStmt::GetCondition() {
-  return std::move(Condition);
-}
+ASTNode *ASTForStmt::GetInit() const { return Init; }
 
-const std::unique_ptr<ASTNode> &ASTForStmt::GetCondition() const {
-  return Condition;
-}
+ASTNode *ASTForStmt::GetCondition() const { return Condition; }
 
-std::unique_ptr<ASTNode> &&ASTForStmt::GetIncrement() {
-  return std::move(Increment);
-}
+ASTNode *ASTForStmt::GetIncrement() const { return Increment; }
 
-const std::unique_ptr<ASTNode> &ASTForStmt::GetIncrement() const {
-  return Increment;
-}
-
-std::unique_ptr<ASTCompoundStmt> &&ASTForStmt::GetBody() {
-  return std::move(Body);
-}
-
-const std::unique_ptr<ASTCompoundStmt> &ASTForStmt::GetBody() const {
-  return Body;
-}
+ASTCompoundStmt *ASTForStmt::GetBody() const { return Body; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
@@ -10,24 +10,19 @@
 namespace weak {
 namespace frontEnd {
 
-ASTFunctionCall::ASTFunctionCall(
-    std::string &&TheName, std::vector<std::unique_ptr<ASTNode>> &&TheArguments,
-    unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Name(std::move(TheName)),
-      Arguments(std::move(TheArguments)) {}
-
-ASTType ASTFunctionCall::GetASTType() const { return ASTType::FUNCTION_CALL; }
+ASTFunctionCall::ASTFunctionCall(std::string_view TheName,
+                                 ASTNodeList TheArguments, unsigned TheLineNo,
+                                 unsigned TheColumnNo)
+    : ASTNode(ASTType::FUNCTION_CALL, TheLineNo, TheColumnNo), Name(TheName),
+      Arguments(TheArguments) {}
 
 void ASTFunctionCall::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-const std::string &ASTFunctionCall::GetName() const { return Name; }
+std::string_view ASTFunctionCall::GetName() const { return Name; }
 
-const std::vector<std::unique_ptr<ASTNode>> &
-ASTFunctionCall::GetArguments() const {
-  return Arguments;
-}
+ASTNodeList ASTFunctionCall::GetArguments() const { return Arguments; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
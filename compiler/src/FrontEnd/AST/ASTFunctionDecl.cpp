@@ -11,16 +11,14 @@
 namespace weak {
 namespace frontEnd {
 
-ASTFunctionDecl::ASTFunctionDecl(
-    TokenType TheReturnType, std::string &&TheName,
-    std::vector<std::unique_ptr<ASTNode>> &&TheArguments,
-    std::unique_ptr<ASTCompoundStmt> &&TheBody, unsigned TheLineNo,
-    unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), ReturnType(TheReturnType),
-      Name(std::move(TheName)), Arguments(std::move(TheArguments)),
-      Body(std::move(TheBody)) {}
-
-ASTType ASTFunctionDecl::GetASTType() const { return ASTType::FUNCTION_DECL; }
+ASTFunctionDecl::ASTFunctionDecl(TokenType TheReturnType,
+                                 std::string_view TheName,
+                                 ASTNodeList TheArguments,
+                                 ASTCompoundStmt *TheBody, unsigned TheLineNo,
+                                 unsigned TheColumnNo)
+    : ASTNode(ASTType::FUNCTION_DECL, TheLineNo, TheColumnNo),
+      ReturnType(TheReturnType), Name(TheName), Arguments(TheArguments),
+      Body(TheBody) {}
 
 void ASTFunctionDecl::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -28,24 +26,11 @@ void ASTFunctionDecl::Accept(const ASTVisitor *Visitor) const {
 
 TokenType ASTFunctionDecl::GetReturnType() const { return ReturnType; }
 
-const std::string &ASTFunctionDecl::GetName() const { return Name; }
-
-std::vector<std::unique_ptr<ASTNode>> &&ASTFunctionDecl::GetArguments() {
-  return std::move(Arguments);
-}
+std::string_view ASTFunctionDecl::GetName() const { return Name; }
 
-const std::vector<std::unique_ptr<ASTNode>> &
-ASTFunctionDecl::GetArguments() const {
-  return Arguments;
-}
+ASTNodeList ASTFunctionDecl::GetArguments() const { return Arguments; }
 
-std::unique_ptr<ASTCompoundStmt> &&ASTFunctionDecl::GetBody() {
-  return std::move(Body);
-}
-
-const std::unique_ptr<ASTCompoundStmt> &ASTFunctionDecl::GetBody() const {
-  return Body;
-}
+ASTCompoundStmt *ASTFunctionDecl::GetBody() const { return Body; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
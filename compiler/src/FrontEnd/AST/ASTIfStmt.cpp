@@ -10,42 +10,21 @@
 namespace weak {
 namespace frontEnd {
 
-ASTIfStmt::ASTIfStmt(std::unique_ptr<ASTNode> &&TheCondition,
-                     std::unique_ptr<ASTCompoundStmt> &&TheThenBody,
-                     std::unique_ptr<ASTCompoundStmt> &&TheElseBody,
-                     unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Condition(std::move(TheCondition)),
-      ThenBody(std::move(TheThenBody)), ElseBody(std::move(TheElseBody)) {}
-
-ASTType ASTIfStmt::GetASTType() const { return ASTType::IF_STMT; }
+ASTIfStmt::ASTIfStmt(ASTNode *TheCondition, ASTCompoundStmt *TheThenBody,
+                     ASTCompoundStmt *TheElseBody, unsigned TheLineNo,
+                     unsigned TheColumnNo)
+    : ASTNode(ASTType::IF_STMT, TheLineNo, TheColumnNo),
+      Condition(TheCondition), ThenBody(TheThenBody), ElseBody(TheElseBody) {}
 
 void ASTIfStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-std::unique_ptr<ASTNode> &&ASTIfStmt::GetCondition() {
-  return std::move(Condition);
-}
-
-const std::unique_ptr<ASTNode> &ASTIfStmt::GetCondition() const {
-  return Condition;
-}
-
-std::unique_ptr<ASTCompoundStmt> &&ASTIfStmt::GetThenBody() {
-  return std::move(ThenBody);
-}
+ASTNode *ASTIfStmt::GetCondition() const { return Condition; }
 
-const std::unique_ptr<ASTCompoundStmt> &ASTIfStmt::GetThenBody() const {
-  return ThenBody;
-}
+ASTCompoundStmt *ASTIfStmt::GetThenBody() const { return ThenBody; }
 
-std::unique_ptr<ASTCompoundStmt> &&ASTIfStmt::GetElseBody() {
-  return std::move(ElseBody);
-}
-
-const std::unique_ptr<ASTCompoundStmt> &ASTIfStmt::GetElseBody() const {
-  return ElseBody;
-}
+ASTCompoundStmt *ASTIfStmt::GetElseBody() const { return ElseBody; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
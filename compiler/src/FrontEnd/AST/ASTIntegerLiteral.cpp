@@ -12,11 +12,8 @@ namespace frontEnd {
 
 ASTIntegerLiteral::ASTIntegerLiteral(signed TheValue, unsigned TheLineNo,
                                      unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Value(TheValue) {}
-
-ASTType ASTIntegerLiteral::GetASTType() const {
-  return ASTType::INTEGER_LITERAL;
-}
+    : ASTNode(ASTType::INTEGER_LITERAL, TheLineNo, TheColumnNo),
+      Value(TheValue) {}
 
 void ASTIntegerLiteral::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
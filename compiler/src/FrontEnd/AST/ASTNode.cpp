@@ -9,14 +9,15 @@
 namespace weak {
 namespace frontEnd {
 
-ASTNode::ASTNode(unsigned TheLineNo, unsigned TheColumnNo)
-    : LineNo(TheLineNo), ColumnNo(TheColumnNo) {}
-
-ASTType ASTNode::GetASTType() const { return ASTType::BASE_NODE; }
+ASTNode::ASTNode(ASTType TheType, unsigned TheLineNo, unsigned TheColumnNo)
+    : Type(TheType), LineNo(TheLineNo), ColumnNo(TheColumnNo),
+      ExprType(TokenType::NONE) {}
 
 unsigned ASTNode::GetLineNo() const { return LineNo; }
 
 unsigned ASTNode::GetColumnNo() const { return ColumnNo; }
 
+void ASTNode::SetLineNo(unsigned TheLineNo) { LineNo = TheLineNo; }
+
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "FrontEnd/AST/ASTCompoundStmt.hpp"
 #include "FrontEnd/AST/ASTContinueStmt.hpp"
 #include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTErrorNode.hpp"
 #include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
 #include "FrontEnd/AST/ASTForStmt.hpp"
 #include "FrontEnd/AST/ASTFunctionCall.hpp"
@@ -21,322 +22,458 @@
 #include "FrontEnd/AST/ASTReturnStmt.hpp"
 #include "FrontEnd/AST/ASTStringLiteral.hpp"
 #include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTTraversal.hpp"
 #include "FrontEnd/AST/ASTUnaryOperator.hpp"
 #include "FrontEnd/AST/ASTVarDecl.hpp"
-#include "FrontEnd/AST/ASTVisitor.hpp"
 #include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include "FrontEnd/AST/FlatAST.hpp"
 #include <iostream>
 
 using namespace weak::frontEnd;
 
 namespace {
 
-class ASTPrintVisitor : public ASTVisitor {
+/// Print tree with \ref ASTWalker, so deeply nested input does not
+/// overflow the stack. Parent prints label and indent of its child, when
+/// child is entered.
+class ASTPrinter {
 public:
-  ASTPrintVisitor(ASTNode *TheRootNode, std::ostream &TheOutStream)
+  ASTPrinter(const ASTNode *TheRootNode, std::ostream &TheOutStream)
       : RootNode(TheRootNode), Indent(0U), OutStream(TheOutStream) {}
 
-  void Print() { RootNode->Accept(this); }
-
-private:
-  void Visit(const ASTBinaryOperator *Binary) const override {
-    PrintWithTextPosition("BinaryOperator", Binary, /*NewLineNeeded=*/false);
-    OutStream << TokenToString(Binary->GetOperation()) << std::endl;
-    Indent += 2;
-
-    PrintIndent();
-    Binary->GetLHS()->Accept(this);
-
-    PrintIndent();
-    Binary->GetRHS()->Accept(this);
-
-    Indent -= 2;
-  }
-
-  void Visit(const ASTBooleanLiteral *Boolean) const override {
-    PrintWithTextPosition("BooleanLiteral", Boolean, /*NewLineNeeded=*/false);
-    OutStream << std::boolalpha << Boolean->GetValue() << std::endl;
-  }
-
-  void Visit(const ASTBreakStmt *BreakStmt) const override {
-    PrintWithTextPosition("BreakStmt", BreakStmt, /*NewLineNeeded=*/true);
-  }
-
-  void Visit(const ASTCompoundStmt *CompoundStmt) const override {
-    PrintWithTextPosition("CompoundStmt", CompoundStmt, /*NewLineNeeded=*/true);
-
-    Indent += 2;
-    for (const auto &Stmt : CompoundStmt->GetStmts()) {
-      PrintIndent();
-      Stmt->Accept(this);
+  void Print() {
+    for (ASTWalker Walker(RootNode); Walker.Next();) {
+      const ASTNode *Node = Walker.GetNode();
+      const ASTNode *Parent = Walker.GetParent();
+      if (Walker.IsLeaving()) {
+        Leave(Node);
+        if (Parent && GetChildLabel(Parent, Node))
+          Indent -= 2;
+        continue;
+      }
+      if (Parent)
+        EnterChild(Parent, Node);
+      Enter(Node);
     }
-    Indent -= 2;
-  }
-
-  void Visit(const ASTContinueStmt *ContinueStmt) const override {
-    PrintWithTextPosition("ContinueStmt", ContinueStmt, /*NewLineNeeded=*/true);
   }
 
-  void Visit(const ASTFloatingPointLiteral *Float) const override {
-    PrintWithTextPosition("FloatingPointLiteral", Float,
-                          /*NewLineNeeded=*/false);
-    OutStream << Float->GetValue() << std::endl;
+private:
+  /// \return label, printed before child of statement, or nullptr if
+  /// child is printed without label.
+  static const char *GetChildLabel(const ASTNode *Parent,
+                                   const ASTNode *Child) {
+    switch (Parent->GetASTType()) {
+    case ASTType::FOR_STMT: {
+      const auto *For = static_cast<const ASTForStmt *>(Parent);
+      if (Child == For->GetInit())
+        return "ForStmtInit";
+      if (Child == For->GetCondition())
+        return "ForStmtCondition";
+      if (Child == For->GetIncrement())
+        return "ForStmtIncrement";
+      return "ForStmtBody";
+    }
+    case ASTType::IF_STMT: {
+      const auto *If = static_cast<const ASTIfStmt *>(Parent);
+      if (Child == If->GetCondition())
+        return "IfStmtCondition";
+      if (Child == If->GetThenBody())
+        return "IfStmtThenBody";
+      return "IfStmtElseBody";
+    }
+    case ASTType::WHILE_STMT:
+      return Child == static_cast<const ASTWhileStmt *>(Parent)->GetBody()
+                 ? "WhileStmtBody"
+                 : "WhileStmtCond";
+    case ASTType::DO_WHILE_STMT:
+      return Child == static_cast<const ASTDoWhileStmt *>(Parent)->GetBody()
+                 ? "DoWhileStmtBody"
+                 : "DoWhileStmtCond";
+    default:
+      return nullptr;
+    }
   }
 
-  void Visit(const ASTForStmt *ForStmt) const override {
-    PrintWithTextPosition("ForStmt", ForStmt,
-                          /*NewLineNeeded=*/true);
-
-    Indent += 2;
-
-    if (const auto *Init = ForStmt->GetInit().get()) {
+  void EnterChild(const ASTNode *Parent, const ASTNode *Child) {
+    if (const char *Label = GetChildLabel(Parent, Child)) {
       PrintIndent();
-      PrintWithTextPosition("ForStmtInit", Init,
-                            /*NewLineNeeded=*/true);
+      PrintWithTextPosition(Label, Child, /*NewLineNeeded=*/true);
       Indent += 2;
-      PrintIndent();
-      Init->Accept(this);
+    } else if (Parent->GetASTType() == ASTType::FUNCTION_DECL &&
+               Child == static_cast<const ASTFunctionDecl *>(Parent)
+                            ->GetBody()) {
       Indent -= 2;
-    }
-
-    if (const auto *Condition = ForStmt->GetCondition().get()) {
       PrintIndent();
-      PrintWithTextPosition("ForStmtCondition", Condition,
-                            /*NewLineNeeded=*/true);
+      PrintWithTextPosition("FunctionBody", Parent, /*NewLineNeeded=*/true);
       Indent += 2;
-      PrintIndent();
-      Condition->Accept(this);
-      Indent -= 2;
     }
+    PrintIndent();
+  }
 
-    if (const auto *Increment = ForStmt->GetIncrement().get()) {
-      PrintIndent();
-      PrintWithTextPosition("ForStmtIncrement", Increment,
-                            /*NewLineNeeded=*/true);
+  void Enter(const ASTNode *Node) {
+    switch (Node->GetASTType()) {
+    case ASTType::BINARY:
+      PrintWithTextPosition("BinaryOperator", Node, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(
+                       static_cast<const ASTBinaryOperator *>(Node)
+                           ->GetOperation())
+                << std::endl;
       Indent += 2;
-      PrintIndent();
-      Increment->Accept(this);
-      Indent -= 2;
+      break;
+    case ASTType::BOOLEAN_LITERAL:
+      PrintWithTextPosition("BooleanLiteral", Node, /*NewLineNeeded=*/false);
+      OutStream << std::boolalpha
+                << static_cast<const ASTBooleanLiteral *>(Node)->GetValue()
+                << std::endl;
+      break;
+    case ASTType::BREAK_STMT:
+      PrintWithTextPosition("BreakStmt", Node, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::COMPOUND_STMT:
+      PrintWithTextPosition("CompoundStmt", Node, /*NewLineNeeded=*/true);
+      Indent += 2;
+      break;
+    case ASTType::CONTINUE_STMT:
+      PrintWithTextPosition("ContinueStmt", Node, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::ERROR_NODE:
+      PrintWithTextPosition("ErrorNode", Node, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::FLOATING_POINT_LITERAL:
+      PrintWithTextPosition("FloatingPointLiteral", Node,
+                            /*NewLineNeeded=*/false);
+      OutStream << static_cast<const ASTFloatingPointLiteral *>(Node)
+                       ->GetValue()
+                << std::endl;
+      break;
+    case ASTType::FOR_STMT:
+      PrintWithTextPosition("ForStmt", Node, /*NewLineNeeded=*/true);
+      Indent += 2;
+      break;
+    case ASTType::IF_STMT:
+      PrintWithTextPosition("IfStmt", Node, /*NewLineNeeded=*/true);
+      Indent += 2;
+      break;
+    case ASTType::INTEGER_LITERAL:
+      PrintWithTextPosition("IntegerLiteral", Node, /*NewLineNeeded=*/false);
+      OutStream << static_cast<const ASTIntegerLiteral *>(Node)->GetValue()
+                << std::endl;
+      break;
+    case ASTType::RETURN_STMT:
+      PrintWithTextPosition("ReturnStmt", Node, /*NewLineNeeded=*/true);
+      Indent += 2;
+      break;
+    case ASTType::STRING_LITERAL:
+      PrintWithTextPosition("StringLiteral", Node, /*NewLineNeeded=*/false);
+      OutStream << static_cast<const ASTStringLiteral *>(Node)->GetValue()
+                << std::endl;
+      break;
+    case ASTType::SYMBOL:
+      PrintWithTextPosition("Symbol", Node, /*NewLineNeeded=*/false);
+      OutStream << static_cast<const ASTSymbol *>(Node)->GetName()
+                << std::endl;
+      break;
+    case ASTType::PREFIX_UNARY:
+    case ASTType::POSTFIX_UNARY: {
+      const auto *Unary = static_cast<const ASTUnaryOperator *>(Node);
+      OutStream << (Unary->PrefixOrPostfix ==
+                            ASTUnaryOperator::UnaryType::PREFIX
+                        ? "Prefix "
+                        : "Postfix ");
+      PrintWithTextPosition("UnaryOperator", Unary, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(Unary->GetOperation()) << std::endl;
+      Indent += 2;
+      break;
     }
-
-    if (const auto *Body = ForStmt->GetBody().get()) {
-      PrintIndent();
-      PrintWithTextPosition("ForStmtBody", Body,
-                            /*NewLineNeeded=*/true);
+    case ASTType::VAR_DECL: {
+      const auto *VarDecl = static_cast<const ASTVarDecl *>(Node);
+      PrintWithTextPosition("VarDeclStmt", VarDecl, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(VarDecl->GetDataType()) << " "
+                << VarDecl->GetSymbolName() << std::endl;
       Indent += 2;
-      PrintIndent();
-      Visit(Body);
-      Indent -= 2;
+      break;
     }
+    case ASTType::FUNCTION_DECL: {
+      const auto *FunctionDecl = static_cast<const ASTFunctionDecl *>(Node);
+      PrintWithTextPosition("FunctionDecl", FunctionDecl,
+                            /*NewLineNeeded=*/true);
 
-    Indent -= 2;
-  }
+      Indent += 2;
+      PrintIndent();
+      PrintWithTextPosition("FunctionRetType", FunctionDecl,
+                            /*NewLineNeeded=*/false);
+      OutStream << TokenToString(FunctionDecl->GetReturnType()) << std::endl;
 
-  void Visit(const ASTIfStmt *IfStmt) const override {
-    PrintWithTextPosition("IfStmt", IfStmt, /*NewLineNeeded=*/true);
-    Indent += 2;
+      PrintIndent();
+      PrintWithTextPosition("FunctionName", FunctionDecl,
+                            /*NewLineNeeded=*/false);
+      OutStream << FunctionDecl->GetName() << std::endl;
 
-    if (const auto &Condition = IfStmt->GetCondition()) {
       PrintIndent();
-      PrintWithTextPosition("IfStmtCondition", Condition.get(),
+      PrintWithTextPosition("FunctionArgs", FunctionDecl,
                             /*NewLineNeeded=*/true);
+      /// Arguments. Body decreases it, when entered.
       Indent += 2;
-      PrintIndent();
-      Condition->Accept(this);
-      Indent -= 2;
+      break;
     }
+    case ASTType::FUNCTION_CALL: {
+      const auto *FunctionCall = static_cast<const ASTFunctionCall *>(Node);
+      PrintWithTextPosition("FunctionCall", FunctionCall,
+                            /*NewLineNeeded=*/false);
+      OutStream << FunctionCall->GetName() << std::endl;
 
-    if (const auto &ThenBody = IfStmt->GetThenBody()) {
+      Indent += 2;
       PrintIndent();
-      PrintWithTextPosition("IfStmtThenBody", ThenBody.get(),
+      PrintWithTextPosition("FunctionArgs", FunctionCall,
                             /*NewLineNeeded=*/true);
       Indent += 2;
-      PrintIndent();
-      Visit(ThenBody.get());
-      Indent -= 2;
+      break;
     }
-
-    if (const auto &ElseBody = IfStmt->GetElseBody()) {
-      PrintIndent();
-      PrintWithTextPosition("IfStmtElseBody", ElseBody.get(),
-                            /*NewLineNeeded=*/true);
+    case ASTType::DO_WHILE_STMT:
+      PrintWithTextPosition("DoWhileStmt", Node, /*NewLineNeeded=*/true);
       Indent += 2;
-      PrintIndent();
-      Visit(ElseBody.get());
-      Indent -= 2;
+      break;
+    case ASTType::WHILE_STMT:
+      PrintWithTextPosition("WhileStmt", Node, /*NewLineNeeded=*/true);
+      Indent += 2;
+      break;
+    default:
+      break;
     }
-    Indent -= 2;
   }
 
-  void Visit(const ASTIntegerLiteral *Integer) const override {
-    PrintWithTextPosition("IntegerLiteral", Integer,
-                          /*NewLineNeeded*/ false);
-    OutStream << Integer->GetValue() << std::endl;
+  /// Restore indent, changed by \ref Enter.
+  void Leave(const ASTNode *Node) {
+    switch (Node->GetASTType()) {
+    case ASTType::BINARY:
+    case ASTType::COMPOUND_STMT:
+    case ASTType::FOR_STMT:
+    case ASTType::IF_STMT:
+    case ASTType::RETURN_STMT:
+    case ASTType::PREFIX_UNARY:
+    case ASTType::POSTFIX_UNARY:
+    case ASTType::VAR_DECL:
+    case ASTType::DO_WHILE_STMT:
+    case ASTType::WHILE_STMT:
+      Indent -= 2;
+      break;
+    case ASTType::FUNCTION_DECL:
+      /// Only indent of body is restored, so everything printed after
+      /// function is shifted right.
+      Indent -= 2;
+      break;
+    case ASTType::FUNCTION_CALL:
+      Indent -= 4;
+      break;
+    default:
+      break;
+    }
   }
 
-  void Visit(const ASTReturnStmt *ReturnStmt) const override {
-    PrintWithTextPosition("ReturnStmt", ReturnStmt, /*NewLineNeeded=*/true);
-    Indent += 2;
-
-    if (ReturnStmt->GetOperand()) {
-      PrintIndent();
-      ReturnStmt->GetOperand()->Accept(this);
-    }
+  void PrintWithTextPosition(std::string_view Label, const ASTNode *Node,
+                             bool NewLineNeeded) const {
+    OutStream << Label << " <line:" << Node->GetLineNo()
+              << ", col:" << Node->GetColumnNo() << ">";
 
-    Indent -= 2;
+    if (NewLineNeeded)
+      OutStream << std::endl;
+    else
+      OutStream << " ";
   }
 
-  void Visit(const ASTStringLiteral *String) const override {
-    PrintWithTextPosition("StringLiteral", String,
-                          /*NewLineNeeded=*/false);
-    OutStream << String->GetValue() << std::endl;
-  }
+  void PrintIndent() const { OutStream << std::string(Indent, ' '); }
 
-  void Visit(const ASTSymbol *Symbol) const override {
-    PrintWithTextPosition("Symbol", Symbol,
-                          /*NewLineNeeded=*/false);
-    OutStream << Symbol->GetName() << std::endl;
-  }
+  const ASTNode *RootNode;
+  unsigned Indent;
+  std::ostream &OutStream;
+};
 
-  void Visit(const ASTUnaryOperator *Unary) const override {
-    OutStream << (Unary->PrefixOrPostfix == ASTUnaryOperator::UnaryType::PREFIX
-                      ? "Prefix "
-                      : "Postfix ");
-    PrintWithTextPosition("UnaryOperator", Unary,
-                          /*NewLineNeeded=*/false);
-    OutStream << TokenToString(Unary->GetOperation()) << std::endl;
-    Indent += 2;
+/// The same output as of \ref ASTPrinter, made from flat AST.
+class FlatASTPrinter {
+public:
+  FlatASTPrinter(const FlatAST &TheAST, std::ostream &TheOutStream)
+      : AST(TheAST), Indent(0U), OutStream(TheOutStream) {}
 
-    PrintIndent();
-    Unary->GetOperand()->Accept(this);
+  void Print() { Print(0U); }
 
-    Indent -= 2;
-  }
+private:
+  using NodeIndex = FlatAST::NodeIndex;
 
-  void Visit(const ASTVarDecl *VarDecl) const override {
-    PrintWithTextPosition("VarDeclStmt", VarDecl, /*NewLineNeeded=*/false);
-    OutStream << TokenToString(VarDecl->GetDataType()) << " "
-              << VarDecl->GetSymbolName() << std::endl;
+  bool IsPresent(NodeIndex I) const {
+    return AST.GetType(I) != ASTType::BASE_NODE;
+  }
 
-    if (const auto &Body = VarDecl->GetDeclareBody()) {
+  void Print(NodeIndex I) {
+    switch (AST.GetType(I)) {
+    case ASTType::BINARY:
+      PrintWithTextPosition("BinaryOperator", I, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(AST.GetOperation(I)) << std::endl;
+      PrintChildren(I);
+      break;
+    case ASTType::BOOLEAN_LITERAL:
+      PrintWithTextPosition("BooleanLiteral", I, /*NewLineNeeded=*/false);
+      OutStream << std::boolalpha << AST.GetBoolean(I) << std::endl;
+      break;
+    case ASTType::BREAK_STMT:
+      PrintWithTextPosition("BreakStmt", I, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::COMPOUND_STMT:
+      PrintWithTextPosition("CompoundStmt", I, /*NewLineNeeded=*/true);
+      PrintChildren(I);
+      break;
+    case ASTType::CONTINUE_STMT:
+      PrintWithTextPosition("ContinueStmt", I, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::ERROR_NODE:
+      PrintWithTextPosition("ErrorNode", I, /*NewLineNeeded=*/true);
+      break;
+    case ASTType::FLOATING_POINT_LITERAL:
+      PrintWithTextPosition("FloatingPointLiteral", I,
+                            /*NewLineNeeded=*/false);
+      OutStream << AST.GetFloat(I) << std::endl;
+      break;
+    case ASTType::FOR_STMT:
+      PrintWithTextPosition("ForStmt", I, /*NewLineNeeded=*/true);
+      Indent += 2;
+      PrintLabeled("ForStmtInit", AST.GetChild(I, 0U));
+      PrintLabeled("ForStmtCondition", AST.GetChild(I, 1U));
+      PrintLabeled("ForStmtIncrement", AST.GetChild(I, 2U));
+      PrintLabeled("ForStmtBody", AST.GetChild(I, 3U));
+      Indent -= 2;
+      break;
+    case ASTType::IF_STMT:
+      PrintWithTextPosition("IfStmt", I, /*NewLineNeeded=*/true);
+      Indent += 2;
+      PrintLabeled("IfStmtCondition", AST.GetChild(I, 0U));
+      PrintLabeled("IfStmtThenBody", AST.GetChild(I, 1U));
+      PrintLabeled("IfStmtElseBody", AST.GetChild(I, 2U));
+      Indent -= 2;
+      break;
+    case ASTType::INTEGER_LITERAL:
+      PrintWithTextPosition("IntegerLiteral", I, /*NewLineNeeded=*/false);
+      OutStream << AST.GetInteger(I) << std::endl;
+      break;
+    case ASTType::RETURN_STMT:
+      PrintWithTextPosition("ReturnStmt", I, /*NewLineNeeded=*/true);
+      PrintChildren(I);
+      break;
+    case ASTType::STRING_LITERAL:
+      PrintWithTextPosition("StringLiteral", I, /*NewLineNeeded=*/false);
+      OutStream << AST.GetString(I) << std::endl;
+      break;
+    case ASTType::SYMBOL:
+      PrintWithTextPosition("Symbol", I, /*NewLineNeeded=*/false);
+      OutStream << AST.GetString(I) << std::endl;
+      break;
+    case ASTType::PREFIX_UNARY:
+    case ASTType::POSTFIX_UNARY:
+      OutStream << (AST.GetType(I) == ASTType::PREFIX_UNARY ? "Prefix "
+                                                             : "Postfix ");
+      PrintWithTextPosition("UnaryOperator", I, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(AST.GetOperation(I)) << std::endl;
+      PrintChildren(I);
+      break;
+    case ASTType::VAR_DECL:
+      PrintWithTextPosition("VarDeclStmt", I, /*NewLineNeeded=*/false);
+      OutStream << TokenToString(AST.GetOperation(I)) << " "
+                << AST.GetString(I) << std::endl;
+      PrintChildren(I);
+      break;
+    case ASTType::FUNCTION_DECL:
+      PrintFunctionDecl(I);
+      break;
+    case ASTType::FUNCTION_CALL:
+      PrintWithTextPosition("FunctionCall", I, /*NewLineNeeded=*/false);
+      OutStream << AST.GetString(I) << std::endl;
       Indent += 2;
       PrintIndent();
-      Body->Accept(this);
+      PrintWithTextPosition("FunctionArgs", I, /*NewLineNeeded=*/true);
+      PrintChildren(I);
+      Indent -= 2;
+      break;
+    case ASTType::DO_WHILE_STMT:
+      PrintWithTextPosition("DoWhileStmt", I, /*NewLineNeeded=*/true);
+      Indent += 2;
+      PrintLabeled("DoWhileStmtBody", AST.GetChild(I, 0U));
+      PrintLabeled("DoWhileStmtCond", AST.GetChild(I, 1U));
       Indent -= 2;
+      break;
+    case ASTType::WHILE_STMT:
+      PrintWithTextPosition("WhileStmt", I, /*NewLineNeeded=*/true);
+      Indent += 2;
+      PrintLabeled("WhileStmtCond", AST.GetChild(I, 0U));
+      PrintLabeled("WhileStmtBody", AST.GetChild(I, 1U));
+      Indent -= 2;
+      break;
+    default:
+      break;
     }
   }
 
-  void Visit(const ASTFunctionDecl *FunctionDecl) const override {
-    PrintWithTextPosition("FunctionDecl", FunctionDecl, /*NewLineNeeded=*/true);
+  /// Print arguments and body, which is the last child.
+  void PrintFunctionDecl(NodeIndex I) {
+    PrintWithTextPosition("FunctionDecl", I, /*NewLineNeeded=*/true);
 
     Indent += 2;
     PrintIndent();
-    PrintWithTextPosition("FunctionRetType", FunctionDecl,
-                          /*NewLineNeeded=*/false);
-    OutStream << TokenToString(FunctionDecl->GetReturnType()) << std::endl;
+    PrintWithTextPosition("FunctionRetType", I, /*NewLineNeeded=*/false);
+    OutStream << TokenToString(AST.GetOperation(I)) << std::endl;
 
     PrintIndent();
-    PrintWithTextPosition("FunctionName", FunctionDecl,
-                          /*NewLineNeeded=*/false);
-    OutStream << FunctionDecl->GetName() << std::endl;
+    PrintWithTextPosition("FunctionName", I, /*NewLineNeeded=*/false);
+    OutStream << AST.GetString(I) << std::endl;
 
     PrintIndent();
-    PrintWithTextPosition("FunctionArgs", FunctionDecl,
-                          /*NewLineNeeded=*/true);
+    PrintWithTextPosition("FunctionArgs", I, /*NewLineNeeded=*/true);
 
+    NodeIndex Child = AST.GetFirstChild(I);
     Indent += 2;
-    for (const auto &Argument : FunctionDecl->GetArguments()) {
+    for (; AST.GetNextSibling(Child) != FlatAST::None;
+         Child = AST.GetNextSibling(Child)) {
       PrintIndent();
-      Argument->Accept(this);
+      Print(Child);
     }
     Indent -= 2;
 
     PrintIndent();
-    PrintWithTextPosition("FunctionBody", FunctionDecl,
-                          /*NewLineNeeded=*/true);
+    PrintWithTextPosition("FunctionBody", I, /*NewLineNeeded=*/true);
 
     Indent += 2;
     PrintIndent();
-    Visit(FunctionDecl->GetBody().get());
+    Print(Child);
     Indent -= 2;
+    /// Indent is not restored, as in \ref ASTPrinter.
   }
 
-  void Visit(const ASTFunctionCall *FunctionCall) const override {
-    PrintWithTextPosition("FunctionCall", FunctionCall,
-                          /*NewLineNeeded=*/false);
-    OutStream << FunctionCall->GetName() << std::endl;
-
+  /// Print each present child on its own line with greater indent.
+  void PrintChildren(NodeIndex I) {
     Indent += 2;
-    PrintIndent();
-    PrintWithTextPosition("FunctionArgs", FunctionCall,
-                          /*NewLineNeeded=*/true);
-
-    Indent += 2;
-    for (const auto &Argument : FunctionCall->GetArguments()) {
+    for (NodeIndex Child = AST.GetFirstChild(I); Child != FlatAST::None;
+         Child = AST.GetNextSibling(Child)) {
+      if (!IsPresent(Child))
+        continue;
       PrintIndent();
-      Argument->Accept(this);
+      Print(Child);
     }
     Indent -= 2;
-
-    Indent -= 2;
-  }
-
-  void Visit(const ASTDoWhileStmt *DoWhileStmt) const override {
-    CommonWhileStmtVisit(DoWhileStmt, /*IsDoWhile=*/true);
-  }
-
-  void Visit(const ASTWhileStmt *WhileStmt) const override {
-    CommonWhileStmtVisit(WhileStmt, /*IsDoWhile=*/false);
   }
 
-  template <typename WhileNode>
-  void CommonWhileStmtVisit(const WhileNode *WhileStmt, bool IsDoWhile) const {
-    using namespace std::string_literals;
-    PrintWithTextPosition((IsDoWhile ? "Do"s : ""s) + "WhileStmt", WhileStmt,
-                          /*NewLineNeeded=*/true);
-
-    auto PrintWhileCondition = [&] {
-      if (const auto &Condition = WhileStmt->GetCondition().get()) {
-        PrintIndent();
-        PrintWithTextPosition((IsDoWhile ? "Do"s : ""s) + "WhileStmtCond",
-                              Condition,
-                              /*NewLineNeeded=*/true);
-        Indent += 2;
-        PrintIndent();
-        Condition->Accept(this);
-        Indent -= 2;
-      }
-    };
-
-    auto PrintWhileBody = [&] {
-      if (const auto &Body = WhileStmt->GetBody().get()) {
-        PrintIndent();
-        PrintWithTextPosition((IsDoWhile ? "Do"s : ""s) + "WhileStmtBody", Body,
-                              /*NewLineNeeded=*/true);
-        Indent += 2;
-        PrintIndent();
-        Visit(Body);
-        Indent -= 2;
-      }
-    };
-
+  /// Print label with child position, and child below it.
+  void PrintLabeled(std::string_view Label, NodeIndex Child) {
+    if (!IsPresent(Child))
+      return;
+    PrintIndent();
+    PrintWithTextPosition(Label, Child, /*NewLineNeeded=*/true);
     Indent += 2;
-
-    if (IsDoWhile) {
-      PrintWhileBody();
-      PrintWhileCondition();
-    } else {
-      PrintWhileCondition();
-      PrintWhileBody();
-    }
-
+    PrintIndent();
+    Print(Child);
     Indent -= 2;
   }
 
-  void PrintWithTextPosition(std::string_view Label, const ASTNode *Node,
-                             bool NewLineNeeded) const {
-    OutStream << Label << " <line:" << Node->GetLineNo()
-              << ", col:" << Node->GetColumnNo() << ">";
+  void PrintWithTextPosition(std::string_view Label, NodeIndex I,
+                             bool NewLineNeeded) {
+    OutStream << Label << " <line:" << AST.GetLineNo(I)
+              << ", col:" << AST.GetColumnNo(I) << ">";
 
     if (NewLineNeeded)
       OutStream << std::endl;
@@ -344,10 +481,10 @@ private:
       OutStream << " ";
   }
 
-  void PrintIndent() const { OutStream << std::string(Indent, ' '); }
+  void PrintIndent() { OutStream << std::string(Indent, ' '); }
 
-  ASTNode *RootNode;
-  mutable unsigned Indent;
+  const FlatAST &AST;
+  unsigned Indent;
   std::ostream &OutStream;
 };
 
@@ -355,10 +492,15 @@ private:
 
 namespace weak {
 
-void frontEnd::ASTPrettyPrint(const std::unique_ptr<ASTNode> &RootNode,
+void frontEnd::ASTPrettyPrint(const ASTNode *RootNode,
                               std::ostream &OutStream) {
-  ASTPrintVisitor Printer(RootNode.get(), OutStream);
+  ASTPrinter Printer(RootNode, OutStream);
+  Printer.Print();
+}
+
+void frontEnd::ASTPrettyPrint(const FlatAST &AST, std::ostream &OutStream) {
+  FlatASTPrinter Printer(AST, OutStream);
   Printer.Print();
 }
 
-} // namespace weak
\ No newline at end of file
+} // namespace weak
@@ -0,0 +1,387 @@
+/* ASTReader.cpp - Deserializer of AST from binary file.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/ASTReader.hpp"
+#include "FrontEnd/AST/ASTBinaryFormat.hpp"
+#include "FrontEnd/AST/ASTBinaryOperator.hpp"
+#include "FrontEnd/AST/ASTBooleanLiteral.hpp"
+#include "FrontEnd/AST/ASTBreakStmt.hpp"
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTContinueStmt.hpp"
+#include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTErrorNode.hpp"
+#include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
+#include "FrontEnd/AST/ASTForStmt.hpp"
+#include "FrontEnd/AST/ASTFunctionCall.hpp"
+#include "FrontEnd/AST/ASTFunctionDecl.hpp"
+#include "FrontEnd/AST/ASTIfStmt.hpp"
+#include "FrontEnd/AST/ASTIntegerLiteral.hpp"
+#include "FrontEnd/AST/ASTReturnStmt.hpp"
+#include "FrontEnd/AST/ASTStringLiteral.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTUnaryOperator.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace weak {
+namespace frontEnd {
+
+using namespace astBinary;
+
+ASTReader::ASTReader(ASTContext *TheContext)
+    : Context(TheContext), MappedAddress(nullptr), MappedSize(0U), Strings(),
+      FunctionOffsets(), Functions(), Data(), LastLineNo(0U),
+      Corrupted(false) {
+  assert(Context);
+}
+
+ASTReader::~ASTReader() {
+  if (MappedAddress)
+    munmap(MappedAddress, MappedSize);
+}
+
+bool ASTReader::OpenFile(std::string_view Path) {
+  assert(!MappedAddress && "Reader is already opened");
+  std::string PathString(Path);
+  int Descriptor = open(PathString.c_str(), O_RDONLY);
+  if (Descriptor < 0)
+    return false;
+
+  struct stat Stat {};
+  if (fstat(Descriptor, &Stat) < 0 || !S_ISREG(Stat.st_mode) ||
+      Stat.st_size == 0) {
+    close(Descriptor);
+    return false;
+  }
+
+  auto Size = static_cast<std::size_t>(Stat.st_size);
+  void *Address = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+  close(Descriptor);
+  if (Address == MAP_FAILED)
+    return false;
+
+  MappedAddress = Address;
+  MappedSize = Size;
+  return OpenBuffer({static_cast<const char *>(Address), Size});
+}
+
+bool ASTReader::OpenBuffer(std::string_view TheData) {
+  assert(Data.empty() && "Reader is already opened");
+  const auto *Start = reinterpret_cast<const unsigned char *>(TheData.data());
+  Cursor C{Start, Start + TheData.size()};
+  Strings.clear();
+  FunctionOffsets.clear();
+
+  if (TheData.size() < sizeof(Magic) ||
+      std::memcmp(TheData.data(), Magic, sizeof(Magic)) != 0)
+    return false;
+  C.Ptr += sizeof(Magic);
+
+  std::uint64_t FileVersion = 0U;
+  if (!ReadVarint(C, FileVersion) || FileVersion != Version)
+    return false;
+
+  /// Each length and each function size takes at least one byte, so
+  /// counts are checked against the rest of data before allocation.
+  std::uint64_t StringCount = 0U;
+  if (!ReadVarint(C, StringCount) ||
+      StringCount > static_cast<std::size_t>(C.End - C.Ptr))
+    return false;
+  std::vector<std::size_t> Lengths(StringCount);
+  std::size_t TotalLength = 0U;
+  for (std::size_t &Length : Lengths) {
+    std::uint64_t Value = 0U;
+    if (!ReadVarint(C, Value) || Value > TheData.size())
+      return false;
+    Length = Value;
+    TotalLength += Length;
+  }
+  if (TotalLength > static_cast<std::size_t>(C.End - C.Ptr))
+    return false;
+
+  /// All strings are copied at once.
+  std::string_view Table = Context->MakeString(
+      {reinterpret_cast<const char *>(C.Ptr), TotalLength});
+  C.Ptr += TotalLength;
+  Strings.reserve(StringCount);
+  std::size_t Offset = 0U;
+  for (std::size_t Length : Lengths) {
+    Strings.push_back(Table.substr(Offset, Length));
+    Offset += Length;
+  }
+
+  std::uint64_t FunctionCount = 0U;
+  if (!ReadVarint(C, FunctionCount) ||
+      FunctionCount > static_cast<std::size_t>(C.End - C.Ptr))
+    return false;
+  std::vector<std::size_t> Sizes(FunctionCount);
+  for (std::size_t &Size : Sizes) {
+    std::uint64_t Value = 0U;
+    if (!ReadVarint(C, Value) || Value > TheData.size())
+      return false;
+    Size = Value;
+  }
+
+  Offset = C.Ptr - Start;
+  FunctionOffsets.reserve(FunctionCount + 1U);
+  FunctionOffsets.push_back(Offset);
+  for (std::size_t Size : Sizes) {
+    Offset += Size;
+    if (Offset > TheData.size())
+      return false;
+    FunctionOffsets.push_back(Offset);
+  }
+  if (Offset != TheData.size())
+    return false;
+
+  Functions.assign(FunctionCount, nullptr);
+  Data = TheData;
+  return true;
+}
+
+unsigned ASTReader::GetFunctionCount() const { return Functions.size(); }
+
+ASTNode *ASTReader::GetFunction(unsigned Index) {
+  assert(Index < Functions.size());
+  if (Functions[Index])
+    return Functions[Index];
+
+  const auto *Start = reinterpret_cast<const unsigned char *>(Data.data());
+  Cursor C{Start + FunctionOffsets[Index], Start + FunctionOffsets[Index + 1U]};
+  LastLineNo = 0U;
+  Corrupted = false;
+  ASTNode *Function = ReadRequiredNode(C);
+  /// Nodes of corrupted function become garbage in context.
+  if (Corrupted || C.Ptr != C.End)
+    return nullptr;
+  Functions[Index] = Function;
+  return Function;
+}
+
+ASTCompoundStmt *ASTReader::ReadAll() {
+  std::vector<ASTNode *> GlobalEntities;
+  GlobalEntities.reserve(Functions.size());
+  for (unsigned I = 0U; I < Functions.size(); ++I) {
+    ASTNode *Function = GetFunction(I);
+    if (!Function)
+      return nullptr;
+    GlobalEntities.push_back(Function);
+  }
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(GlobalEntities));
+}
+
+bool ASTReader::ReadVarint(Cursor &C, std::uint64_t &Value) {
+  Value = 0U;
+  for (unsigned Shift = 0U; Shift < 64U; Shift += 7U) {
+    if (C.Ptr == C.End)
+      return false;
+    unsigned char Byte = *C.Ptr++;
+    Value |= static_cast<std::uint64_t>(Byte & 0x7FU) << Shift;
+    if (!(Byte & 0x80U))
+      return true;
+  }
+  return false;
+}
+
+std::uint64_t ASTReader::Read(Cursor &C, std::uint64_t Max) {
+  std::uint64_t Value = 0U;
+  if (!ReadVarint(C, Value) || Value > Max) {
+    MarkCorrupted(C);
+    return 0U;
+  }
+  return Value;
+}
+
+TokenType ASTReader::ReadToken(Cursor &C) {
+  return static_cast<TokenType>(
+      Read(C, static_cast<std::uint64_t>(TokenType::CLOSE_PAREN)));
+}
+
+std::string_view ASTReader::ReadString(Cursor &C) {
+  if (Strings.empty()) {
+    MarkCorrupted(C);
+    return {};
+  }
+  return Strings[Read(C, Strings.size() - 1U)];
+}
+
+unsigned ASTReader::ReadDeclaration(Cursor &C) {
+  /// 0 overflows to NoDeclaration.
+  return static_cast<unsigned>(
+             Read(C, std::numeric_limits<unsigned>::max())) -
+         1U;
+}
+
+ASTNodeList ASTReader::ReadList(Cursor &C) {
+  /// Each node takes at least one byte.
+  std::size_t Size = Read(C, C.End - C.Ptr);
+  std::vector<ASTNode *> Nodes;
+  Nodes.reserve(Size);
+  for (std::size_t I = 0U; I < Size && !Corrupted; ++I)
+    Nodes.push_back(ReadRequiredNode(C));
+  return Context->MakeList(Nodes);
+}
+
+ASTNode *ASTReader::ReadNode(Cursor &C) {
+  auto Type = static_cast<ASTType>(
+      Read(C, static_cast<std::uint64_t>(ASTType::ERROR_NODE)));
+  if (Corrupted || Type == ASTType::BASE_NODE)
+    return nullptr;
+
+  std::uint64_t LineDelta = Read(C, std::numeric_limits<std::uint64_t>::max());
+  /// Unsigned overflow moves line up, if delta is negative.
+  unsigned LineNo = LastLineNo + ZigZagDecode(LineDelta);
+  auto ColumnNo = static_cast<unsigned>(
+      Read(C, std::numeric_limits<unsigned>::max()));
+  LastLineNo = LineNo;
+
+  /// Fields are read to variables first, since order of evaluation of
+  /// function arguments is unspecified.
+  switch (Type) {
+  case ASTType::INTEGER_LITERAL: {
+    std::int64_t Value =
+        ZigZagDecode(Read(C, std::numeric_limits<std::uint64_t>::max()));
+    return Context->Make<ASTIntegerLiteral>(static_cast<signed>(Value), LineNo,
+                                            ColumnNo);
+  }
+  case ASTType::FLOATING_POINT_LITERAL: {
+    if (C.End - C.Ptr < 8) {
+      MarkCorrupted(C);
+      return nullptr;
+    }
+    std::uint64_t Bits = 0U;
+    for (unsigned I = 0U; I < 8U; ++I)
+      Bits |= static_cast<std::uint64_t>(*C.Ptr++) << (I * 8U);
+    double Value = 0.0;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Context->Make<ASTFloatingPointLiteral>(Value, LineNo, ColumnNo);
+  }
+  case ASTType::STRING_LITERAL:
+    return Context->Make<ASTStringLiteral>(ReadString(C), LineNo, ColumnNo);
+  case ASTType::BOOLEAN_LITERAL:
+    return Context->Make<ASTBooleanLiteral>(Read(C, 1U) != 0U, LineNo,
+                                            ColumnNo);
+  case ASTType::SYMBOL: {
+    auto *Symbol = Context->Make<ASTSymbol>(ReadString(C), LineNo, ColumnNo);
+    Symbol->SetDeclaration(ReadDeclaration(C));
+    return Symbol;
+  }
+  case ASTType::VAR_DECL: {
+    TokenType DataType = ReadToken(C);
+    std::string_view Name = ReadString(C);
+    unsigned Declaration = ReadDeclaration(C);
+    ASTNode *Body = ReadNode(C);
+    auto *VarDecl =
+        Context->Make<ASTVarDecl>(DataType, Name, Body, LineNo, ColumnNo);
+    VarDecl->SetDeclaration(Declaration);
+    return VarDecl;
+  }
+  case ASTType::BREAK_STMT:
+    return Context->Make<ASTBreakStmt>(LineNo, ColumnNo);
+  case ASTType::CONTINUE_STMT:
+    return Context->Make<ASTContinueStmt>(LineNo, ColumnNo);
+  case ASTType::BINARY: {
+    TokenType Operation = ReadToken(C);
+    ASTNode *LHS = ReadRequiredNode(C);
+    ASTNode *RHS = ReadRequiredNode(C);
+    return Context->Make<ASTBinaryOperator>(Operation, LHS, RHS, LineNo,
+                                            ColumnNo);
+  }
+  case ASTType::PREFIX_UNARY:
+  case ASTType::POSTFIX_UNARY: {
+    auto PrefixOrPostfix = Type == ASTType::PREFIX_UNARY
+                               ? ASTUnaryOperator::UnaryType::PREFIX
+                               : ASTUnaryOperator::UnaryType::POSTFIX;
+    TokenType Operation = ReadToken(C);
+    ASTNode *Operand = ReadRequiredNode(C);
+    return Context->Make<ASTUnaryOperator>(PrefixOrPostfix, Operation, Operand,
+                                           LineNo, ColumnNo);
+  }
+  case ASTType::IF_STMT: {
+    ASTNode *Condition = ReadRequiredNode(C);
+    ASTCompoundStmt *ThenBody = ReadCompoundStmt(C);
+    ASTCompoundStmt *ElseBody = ReadCompoundStmt(C, /*Optional=*/true);
+    return Context->Make<ASTIfStmt>(Condition, ThenBody, ElseBody, LineNo,
+                                    ColumnNo);
+  }
+  case ASTType::FOR_STMT: {
+    ASTNode *Init = ReadNode(C);
+    ASTNode *Condition = ReadNode(C);
+    ASTNode *Increment = ReadNode(C);
+    ASTCompoundStmt *Body = ReadCompoundStmt(C);
+    return Context->Make<ASTForStmt>(Init, Condition, Increment, Body, LineNo,
+                                     ColumnNo);
+  }
+  case ASTType::WHILE_STMT: {
+    ASTNode *Condition = ReadRequiredNode(C);
+    ASTCompoundStmt *Body = ReadCompoundStmt(C);
+    return Context->Make<ASTWhileStmt>(Condition, Body, LineNo, ColumnNo);
+  }
+  case ASTType::DO_WHILE_STMT: {
+    ASTCompoundStmt *Body = ReadCompoundStmt(C);
+    ASTNode *Condition = ReadRequiredNode(C);
+    return Context->Make<ASTDoWhileStmt>(Body, Condition, LineNo, ColumnNo);
+  }
+  case ASTType::RETURN_STMT:
+    return Context->Make<ASTReturnStmt>(ReadNode(C), LineNo, ColumnNo);
+  case ASTType::COMPOUND_STMT:
+    return Context->Make<ASTCompoundStmt>(ReadList(C), LineNo, ColumnNo);
+  case ASTType::FUNCTION_DECL: {
+    TokenType ReturnType = ReadToken(C);
+    std::string_view Name = ReadString(C);
+    ASTNodeList Arguments = ReadList(C);
+    ASTCompoundStmt *Body = ReadCompoundStmt(C);
+    return Context->Make<ASTFunctionDecl>(ReturnType, Name, Arguments, Body,
+                                          LineNo, ColumnNo);
+  }
+  case ASTType::FUNCTION_CALL: {
+    std::string_view Name = ReadString(C);
+    ASTNodeList Arguments = ReadList(C);
+    return Context->Make<ASTFunctionCall>(Name, Arguments, LineNo, ColumnNo);
+  }
+  case ASTType::ERROR_NODE:
+    return Context->Make<ASTErrorNode>(LineNo, ColumnNo);
+  default:
+    /// Base node with position, or parameter, which has no node class.
+    MarkCorrupted(C);
+    return nullptr;
+  }
+}
+
+ASTNode *ASTReader::ReadRequiredNode(Cursor &C) {
+  ASTNode *Node = ReadNode(C);
+  if (!Node)
+    MarkCorrupted(C);
+  return Node;
+}
+
+ASTCompoundStmt *ASTReader::ReadCompoundStmt(Cursor &C, bool Optional) {
+  ASTNode *Node = ReadNode(C);
+  if (!Node && Optional)
+    return nullptr;
+  if (!Node || Node->GetASTType() != ASTType::COMPOUND_STMT) {
+    MarkCorrupted(C);
+    return nullptr;
+  }
+  return static_cast<ASTCompoundStmt *>(Node);
+}
+
+void ASTReader::MarkCorrupted(Cursor &C) {
+  Corrupted = true;
+  C.Ptr = C.End;
+}
+
+} // namespace frontEnd
+} // namespace weak
@@ -10,19 +10,16 @@
 namespace weak {
 namespace frontEnd {
 
-ASTReturnStmt::ASTReturnStmt(std::unique_ptr<ASTNode> &&TheOperand,
-                             unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Operand(std::move(TheOperand)) {}
-
-ASTType ASTReturnStmt::GetASTType() const { return ASTType::RETURN_STMT; }
+ASTReturnStmt::ASTReturnStmt(ASTNode *TheOperand, unsigned TheLineNo,
+                             unsigned TheColumnNo)
+    : ASTNode(ASTType::RETURN_STMT, TheLineNo, TheColumnNo),
+      Operand(TheOperand) {}
 
 void ASTReturnStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-const std::unique_ptr<ASTNode> &ASTReturnStmt::GetOperand() const {
-  return Operand;
-}
+ASTNode *ASTReturnStmt::GetOperand() const { return Operand; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
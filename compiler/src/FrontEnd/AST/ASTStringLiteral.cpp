@@ -10,17 +10,16 @@
 namespace weak {
 namespace frontEnd {
 
-ASTStringLiteral::ASTStringLiteral(std::string TheValue, unsigned TheLineNo,
-                                   unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Value(std::move(TheValue)) {}
-
-ASTType ASTStringLiteral::GetASTType() const { return ASTType::STRING_LITERAL; }
+ASTStringLiteral::ASTStringLiteral(std::string_view TheValue,
+                                   unsigned TheLineNo, unsigned TheColumnNo)
+    : ASTNode(ASTType::STRING_LITERAL, TheLineNo, TheColumnNo),
+      Value(TheValue) {}
 
 void ASTStringLiteral::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-const std::string &ASTStringLiteral::GetValue() const { return Value; }
+std::string_view ASTStringLiteral::GetValue() const { return Value; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
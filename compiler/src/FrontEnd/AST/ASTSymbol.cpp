@@ -10,12 +10,15 @@
 namespace weak {
 namespace frontEnd {
 
-ASTSymbol::ASTSymbol(std::string TheValue, unsigned TheLineNo,
+ASTSymbol::ASTSymbol(std::string_view TheName, unsigned TheLineNo,
                      unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Value(std::move(TheValue)), SSAIndex(0) {
-}
+    : ASTSymbol(StringInterner::Global().Intern(TheName), TheLineNo,
+                TheColumnNo) {}
 
-ASTType ASTSymbol::GetASTType() const { return ASTType::SYMBOL; }
+ASTSymbol::ASTSymbol(StringInterner::ID TheName, unsigned TheLineNo,
+                     unsigned TheColumnNo)
+    : ASTNode(ASTType::SYMBOL, TheLineNo, TheColumnNo), Name(TheName),
+      SSAIndex(0), Declaration(ASTVarDecl::NoDeclaration) {}
 
 void ASTSymbol::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -23,11 +26,19 @@ void ASTSymbol::Accept(const ASTVisitor *Visitor) const {
 
 void ASTSymbol::SetSSAIndex(int Index) { SSAIndex = Index; }
 
-const std::string &ASTSymbol::GetName() const { return Value; }
+std::string_view ASTSymbol::GetName() const {
+  return StringInterner::Global().GetString(Name);
+}
+
+StringInterner::ID ASTSymbol::GetNameID() const { return Name; }
 
 std::string ASTSymbol::GetSSAName() const {
-  return Value + "#" + std::to_string(SSAIndex);
+  return std::string(GetName()) + "#" + std::to_string(SSAIndex);
 }
 
+void ASTSymbol::SetDeclaration(unsigned Index) { Declaration = Index; }
+
+unsigned ASTSymbol::GetDeclaration() const { return Declaration; }
+
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
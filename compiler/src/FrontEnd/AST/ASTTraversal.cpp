@@ -0,0 +1,131 @@
+/* ASTTraversal.cpp - Non-recursive AST traversal.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/ASTTraversal.hpp"
+#include "FrontEnd/AST/ASTBinaryOperator.hpp"
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTForStmt.hpp"
+#include "FrontEnd/AST/ASTFunctionCall.hpp"
+#include "FrontEnd/AST/ASTFunctionDecl.hpp"
+#include "FrontEnd/AST/ASTIfStmt.hpp"
+#include "FrontEnd/AST/ASTReturnStmt.hpp"
+#include "FrontEnd/AST/ASTUnaryOperator.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include <algorithm>
+
+namespace weak {
+namespace frontEnd {
+
+namespace {
+
+using PendingList = std::vector<std::pair<const ASTNode *, std::size_t>>;
+
+/// Append present children of node in the order of getters.
+void AppendChildren(const ASTNode *Node, std::size_t Depth,
+                    PendingList &Pending) {
+  auto Add = [&](const ASTNode *Child) {
+    if (Child)
+      Pending.emplace_back(Child, Depth);
+  };
+  auto AddAll = [&](ASTNodeList Children) {
+    for (const ASTNode *Child : Children)
+      Add(Child);
+  };
+
+  switch (Node->GetASTType()) {
+  case ASTType::BINARY: {
+    const auto *Binary = static_cast<const ASTBinaryOperator *>(Node);
+    Add(Binary->GetLHS());
+    Add(Binary->GetRHS());
+    break;
+  }
+  case ASTType::PREFIX_UNARY:
+  case ASTType::POSTFIX_UNARY:
+    Add(static_cast<const ASTUnaryOperator *>(Node)->GetOperand());
+    break;
+  case ASTType::VAR_DECL:
+    Add(static_cast<const ASTVarDecl *>(Node)->GetDeclareBody());
+    break;
+  case ASTType::IF_STMT: {
+    const auto *If = static_cast<const ASTIfStmt *>(Node);
+    Add(If->GetCondition());
+    Add(If->GetThenBody());
+    Add(If->GetElseBody());
+    break;
+  }
+  case ASTType::FOR_STMT: {
+    const auto *For = static_cast<const ASTForStmt *>(Node);
+    Add(For->GetInit());
+    Add(For->GetCondition());
+    Add(For->GetIncrement());
+    Add(For->GetBody());
+    break;
+  }
+  case ASTType::WHILE_STMT: {
+    const auto *While = static_cast<const ASTWhileStmt *>(Node);
+    Add(While->GetCondition());
+    Add(While->GetBody());
+    break;
+  }
+  case ASTType::DO_WHILE_STMT: {
+    const auto *DoWhile = static_cast<const ASTDoWhileStmt *>(Node);
+    Add(DoWhile->GetBody());
+    Add(DoWhile->GetCondition());
+    break;
+  }
+  case ASTType::RETURN_STMT:
+    Add(static_cast<const ASTReturnStmt *>(Node)->GetOperand());
+    break;
+  case ASTType::COMPOUND_STMT:
+    AddAll(static_cast<const ASTCompoundStmt *>(Node)->GetStmts());
+    break;
+  case ASTType::FUNCTION_DECL: {
+    const auto *Function = static_cast<const ASTFunctionDecl *>(Node);
+    AddAll(Function->GetArguments());
+    Add(Function->GetBody());
+    break;
+  }
+  case ASTType::FUNCTION_CALL:
+    AddAll(static_cast<const ASTFunctionCall *>(Node)->GetArguments());
+    break;
+  default:
+    break;
+  }
+}
+
+} // namespace
+
+ASTWalker::ASTWalker(const ASTNode *Root)
+    : Path(), Pending(), Leaving(false), SkipCurrent(false) {
+  if (Root)
+    Pending.emplace_back(Root, 0U);
+}
+
+bool ASTWalker::Next() {
+  if (!Path.empty() && !Leaving && !SkipCurrent) {
+    std::size_t Begin = Pending.size();
+    AppendChildren(Path.back(), Path.size(), Pending);
+    /// Stack is popped from the back, so the first child goes last.
+    std::reverse(Pending.begin() + Begin, Pending.end());
+  }
+  if (Leaving && !Path.empty())
+    Path.pop_back();
+  SkipCurrent = false;
+
+  if (!Pending.empty() && Pending.back().second == Path.size()) {
+    Path.push_back(Pending.back().first);
+    Pending.pop_back();
+    Leaving = false;
+    return true;
+  }
+  Leaving = true;
+  return !Path.empty();
+}
+
+} // namespace frontEnd
+} // namespace weak
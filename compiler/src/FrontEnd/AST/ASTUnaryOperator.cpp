@@ -12,15 +12,13 @@ namespace frontEnd {
 
 ASTUnaryOperator::ASTUnaryOperator(UnaryType ThePrefixOrPostfix,
                                    weak::frontEnd::TokenType TheOperation,
-                                   std::unique_ptr<ASTNode> &&TheOperand,
-                                   unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), PrefixOrPostfix(ThePrefixOrPostfix),
-      Operation(TheOperation), Operand(std::move(TheOperand)) {}
-
-ASTType ASTUnaryOperator::GetASTType() const {
-  return PrefixOrPostfix == UnaryType::POSTFIX ? ASTType::POSTFIX_UNARY
-                                               : ASTType::PREFIX_UNARY;
-}
+                                   ASTNode *TheOperand, unsigned TheLineNo,
+                                   unsigned TheColumnNo)
+    : ASTNode(ThePrefixOrPostfix == UnaryType::POSTFIX ? ASTType::POSTFIX_UNARY
+                                                       : ASTType::PREFIX_UNARY,
+              TheLineNo, TheColumnNo),
+      PrefixOrPostfix(ThePrefixOrPostfix), Operation(TheOperation),
+      Operand(TheOperand) {}
 
 void ASTUnaryOperator::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -28,9 +26,7 @@ void ASTUnaryOperator::Accept(const ASTVisitor *Visitor) const {
 
 TokenType ASTUnaryOperator::GetOperation() const { return Operation; }
 
-const std::unique_ptr<ASTNode> &ASTUnaryOperator::GetOperand() const {
-  return Operand;
-}
+ASTNode *ASTUnaryOperator::GetOperand() const { return Operand; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
@@ -10,14 +10,18 @@
 namespace weak {
 namespace frontEnd {
 
-ASTVarDecl::ASTVarDecl(TokenType TheDataType, std::string &&TheSymbolName,
-                       std::unique_ptr<ASTNode> &&TheDeclareBody,
-                       unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), DataType(TheDataType),
-      SymbolName(std::move(TheSymbolName)),
-      DeclareBody(std::move(TheDeclareBody)) {}
-
-ASTType ASTVarDecl::GetASTType() const { return ASTType::VAR_DECL; }
+ASTVarDecl::ASTVarDecl(TokenType TheDataType, std::string_view TheSymbolName,
+                       ASTNode *TheDeclareBody, unsigned TheLineNo,
+                       unsigned TheColumnNo)
+    : ASTVarDecl(TheDataType, StringInterner::Global().Intern(TheSymbolName),
+                 TheDeclareBody, TheLineNo, TheColumnNo) {}
+
+ASTVarDecl::ASTVarDecl(TokenType TheDataType, StringInterner::ID TheSymbolName,
+                       ASTNode *TheDeclareBody, unsigned TheLineNo,
+                       unsigned TheColumnNo)
+    : ASTNode(ASTType::VAR_DECL, TheLineNo, TheColumnNo), DataType(TheDataType),
+      SymbolName(TheSymbolName), DeclareBody(TheDeclareBody),
+      Declaration(NoDeclaration) {}
 
 void ASTVarDecl::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
@@ -25,11 +29,17 @@ void ASTVarDecl::Accept(const ASTVisitor *Visitor) const {
 
 TokenType ASTVarDecl::GetDataType() const { return DataType; }
 
-const std::string &ASTVarDecl::GetSymbolName() const { return SymbolName; }
-
-const std::unique_ptr<ASTNode> &ASTVarDecl::GetDeclareBody() const {
-  return DeclareBody;
+std::string_view ASTVarDecl::GetSymbolName() const {
+  return StringInterner::Global().GetString(SymbolName);
 }
 
+StringInterner::ID ASTVarDecl::GetSymbolNameID() const { return SymbolName; }
+
+ASTNode *ASTVarDecl::GetDeclareBody() const { return DeclareBody; }
+
+void ASTVarDecl::SetDeclaration(unsigned Index) { Declaration = Index; }
+
+unsigned ASTVarDecl::GetDeclaration() const { return Declaration; }
+
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
@@ -10,33 +10,18 @@
 namespace weak {
 namespace frontEnd {
 
-ASTWhileStmt::ASTWhileStmt(std::unique_ptr<ASTNode> &&TheCondition,
-                           std::unique_ptr<ASTCompoundStmt> &&TheBody,
+ASTWhileStmt::ASTWhileStmt(ASTNode *TheCondition, ASTCompoundStmt *TheBody,
                            unsigned TheLineNo, unsigned TheColumnNo)
-    : ASTNode(TheLineNo, TheColumnNo), Condition(std::move(TheCondition)),
-      Body(std::move(TheBody)) {}
-
-ASTType ASTWhileStmt::GetASTType() const { return ASTType::WHILE_STMT; }
+    : ASTNode(ASTType::WHILE_STMT, TheLineNo, TheColumnNo),
+      Condition(TheCondition), Body(TheBody) {}
 
 void ASTWhileStmt::Accept(const ASTVisitor *Visitor) const {
   Visitor->Visit(this);
 }
 
-std::unique_ptr<ASTNode> &&ASTWhileStmt::GetCondition() {
-  return std::move(Condition);
-}
-
-const std::unique_ptr<ASTNode> &ASTWhileStmt::GetCondition() const {
-  return Condition;
-}
+ASTNode *ASTWhileStmt::GetCondition() const { return Condition; }
 
-std::unique_ptr<ASTCompoundStmt> &&ASTWhileStmt::GetBody() {
-  return std::move(Body);
-}
-
-const std::unique_ptr<ASTCompoundStmt> &ASTWhileStmt::GetBody() const {
-  return Body;
-}
+ASTCompoundStmt *ASTWhileStmt::GetBody() const { return Body; }
 
 } // namespace frontEnd
 } // namespace weak
\ No newline at end of file
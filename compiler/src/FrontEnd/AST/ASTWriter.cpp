@@ -0,0 +1,211 @@
+/* ASTWriter.cpp - Serializer of AST to binary file.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/ASTWriter.hpp"
+#include "FrontEnd/AST/ASTBinaryFormat.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace weak::frontEnd;
+using namespace weak::frontEnd::astBinary;
+
+namespace {
+
+class ASTWriteVisitor : public RecursiveASTVisitor<ASTWriteVisitor> {
+public:
+  ASTWriteVisitor(const ASTCompoundStmt *TheRootNode,
+                  std::ostream &TheOutStream)
+      : RootNode(TheRootNode), OutStream(TheOutStream), Out(nullptr),
+        LastLineNo(0U), Strings(), StringIndices() {}
+
+  void Write() {
+    std::vector<std::string> Functions;
+    for (const ASTNode *Function : RootNode->GetStmts()) {
+      Out = &Functions.emplace_back();
+      LastLineNo = 0U;
+      WriteNode(Function);
+    }
+
+    std::string Header(Magic, sizeof(Magic));
+    WriteVarint(Header, Version);
+
+    WriteVarint(Header, Strings.size());
+    for (std::string_view String : Strings)
+      WriteVarint(Header, String.size());
+    for (std::string_view String : Strings)
+      Header += String;
+
+    WriteVarint(Header, Functions.size());
+    for (const std::string &Function : Functions)
+      WriteVarint(Header, Function.size());
+
+    OutStream.write(Header.data(), Header.size());
+    for (const std::string &Function : Functions)
+      OutStream.write(Function.data(), Function.size());
+  }
+
+private:
+  friend class RecursiveASTVisitor<ASTWriteVisitor>;
+
+  /// Write node with its position, or BASE_NODE tag if node is absent.
+  void WriteNode(const ASTNode *Node) {
+    if (!Node) {
+      WriteVarint(*Out, static_cast<unsigned>(ASTType::BASE_NODE));
+      return;
+    }
+    WriteVarint(*Out, static_cast<unsigned>(Node->GetASTType()));
+    std::int64_t LineDelta =
+        static_cast<std::int64_t>(Node->GetLineNo()) - LastLineNo;
+    WriteVarint(*Out, ZigZagEncode(LineDelta));
+    WriteVarint(*Out, Node->GetColumnNo());
+    LastLineNo = Node->GetLineNo();
+    Traverse(Node);
+  }
+
+  void WriteList(ASTNodeList Nodes) {
+    WriteVarint(*Out, Nodes.size());
+    for (const ASTNode *Node : Nodes)
+      WriteNode(Node);
+  }
+
+  void WriteToken(TokenType Type) {
+    WriteVarint(*Out, static_cast<unsigned>(Type));
+  }
+
+  /// NoDeclaration overflows to 0.
+  void WriteDeclaration(unsigned Declaration) {
+    WriteVarint(*Out, Declaration + 1U);
+  }
+
+  /// Equal strings are stored once.
+  void WriteString(std::string_view String) {
+    auto [It, Inserted] = StringIndices.try_emplace(String, Strings.size());
+    if (Inserted)
+      Strings.push_back(String);
+    WriteVarint(*Out, It->second);
+  }
+
+  void Visit(const ASTBinaryOperator *Binary) {
+    WriteToken(Binary->GetOperation());
+    WriteNode(Binary->GetLHS());
+    WriteNode(Binary->GetRHS());
+  }
+
+  void Visit(const ASTBooleanLiteral *Boolean) {
+    WriteVarint(*Out, Boolean->GetValue());
+  }
+
+  void Visit(const ASTBreakStmt *) {}
+
+  void Visit(const ASTCompoundStmt *CompoundStmt) {
+    WriteList(CompoundStmt->GetStmts());
+  }
+
+  void Visit(const ASTContinueStmt *) {}
+
+  void Visit(const ASTDoWhileStmt *DoWhileStmt) {
+    WriteNode(DoWhileStmt->GetBody());
+    WriteNode(DoWhileStmt->GetCondition());
+  }
+
+  void Visit(const ASTErrorNode *) {}
+
+  void Visit(const ASTFloatingPointLiteral *Float) {
+    double Value = Float->GetValue();
+    std::uint64_t Bits = 0U;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    for (unsigned I = 0U; I < sizeof(Bits); ++I)
+      Out->push_back(static_cast<char>(Bits >> (I * 8U)));
+  }
+
+  void Visit(const ASTForStmt *ForStmt) {
+    WriteNode(ForStmt->GetInit());
+    WriteNode(ForStmt->GetCondition());
+    WriteNode(ForStmt->GetIncrement());
+    WriteNode(ForStmt->GetBody());
+  }
+
+  void Visit(const ASTFunctionDecl *FunctionDecl) {
+    WriteToken(FunctionDecl->GetReturnType());
+    WriteString(FunctionDecl->GetName());
+    WriteList(FunctionDecl->GetArguments());
+    WriteNode(FunctionDecl->GetBody());
+  }
+
+  void Visit(const ASTFunctionCall *FunctionCall) {
+    WriteString(FunctionCall->GetName());
+    WriteList(FunctionCall->GetArguments());
+  }
+
+  void Visit(const ASTIfStmt *IfStmt) {
+    WriteNode(IfStmt->GetCondition());
+    WriteNode(IfStmt->GetThenBody());
+    WriteNode(IfStmt->GetElseBody());
+  }
+
+  void Visit(const ASTIntegerLiteral *Integer) {
+    WriteVarint(*Out, ZigZagEncode(Integer->GetValue()));
+  }
+
+  void Visit(const ASTReturnStmt *ReturnStmt) {
+    WriteNode(ReturnStmt->GetOperand());
+  }
+
+  void Visit(const ASTStringLiteral *String) {
+    WriteString(String->GetValue());
+  }
+
+  void Visit(const ASTSymbol *Symbol) {
+    WriteString(Symbol->GetName());
+    WriteDeclaration(Symbol->GetDeclaration());
+  }
+
+  void Visit(const ASTUnaryOperator *Unary) {
+    WriteToken(Unary->GetOperation());
+    WriteNode(Unary->GetOperand());
+  }
+
+  void Visit(const ASTVarDecl *VarDecl) {
+    WriteToken(VarDecl->GetDataType());
+    WriteString(VarDecl->GetSymbolName());
+    WriteDeclaration(VarDecl->GetDeclaration());
+    WriteNode(VarDecl->GetDeclareBody());
+  }
+
+  void Visit(const ASTWhileStmt *WhileStmt) {
+    WriteNode(WhileStmt->GetCondition());
+    WriteNode(WhileStmt->GetBody());
+  }
+
+  const ASTCompoundStmt *RootNode;
+  std::ostream &OutStream;
+
+  /// Encoded function, being written.
+  std::string *Out;
+
+  /// Line of the previous node, lines are written relative to it.
+  unsigned LastLineNo;
+
+  /// String table in order of first use.
+  std::vector<std::string_view> Strings;
+  std::unordered_map<std::string_view, unsigned> StringIndices;
+};
+
+} // namespace
+
+namespace weak {
+namespace frontEnd {
+
+void ASTWrite(const ASTCompoundStmt *RootNode, std::ostream &OutStream) {
+  ASTWriteVisitor(RootNode, OutStream).Write();
+}
+
+} // namespace frontEnd
+} // namespace weak
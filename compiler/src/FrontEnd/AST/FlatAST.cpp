@@ -0,0 +1,234 @@
+/* FlatAST.cpp - Structure-of-arrays encoding of AST.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/AST/FlatAST.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include <cassert>
+
+namespace weak {
+namespace frontEnd {
+
+/// Append nodes in pre-order. Visit methods fill payload of the current
+/// node and append its children.
+class FlatASTBuilder : public RecursiveASTVisitor<FlatASTBuilder> {
+public:
+  FlatASTBuilder(FlatAST *TheAST) : AST(TheAST), LastChild(FlatAST::None) {}
+
+  /// Append node with all its children, or placeholder if node is absent.
+  FlatAST::NodeIndex Add(ASTNode *Node) {
+    auto I = static_cast<FlatAST::NodeIndex>(AST->Types.size());
+    AST->Types.push_back(Node ? Node->GetASTType() : ASTType::BASE_NODE);
+    AST->LineNos.push_back(Node ? Node->GetLineNo() : 0U);
+    AST->ColumnNos.push_back(Node ? Node->GetColumnNo() : 0U);
+    AST->FirstChildren.push_back(FlatAST::None);
+    AST->NextSiblings.push_back(FlatAST::None);
+    AST->Payloads.push_back(0U);
+    AST->Operations.push_back(TokenType::NONE);
+    AST->Nodes.push_back(Node);
+
+    if (Node) {
+      FlatAST::NodeIndex OuterLastChild = LastChild;
+      LastChild = FlatAST::None;
+      Traverse(Node);
+      LastChild = OuterLastChild;
+    }
+    return I;
+  }
+
+private:
+  friend class RecursiveASTVisitor<FlatASTBuilder>;
+
+  /// Append child of the last node, whose children are being added.
+  void AddChild(FlatAST::NodeIndex Parent, ASTNode *Child) {
+    FlatAST::NodeIndex PreviousChild = LastChild;
+    FlatAST::NodeIndex I = Add(Child);
+    if (PreviousChild == FlatAST::None)
+      AST->FirstChildren[Parent] = I;
+    else
+      AST->NextSiblings[PreviousChild] = I;
+    LastChild = I;
+  }
+
+  void AddChildren(FlatAST::NodeIndex Parent, ASTNodeList Children) {
+    for (ASTNode *Child : Children)
+      AddChild(Parent, Child);
+  }
+
+  /// Index of node, which is being visited. Children are not added yet,
+  /// so it is the last one.
+  FlatAST::NodeIndex Current() const {
+    assert(LastChild == FlatAST::None);
+    return AST->Types.size() - 1U;
+  }
+
+  void SetString(FlatAST::NodeIndex I, std::string_view String,
+                 unsigned Declaration = ASTVarDecl::NoDeclaration) const {
+    AST->Payloads[I] = AST->Strings.size();
+    AST->Strings.push_back(String);
+    AST->Declarations.push_back(Declaration);
+  }
+
+  void Visit(const ASTBinaryOperator *Binary) {
+    FlatAST::NodeIndex I = Current();
+    AST->Operations[I] = Binary->GetOperation();
+    AddChild(I, Binary->GetLHS());
+    AddChild(I, Binary->GetRHS());
+  }
+
+  void Visit(const ASTBooleanLiteral *Boolean) {
+    AST->Payloads[Current()] = Boolean->GetValue();
+  }
+
+  void Visit(const ASTBreakStmt *) {}
+
+  void Visit(const ASTCompoundStmt *CompoundStmt) {
+    AddChildren(Current(), CompoundStmt->GetStmts());
+  }
+
+  void Visit(const ASTContinueStmt *) {}
+
+  void Visit(const ASTDoWhileStmt *DoWhileStmt) {
+    FlatAST::NodeIndex I = Current();
+    AddChild(I, DoWhileStmt->GetBody());
+    AddChild(I, DoWhileStmt->GetCondition());
+  }
+
+  void Visit(const ASTErrorNode *) {}
+
+  void Visit(const ASTFloatingPointLiteral *Float) {
+    FlatAST::NodeIndex I = Current();
+    AST->Payloads[I] = AST->Floats.size();
+    AST->Floats.push_back(Float->GetValue());
+  }
+
+  void Visit(const ASTForStmt *ForStmt) {
+    FlatAST::NodeIndex I = Current();
+    AddChild(I, ForStmt->GetInit());
+    AddChild(I, ForStmt->GetCondition());
+    AddChild(I, ForStmt->GetIncrement());
+    AddChild(I, ForStmt->GetBody());
+  }
+
+  void Visit(const ASTFunctionDecl *FunctionDecl) {
+    FlatAST::NodeIndex I = Current();
+    AST->Operations[I] = FunctionDecl->GetReturnType();
+    SetString(I, FunctionDecl->GetName());
+    AddChildren(I, FunctionDecl->GetArguments());
+    AddChild(I, FunctionDecl->GetBody());
+  }
+
+  void Visit(const ASTFunctionCall *FunctionCall) {
+    FlatAST::NodeIndex I = Current();
+    SetString(I, FunctionCall->GetName());
+    AddChildren(I, FunctionCall->GetArguments());
+  }
+
+  void Visit(const ASTIfStmt *IfStmt) {
+    FlatAST::NodeIndex I = Current();
+    AddChild(I, IfStmt->GetCondition());
+    AddChild(I, IfStmt->GetThenBody());
+    AddChild(I, IfStmt->GetElseBody());
+  }
+
+  void Visit(const ASTIntegerLiteral *Integer) {
+    AST->Payloads[Current()] = static_cast<std::uint32_t>(Integer->GetValue());
+  }
+
+  void Visit(const ASTReturnStmt *ReturnStmt) {
+    AddChild(Current(), ReturnStmt->GetOperand());
+  }
+
+  void Visit(const ASTStringLiteral *String) {
+    SetString(Current(), String->GetValue());
+  }
+
+  void Visit(const ASTSymbol *Symbol) {
+    SetString(Current(), Symbol->GetName(), Symbol->GetDeclaration());
+  }
+
+  void Visit(const ASTUnaryOperator *Unary) {
+    FlatAST::NodeIndex I = Current();
+    AST->Operations[I] = Unary->GetOperation();
+    AddChild(I, Unary->GetOperand());
+  }
+
+  void Visit(const ASTVarDecl *VarDecl) {
+    FlatAST::NodeIndex I = Current();
+    AST->Operations[I] = VarDecl->GetDataType();
+    SetString(I, VarDecl->GetSymbolName(), VarDecl->GetDeclaration());
+    AddChild(I, VarDecl->GetDeclareBody());
+  }
+
+  void Visit(const ASTWhileStmt *WhileStmt) {
+    FlatAST::NodeIndex I = Current();
+    AddChild(I, WhileStmt->GetCondition());
+    AddChild(I, WhileStmt->GetBody());
+  }
+
+  FlatAST *AST;
+
+  /// Last added child of node, whose children are being added.
+  FlatAST::NodeIndex LastChild;
+};
+
+FlatAST::FlatAST(ASTNode *RootNode)
+    : Types(), LineNos(), ColumnNos(), FirstChildren(), NextSiblings(),
+      Payloads(), Operations(), Nodes(), Floats(), Strings(),
+      Declarations() {
+  assert(RootNode);
+  FlatASTBuilder(this).Add(RootNode);
+}
+
+FlatAST::NodeIndex FlatAST::GetChild(NodeIndex I, unsigned Index) const {
+  NodeIndex Child = FirstChildren[I];
+  for (; Index > 0U; --Index) {
+    assert(Child != None);
+    Child = NextSiblings[Child];
+  }
+  assert(Child != None);
+  return Child;
+}
+
+unsigned FlatAST::GetChildrenCount(NodeIndex I) const {
+  unsigned Count = 0U;
+  for (NodeIndex Child = FirstChildren[I]; Child != None;
+       Child = NextSiblings[Child])
+    ++Count;
+  return Count;
+}
+
+signed FlatAST::GetInteger(NodeIndex I) const {
+  assert(Types[I] == ASTType::INTEGER_LITERAL);
+  return static_cast<signed>(Payloads[I]);
+}
+
+bool FlatAST::GetBoolean(NodeIndex I) const {
+  assert(Types[I] == ASTType::BOOLEAN_LITERAL);
+  return Payloads[I] != 0U;
+}
+
+double FlatAST::GetFloat(NodeIndex I) const {
+  assert(Types[I] == ASTType::FLOATING_POINT_LITERAL);
+  return Floats[Payloads[I]];
+}
+
+std::string_view FlatAST::GetString(NodeIndex I) const {
+  assert(Types[I] == ASTType::STRING_LITERAL || Types[I] == ASTType::SYMBOL ||
+         Types[I] == ASTType::VAR_DECL ||
+         Types[I] == ASTType::FUNCTION_DECL ||
+         Types[I] == ASTType::FUNCTION_CALL);
+  return Strings[Payloads[I]];
+}
+
+unsigned FlatAST::GetDeclaration(NodeIndex I) const {
+  assert(Types[I] == ASTType::SYMBOL || Types[I] == ASTType::VAR_DECL);
+  return Declarations[Payloads[I]];
+}
+
+} // namespace frontEnd
+} // namespace weak
@@ -0,0 +1,267 @@
+/* CharClass.cpp - Character classification and bulk scanning for lexer.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Lex/CharClass.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define WEAK_COMPILER_HAVE_X86_SIMD 1
+#endif
+
+namespace weak {
+namespace frontEnd {
+namespace scan {
+
+const char *SkipWhitespaceScalar(const char *Ptr, const char *End) {
+  while (Ptr != End && IsSpace(*Ptr))
+    ++Ptr;
+  return Ptr;
+}
+
+const char *SkipIdentifierBodyScalar(const char *Ptr, const char *End) {
+  while (Ptr != End && IsIdentifierBody(*Ptr))
+    ++Ptr;
+  return Ptr;
+}
+
+static bool IsStringLiteralStop(char C) {
+  return C == '"' || C == '\\' || C == '\n' || C == '\0';
+}
+
+const char *SkipStringLiteralBodyScalar(const char *Ptr, const char *End) {
+  while (Ptr != End && !IsStringLiteralStop(*Ptr))
+    ++Ptr;
+  return Ptr;
+}
+
+std::size_t CountNewlinesScalar(const char *Ptr, const char *End) {
+  std::size_t Count = 0U;
+  for (; Ptr != End; ++Ptr)
+    Count += *Ptr == '\n';
+  return Count;
+}
+
+#if defined(WEAK_COMPILER_HAVE_X86_SIMD)
+
+/// SSE2 is a part of x86-64 baseline, so these functions are always
+/// available. AVX2 ones are compiled for the target only locally and
+/// called only if CPU reports support of them.
+
+static __m128i Load16(const char *Ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+}
+
+/// Bytes in range [Lo, Hi]. There is no unsigned byte comparison in SSE2,
+/// so X - Lo is shifted to the signed range and compared with Hi - Lo.
+static __m128i InRange16(__m128i X, char Lo, char Hi) {
+  __m128i Shifted = _mm_add_epi8(X, _mm_set1_epi8(char(0x80 - Lo)));
+  return _mm_cmpgt_epi8(_mm_set1_epi8(char(Hi - Lo - 127)), Shifted);
+}
+
+static unsigned WhitespaceMask16(__m128i X) {
+  __m128i Space = _mm_cmpeq_epi8(X, _mm_set1_epi8(' '));
+  __m128i Control = InRange16(X, '\t', '\r');
+  return _mm_movemask_epi8(_mm_or_si128(Space, Control));
+}
+
+static unsigned IdentifierBodyMask16(__m128i X) {
+  /// Clearing 0x20 bit maps lowercase letters to uppercase.
+  __m128i Upper = _mm_and_si128(X, _mm_set1_epi8(char(0xDF)));
+  __m128i Letter = InRange16(Upper, 'A', 'Z');
+  __m128i Digit = InRange16(X, '0', '9');
+  __m128i Underscore = _mm_cmpeq_epi8(X, _mm_set1_epi8('_'));
+  return _mm_movemask_epi8(
+      _mm_or_si128(_mm_or_si128(Letter, Digit), Underscore));
+}
+
+static unsigned StringLiteralStopMask16(__m128i X) {
+  __m128i Quote = _mm_cmpeq_epi8(X, _mm_set1_epi8('"'));
+  __m128i Backslash = _mm_cmpeq_epi8(X, _mm_set1_epi8('\\'));
+  __m128i Newline = _mm_cmpeq_epi8(X, _mm_set1_epi8('\n'));
+  __m128i Null = _mm_cmpeq_epi8(X, _mm_setzero_si128());
+  return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(Quote, Backslash),
+                                        _mm_or_si128(Newline, Null)));
+}
+
+static unsigned NewlineMask16(__m128i X) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(X, _mm_set1_epi8('\n')));
+}
+
+#define WEAK_COMPILER_AVX2 __attribute__((target("avx2")))
+
+WEAK_COMPILER_AVX2 static __m256i Load32(const char *Ptr) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Ptr));
+}
+
+WEAK_COMPILER_AVX2 static __m256i InRange32(__m256i X, char Lo, char Hi) {
+  __m256i Shifted = _mm256_add_epi8(X, _mm256_set1_epi8(char(0x80 - Lo)));
+  return _mm256_cmpgt_epi8(_mm256_set1_epi8(char(Hi - Lo - 127)), Shifted);
+}
+
+WEAK_COMPILER_AVX2 static unsigned WhitespaceMask32(__m256i X) {
+  __m256i Space = _mm256_cmpeq_epi8(X, _mm256_set1_epi8(' '));
+  __m256i Control = InRange32(X, '\t', '\r');
+  return _mm256_movemask_epi8(_mm256_or_si256(Space, Control));
+}
+
+WEAK_COMPILER_AVX2 static unsigned IdentifierBodyMask32(__m256i X) {
+  __m256i Upper = _mm256_and_si256(X, _mm256_set1_epi8(char(0xDF)));
+  __m256i Letter = InRange32(Upper, 'A', 'Z');
+  __m256i Digit = InRange32(X, '0', '9');
+  __m256i Underscore = _mm256_cmpeq_epi8(X, _mm256_set1_epi8('_'));
+  return _mm256_movemask_epi8(
+      _mm256_or_si256(_mm256_or_si256(Letter, Digit), Underscore));
+}
+
+WEAK_COMPILER_AVX2 static unsigned StringLiteralStopMask32(__m256i X) {
+  __m256i Quote = _mm256_cmpeq_epi8(X, _mm256_set1_epi8('"'));
+  __m256i Backslash = _mm256_cmpeq_epi8(X, _mm256_set1_epi8('\\'));
+  __m256i Newline = _mm256_cmpeq_epi8(X, _mm256_set1_epi8('\n'));
+  __m256i Null = _mm256_cmpeq_epi8(X, _mm256_setzero_si256());
+  return _mm256_movemask_epi8(_mm256_or_si256(
+      _mm256_or_si256(Quote, Backslash), _mm256_or_si256(Newline, Null)));
+}
+
+WEAK_COMPILER_AVX2 static unsigned NewlineMask32(__m256i X) {
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(X, _mm256_set1_epi8('\n')));
+}
+
+/// Checked once at startup rather than on each call. Static initializers
+/// may run before the one of libgcc, which fills CPU model data, so it is
+/// initialized explicitly.
+static bool DetectAVX2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+static const bool HaveAVX2Flag = DetectAVX2();
+
+static bool HaveAVX2() { return HaveAVX2Flag; }
+
+/// Generates SSE2 and AVX2 versions of function, that skips characters
+/// while Mask(X) has bits set (Invert = true) or until it has (Invert =
+/// false), and dispatcher between them. Most runs in real code are only a
+/// few characters long, so first characters are checked one by one with
+/// Stop predicate before loading vectors.
+#define WEAK_COMPILER_DEFINE_SKIP(Name, Mask, Invert, Stop)                   \
+  static const char *Name##SSE2(const char *Ptr, const char *End) {          \
+    for (; End - Ptr >= 16; Ptr += 16) {                                       \
+      unsigned Bits = Mask##16(Load16(Ptr));                                   \
+      if (Invert)                                                              \
+        Bits = ~Bits & 0xFFFFU;                                                \
+      if (Bits)                                                                \
+        return Ptr + __builtin_ctz(Bits);                                      \
+    }                                                                          \
+    return Name##Scalar(Ptr, End);                                             \
+  }                                                                            \
+                                                                               \
+  WEAK_COMPILER_AVX2 static const char *Name##AVX2(const char *Ptr,           \
+                                                   const char *End) {         \
+    for (; End - Ptr >= 32; Ptr += 32) {                                       \
+      unsigned Bits = Mask##32(Load32(Ptr));                                   \
+      if (Invert)                                                              \
+        Bits = ~Bits;                                                          \
+      if (Bits)                                                                \
+        return Ptr + __builtin_ctz(Bits);                                      \
+    }                                                                          \
+    return Name##SSE2(Ptr, End);                                               \
+  }                                                                            \
+                                                                               \
+  const char *Name(const char *Ptr, const char *End) {                         \
+    for (unsigned It = 0U; It < 4U; ++It, ++Ptr)                               \
+      if (Ptr == End || Stop(*Ptr))                                            \
+        return Ptr;                                                            \
+    return HaveAVX2() ? Name##AVX2(Ptr, End) : Name##SSE2(Ptr, End);           \
+  }
+
+static bool IsNotSpace(char C) { return !IsSpace(C); }
+
+static bool IsNotIdentifierBody(char C) { return !IsIdentifierBody(C); }
+
+WEAK_COMPILER_DEFINE_SKIP(SkipWhitespace, WhitespaceMask, true, IsNotSpace)
+WEAK_COMPILER_DEFINE_SKIP(SkipIdentifierBody, IdentifierBodyMask, true,
+                          IsNotIdentifierBody)
+WEAK_COMPILER_DEFINE_SKIP(SkipStringLiteralBody, StringLiteralStopMask, false,
+                          IsStringLiteralStop)
+
+#undef WEAK_COMPILER_DEFINE_SKIP
+
+static const char *FindNewlineScalar(const char *Ptr, const char *End) {
+  while (Ptr != End && *Ptr != '\n')
+    ++Ptr;
+  return Ptr;
+}
+
+static const char *FindNewlineSSE2(const char *Ptr, const char *End) {
+  for (; End - Ptr >= 16; Ptr += 16)
+    if (unsigned Bits = NewlineMask16(Load16(Ptr)))
+      return Ptr + __builtin_ctz(Bits);
+  return FindNewlineScalar(Ptr, End);
+}
+
+WEAK_COMPILER_AVX2 static const char *FindNewlineAVX2(const char *Ptr,
+                                                      const char *End) {
+  for (; End - Ptr >= 32; Ptr += 32)
+    if (unsigned Bits = NewlineMask32(Load32(Ptr)))
+      return Ptr + __builtin_ctz(Bits);
+  return FindNewlineSSE2(Ptr, End);
+}
+
+const char *FindNewline(const char *Ptr, const char *End) {
+  return HaveAVX2() ? FindNewlineAVX2(Ptr, End) : FindNewlineSSE2(Ptr, End);
+}
+
+static std::size_t CountNewlinesSSE2(const char *Ptr, const char *End) {
+  std::size_t Count = 0U;
+  for (; End - Ptr >= 16; Ptr += 16)
+    Count += __builtin_popcount(NewlineMask16(Load16(Ptr)));
+  return Count + CountNewlinesScalar(Ptr, End);
+}
+
+WEAK_COMPILER_AVX2 static std::size_t CountNewlinesAVX2(const char *Ptr,
+                                                        const char *End) {
+  std::size_t Count = 0U;
+  for (; End - Ptr >= 32; Ptr += 32)
+    Count += __builtin_popcount(NewlineMask32(Load32(Ptr)));
+  return Count + CountNewlinesSSE2(Ptr, End);
+}
+
+std::size_t CountNewlines(const char *Ptr, const char *End) {
+  return HaveAVX2() ? CountNewlinesAVX2(Ptr, End)
+                    : CountNewlinesSSE2(Ptr, End);
+}
+
+#undef WEAK_COMPILER_AVX2
+
+#else // !WEAK_COMPILER_HAVE_X86_SIMD
+
+const char *SkipWhitespace(const char *Ptr, const char *End) {
+  return SkipWhitespaceScalar(Ptr, End);
+}
+
+const char *SkipIdentifierBody(const char *Ptr, const char *End) {
+  return SkipIdentifierBodyScalar(Ptr, End);
+}
+
+const char *SkipStringLiteralBody(const char *Ptr, const char *End) {
+  return SkipStringLiteralBodyScalar(Ptr, End);
+}
+
+std::size_t CountNewlines(const char *Ptr, const char *End) {
+  return CountNewlinesScalar(Ptr, End);
+}
+
+const char *FindNewline(const char *Ptr, const char *End) {
+  while (Ptr != End && *Ptr != '\n')
+    ++Ptr;
+  return Ptr;
+}
+
+#endif // WEAK_COMPILER_HAVE_X86_SIMD
+
+} // namespace scan
+} // namespace frontEnd
+} // namespace weak
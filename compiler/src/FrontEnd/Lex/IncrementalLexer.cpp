@@ -0,0 +1,165 @@
+/* IncrementalLexer.cpp - Lexical analyzer, updating tokens after edit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Lex/IncrementalLexer.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace weak {
+namespace frontEnd {
+
+namespace {
+
+/// Free literal of token, which is replaced and not referred anymore.
+void RemoveLiteral(middleEnd::Storage *Storage, const Token &T) {
+  if (T.Type == TokenType::STRING_LITERAL && T.Payload != Token::NoPayload)
+    Storage->RemoveStringLiteral(T.Payload);
+  else if (T.Type == TokenType::FLOATING_POINT_LITERAL)
+    Storage->RemoveFloatingPointLiteral(T.Payload);
+}
+
+} // namespace
+
+std::string ApplyEdit(std::string_view Text, const TextEdit &Edit) {
+  assert(Edit.Offset + Edit.RemovedLength <= Text.size());
+  std::string Result;
+  Result.reserve(Text.size() - Edit.RemovedLength + Edit.InsertedText.size());
+  Result.append(Text.substr(0U, Edit.Offset));
+  Result.append(Edit.InsertedText);
+  Result.append(Text.substr(Edit.Offset + Edit.RemovedLength));
+  return Result;
+}
+
+IncrementalLexer::IncrementalLexer(middleEnd::Storage *TheStorage,
+                                   const SourceBuffer *TheBuffer)
+    : Storage(TheStorage), Buffer(TheBuffer), ErrorRecovery(false),
+      Diagnostics() {
+  assert(Storage);
+  assert(Buffer);
+}
+
+std::vector<Token> IncrementalLexer::Relex(std::vector<Token> Tokens,
+                                           const TextEdit &Edit) {
+  SourceLocation OldEditEnd = Edit.Offset + Edit.RemovedLength;
+  SourceLocation NewEditEnd = Edit.Offset + Edit.InsertedText.size();
+  SourceLocation BufferSize = Buffer->GetText().size();
+  assert(NewEditEnd <= BufferSize);
+  assert(Buffer->GetText().substr(Edit.Offset, Edit.InsertedText.size()) ==
+         Edit.InsertedText);
+
+  /// Lexer decides where token ends by the first character after it, so
+  /// token is not affected only if that character is before the edit.
+  auto Kept = std::partition_point(
+      Tokens.begin(), Tokens.end(),
+      [&](const Token &T) { return T.Loc + T.Length < Edit.Offset; });
+
+  /// Old tokens from unchanged text after the edit. Lexing can synchronize
+  /// only with them.
+  auto Old = std::partition_point(
+      Kept, Tokens.end(), [&](const Token &T) { return T.Loc < OldEditEnd; });
+
+  SourceLocation RelexBegin = 0U;
+  if (Kept != Tokens.begin())
+    RelexBegin = std::prev(Kept)->Loc + std::prev(Kept)->Length;
+
+  std::vector<Token> Relexed;
+  auto Synchronized = Tokens.end();
+  Lexer Lex(Storage, Buffer, RelexBegin, BufferSize);
+  if (ErrorRecovery)
+    Lex.EnableErrorRecovery();
+  for (Token T = Lex.Next(); T.Type != TokenType::NONE; T = Lex.Next()) {
+    if (T.Loc >= NewEditEnd) {
+      SourceLocation OldLoc = T.Loc - NewEditEnd + OldEditEnd;
+      while (Old != Tokens.end() && Old->Loc < OldLoc)
+        ++Old;
+      if (Old != Tokens.end() && Old->Loc == OldLoc) {
+        /// Old token is the same and is kept instead.
+        RemoveLiteral(Storage, T);
+        Synchronized = Old;
+        break;
+      }
+    }
+    Relexed.push_back(T);
+  }
+
+  /// Diagnostics of kept tokens stay at the same indices, ones of relexed
+  /// tokens follow them, and then the ones of the rest.
+  std::uint32_t OldSuffixErrors = 0U;
+  std::uint32_t NewSuffixErrors = 0U;
+  if (ErrorRecovery) {
+    std::vector<LexDiagnostic> OldDiagnostics = std::move(Diagnostics);
+    /// Diagnostic is located inside its ERROR token or right after it, so
+    /// ones of kept tokens are found by position, unless the last kept
+    /// token is ERROR and ends at the same position.
+    std::size_t PrefixErrors =
+        std::partition_point(OldDiagnostics.begin(), OldDiagnostics.end(),
+                             [&](const LexDiagnostic &D) {
+                               return D.Loc < RelexBegin;
+                             }) -
+        OldDiagnostics.begin();
+    if (Kept != Tokens.begin() && std::prev(Kept)->Type == TokenType::ERROR)
+      PrefixErrors = std::prev(Kept)->Payload + 1U;
+    auto IsError = [](const Token &T) { return T.Type == TokenType::ERROR; };
+    OldSuffixErrors =
+        PrefixErrors + std::count_if(Kept, Synchronized, IsError);
+
+    Diagnostics.assign(
+        std::make_move_iterator(OldDiagnostics.begin()),
+        std::make_move_iterator(OldDiagnostics.begin() + PrefixErrors));
+    for (Token &T : Relexed) {
+      if (T.Type != TokenType::ERROR)
+        continue;
+      Diagnostics.push_back(Lex.GetDiagnostics()[T.Payload]);
+      T.Payload = Diagnostics.size() - 1U;
+    }
+    NewSuffixErrors = Diagnostics.size();
+    for (auto It = OldDiagnostics.begin() + OldSuffixErrors;
+         It != OldDiagnostics.end(); ++It) {
+      It->Loc = It->Loc - OldEditEnd + NewEditEnd;
+      Diagnostics.push_back(std::move(*It));
+    }
+  }
+
+  std::for_each(Kept, Synchronized,
+                [this](const Token &T) { RemoveLiteral(Storage, T); });
+
+  /// Replace tokens between kept and synchronized ones with relexed, then
+  /// shift the rest.
+  std::size_t SuffixStart = (Kept - Tokens.begin()) + Relexed.size();
+  std::size_t Removed = Synchronized - Kept;
+  if (Relexed.size() <= Removed) {
+    std::copy(Relexed.begin(), Relexed.end(), Kept);
+    Tokens.erase(Kept + Relexed.size(), Synchronized);
+  } else {
+    std::copy(Relexed.begin(), Relexed.begin() + Removed, Kept);
+    Tokens.insert(Synchronized, Relexed.begin() + Removed, Relexed.end());
+  }
+
+  if (OldEditEnd != NewEditEnd || OldSuffixErrors != NewSuffixErrors)
+    for (auto It = Tokens.begin() + SuffixStart; It != Tokens.end(); ++It) {
+      It->Loc = It->Loc - OldEditEnd + NewEditEnd;
+      if (It->Type == TokenType::ERROR)
+        It->Payload = It->Payload - OldSuffixErrors + NewSuffixErrors;
+    }
+
+  return Tokens;
+}
+
+void IncrementalLexer::EnableErrorRecovery(
+    std::vector<LexDiagnostic> OldDiagnostics) {
+  ErrorRecovery = true;
+  Diagnostics = std::move(OldDiagnostics);
+}
+
+const std::vector<LexDiagnostic> &IncrementalLexer::GetDiagnostics() const {
+  return Diagnostics;
+}
+
+} // namespace frontEnd
+} // namespace weak
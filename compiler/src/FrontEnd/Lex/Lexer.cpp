@@ -5,15 +5,27 @@
  */
 
 #include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/CharClass.hpp"
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "Utility/Diagnostic.hpp"
-#include <algorithm>
+#include <array>
 #include <cassert>
-#include <unordered_map>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
 
 using TokenType = weak::frontEnd::TokenType;
 
-static const std::unordered_map<std::string_view, TokenType> LexKeywords = {
+namespace {
+
+struct Keyword {
+  std::string_view Spelling;
+  TokenType Type;
+};
+
+constexpr Keyword LexKeywords[] = {
     {"bool", TokenType::BOOLEAN},  {"break", TokenType::BREAK},
     {"char", TokenType::CHAR},     {"continue", TokenType::CONTINUE},
     {"do", TokenType::DO},         {"else", TokenType::ELSE},
@@ -23,57 +35,137 @@ static const std::unordered_map<std::string_view, TokenType> LexKeywords = {
     {"string", TokenType::STRING}, {"true", TokenType::TRUE},
     {"void", TokenType::VOID},     {"while", TokenType::WHILE}};
 
-static const std::unordered_map<std::string_view, TokenType> LexOperators = {
-    {"=", TokenType::ASSIGN},
-    {"*=", TokenType::MUL_ASSIGN},
-    {"/=", TokenType::DIV_ASSIGN},
-    {"%=", TokenType::MOD_ASSIGN},
-    {"+=", TokenType::PLUS_ASSIGN},
-    {"-=", TokenType::MINUS_ASSIGN},
-    {"<<=", TokenType::SHL_ASSIGN},
-    {">>=", TokenType::SHR_ASSIGN},
-    {"&=", TokenType::BIT_AND_ASSIGN},
-    {"|=", TokenType::BIT_OR_ASSIGN},
-    {"^=", TokenType::XOR_ASSIGN},
-    {"&&", TokenType::AND},
-    {"||", TokenType::OR},
-    {"^", TokenType::XOR},
-    {"&", TokenType::BIT_AND},
-    {"|", TokenType::BIT_OR},
-    {"==", TokenType::EQ},
-    {"!=", TokenType::NEQ},
-    {">", TokenType::GT},
-    {"<", TokenType::LT},
-    {">=", TokenType::GE},
-    {"<=", TokenType::LE},
-    {">>", TokenType::SHR},
-    {"<<", TokenType::SHL},
-    {"+", TokenType::PLUS},
-    {"-", TokenType::MINUS},
-    {"*", TokenType::STAR},
-    {"/", TokenType::SLASH},
-    {"%", TokenType::MOD},
-    {"++", TokenType::INC},
-    {"--", TokenType::DEC},
-    {",", TokenType::COMMA},
-    {";", TokenType::SEMICOLON},
-    {"!", TokenType::NOT},
-    {"[", TokenType::OPEN_BOX_BRACKET},
-    {"]", TokenType::CLOSE_BOX_BRACKET},
-    {"{", TokenType::OPEN_CURLY_BRACKET},
-    {"}", TokenType::CLOSE_CURLY_BRACKET},
-    {"(", TokenType::OPEN_PAREN},
-    {")", TokenType::CLOSE_PAREN}};
+constexpr unsigned KeywordTableSize = 32U;
+
+/// Perfect hash of keywords: each one gets its own slot, so lookup is
+/// one hash computation and one comparison. Coefficients were picked to
+/// make it collision-free; this is verified below at compile time.
+constexpr unsigned KeywordHash(std::string_view Symbol) {
+  return (Symbol.size() + 3U * static_cast<unsigned char>(Symbol.front()) +
+          24U * static_cast<unsigned char>(Symbol.back())) %
+         KeywordTableSize;
+}
+
+constexpr std::array<Keyword, KeywordTableSize> MakeKeywordTable() {
+  std::array<Keyword, KeywordTableSize> Table{};
+  for (const Keyword &K : LexKeywords)
+    Table[KeywordHash(K.Spelling)] = K;
+  return Table;
+}
+
+constexpr std::array<Keyword, KeywordTableSize> KeywordTable =
+    MakeKeywordTable();
+
+constexpr bool IsKeywordHashPerfect() {
+  for (const Keyword &K : LexKeywords)
+    if (KeywordTable[KeywordHash(K.Spelling)].Type != K.Type)
+      return false;
+  return true;
+}
+
+static_assert(IsKeywordHashPerfect(), "Keyword hash has collisions");
+
+/// \return keyword type or NONE if Symbol is not a keyword.
+TokenType LookupKeyword(std::string_view Symbol) {
+  const Keyword &K = KeywordTable[KeywordHash(Symbol)];
+  return K.Spelling == Symbol ? K.Type : TokenType::NONE;
+}
+
+struct OperatorMatch {
+  TokenType Type;
+  unsigned Length;
+};
+
+/// Longest operator at the beginning of input, or NONE. Relies on buffer
+/// null-terminator, so characters past the first are read only if the
+/// previous ones matched.
+OperatorMatch MatchOperator(const char *Ptr) {
+  /// Select one of the operators depending on the following character.
+  auto Either = [Ptr](char Next, TokenType Long, TokenType Short) {
+    return Ptr[1] == Next ? OperatorMatch{Long, 2U} : OperatorMatch{Short, 1U};
+  };
+
+  switch (Ptr[0]) {
+  case '=':
+    return Either('=', TokenType::EQ, TokenType::ASSIGN);
+  case '*':
+    return Either('=', TokenType::MUL_ASSIGN, TokenType::STAR);
+  case '/':
+    return Either('=', TokenType::DIV_ASSIGN, TokenType::SLASH);
+  case '%':
+    return Either('=', TokenType::MOD_ASSIGN, TokenType::MOD);
+  case '^':
+    return Either('=', TokenType::XOR_ASSIGN, TokenType::XOR);
+  case '!':
+    return Either('=', TokenType::NEQ, TokenType::NOT);
+  case '+':
+    if (Ptr[1] == '+')
+      return {TokenType::INC, 2U};
+    return Either('=', TokenType::PLUS_ASSIGN, TokenType::PLUS);
+  case '-':
+    if (Ptr[1] == '-')
+      return {TokenType::DEC, 2U};
+    return Either('=', TokenType::MINUS_ASSIGN, TokenType::MINUS);
+  case '&':
+    if (Ptr[1] == '&')
+      return {TokenType::AND, 2U};
+    return Either('=', TokenType::BIT_AND_ASSIGN, TokenType::BIT_AND);
+  case '|':
+    if (Ptr[1] == '|')
+      return {TokenType::OR, 2U};
+    return Either('=', TokenType::BIT_OR_ASSIGN, TokenType::BIT_OR);
+  case '<':
+    if (Ptr[1] == '<')
+      return Ptr[2] == '=' ? OperatorMatch{TokenType::SHL_ASSIGN, 3U}
+                           : OperatorMatch{TokenType::SHL, 2U};
+    return Either('=', TokenType::LE, TokenType::LT);
+  case '>':
+    if (Ptr[1] == '>')
+      return Ptr[2] == '=' ? OperatorMatch{TokenType::SHR_ASSIGN, 3U}
+                           : OperatorMatch{TokenType::SHR, 2U};
+    return Either('=', TokenType::GE, TokenType::GT);
+  case ',':
+    return {TokenType::COMMA, 1U};
+  case ';':
+    return {TokenType::SEMICOLON, 1U};
+  case '[':
+    return {TokenType::OPEN_BOX_BRACKET, 1U};
+  case ']':
+    return {TokenType::CLOSE_BOX_BRACKET, 1U};
+  case '{':
+    return {TokenType::OPEN_CURLY_BRACKET, 1U};
+  case '}':
+    return {TokenType::CLOSE_CURLY_BRACKET, 1U};
+  case '(':
+    return {TokenType::OPEN_PAREN, 1U};
+  case ')':
+    return {TokenType::CLOSE_PAREN, 1U};
+  default:
+    return {TokenType::NONE, 0U};
+  }
+}
+
+/// Character, which cannot start any token.
+bool IsUnknownCharacter(const char *Ptr) {
+  using namespace weak::frontEnd;
+  return CharClassTable[static_cast<unsigned char>(*Ptr)] == CHAR_NONE &&
+         *Ptr != '\"' && MatchOperator(Ptr).Type == TokenType::NONE;
+}
+
+} // namespace
 
 namespace {
 
+/// Checks below return error message, or nullptr if input is correct.
+
 class LexStringLiteralCheck {
 public:
   explicit LexStringLiteralCheck(char ThePeek) : Peek(ThePeek) {}
 
-  void ClosingQuoteCheck(unsigned LineNo, unsigned ColumnNo) const {
+  const char *ClosingQuoteCheck() const {
     if (Peek == '\n' || Peek == '\0')
-      weak::CompileError(LineNo, ColumnNo) << "Closing \" expected";
+      return "Closing \" expected";
+    return nullptr;
   }
 
 private:
@@ -82,248 +174,313 @@ private:
 
 class LexDigitCheck {
 public:
-  LexDigitCheck(const std::string &TheDigit, char ThePeek, unsigned Dots)
+  LexDigitCheck(std::string_view TheDigit, char ThePeek, unsigned Dots)
       : Digit(TheDigit), Peek(ThePeek), DotsReached(Dots) {}
 
-  void LastDigitRequire(unsigned LineNo, unsigned ColumnNo) const {
-    if (std::isalpha(Peek) || !std::isdigit(Digit.back()))
-      weak::CompileError(LineNo, ColumnNo)
-          << "Digit as last character expected";
+  const char *LastDigitRequire() const {
+    if (weak::frontEnd::IsLetter(Peek) ||
+        !weak::frontEnd::IsDigit(Digit.back()))
+      return "Digit as last character expected";
+    return nullptr;
   }
 
-  void ExactOneDotRequire(unsigned LineNo, unsigned ColumnNo) const {
+  const char *ExactOneDotRequire() const {
     if (DotsReached > 1)
-      weak::CompileError(LineNo, ColumnNo) << "Extra \".\" in digit";
+      return "Extra \".\" in digit";
+    return nullptr;
   }
 
 private:
-  const std::string &Digit;
+  std::string_view Digit;
   char Peek;
   unsigned DotsReached;
 };
 
-} // namespace
-
-static bool IsAlphanumeric(char C) { return isalpha(C) || C == '_'; }
-
-static void NormalizeColumnPosition(std::string_view Data,
-                                    weak::frontEnd::TokenType Type,
-                                    unsigned &ColumnNo) {
-  using weak::frontEnd::TokenType;
-  using namespace std::string_view_literals;
-  static constexpr std::array TokenLengths{
-      std::make_pair(TokenType::BOOLEAN, "bool"sv.length()),
-      std::make_pair(TokenType::BREAK, "break"sv.length()),
-      std::make_pair(TokenType::CHAR, "char"sv.length()),
-      std::make_pair(TokenType::CONTINUE, "continue"sv.length()),
-      std::make_pair(TokenType::DO, "do"sv.length()),
-      std::make_pair(TokenType::ELSE, "else"sv.length()),
-      std::make_pair(TokenType::FALSE, "false"sv.length()),
-      std::make_pair(TokenType::FLOAT, "float"sv.length()),
-      std::make_pair(TokenType::FOR, "for"sv.length()),
-      std::make_pair(TokenType::IF, "if"sv.length()),
-      std::make_pair(TokenType::INT, "int"sv.length()),
-      std::make_pair(TokenType::RETURN, "return"sv.length()),
-      std::make_pair(TokenType::STRING, "string"sv.length()),
-      std::make_pair(TokenType::TRUE, "true"sv.length()),
-      std::make_pair(TokenType::VOID, "void"sv.length()),
-      std::make_pair(TokenType::WHILE, "while"sv.length())};
-
-  if (const auto *It =
-          std::find_if(TokenLengths.begin(), TokenLengths.end(),
-                       [&](const auto &Pair) { return Type == Pair.first; });
-      It != TokenLengths.end()) {
-    ColumnNo -= It->second;
-  } else {
-    switch (Type) {
-    case TokenType::INTEGRAL_LITERAL:
-    case TokenType::FLOATING_POINT_LITERAL:
-    case TokenType::SYMBOL:
-      ColumnNo -= Data.length();
-      break;
-    case TokenType::STRING_LITERAL:
-      ColumnNo -= (Data.length() + 2 /* Quotes. */);
-      break;
-    default:
-      break;
-    }
-  }
+/// Convert 8 ASCII digits to number with a few multiplications instead
+/// of 8 dependent ones (SWAR). Pairs of digits are combined first, then
+/// pairs of pairs, and so on.
+std::uint32_t DecodeEightDigits(const char *Ptr) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::uint64_t Value;
+  std::memcpy(&Value, Ptr, sizeof(Value));
+  Value -= 0x3030303030303030U;
+  Value = (Value * 10U) + (Value >> 8U);
+  Value =
+      (((Value & 0x000000FF000000FFU) * (100U + (1000000ULL << 32U))) +
+       (((Value >> 16U) & 0x000000FF000000FFU) * (1U + (10000ULL << 32U)))) >>
+      32U;
+  return static_cast<std::uint32_t>(Value);
+#else
+  std::uint32_t Value = 0U;
+  for (const char *End = Ptr + 8; Ptr != End; ++Ptr)
+    Value = Value * 10U + (*Ptr - '0');
+  return Value;
+#endif
 }
 
+} // namespace
+
 namespace weak {
 namespace frontEnd {
 
-Lexer::Lexer(weak::middleEnd::Storage *TheStorage, const char *TheBufferStart,
-             const char *TheBufferEnd)
-    : Storage(TheStorage), BufferStart(TheBufferStart), BufferEnd(TheBufferEnd),
-      CurrentBufferPtr(TheBufferStart), CurrentLineNo(0U), CurrentColumnNo(0U) {
+/// This is the only place in the lexer, where line and column are
+/// computed.
+void ReportLexError(const SourceBuffer *Buffer, const LexDiagnostic &D) {
+  auto [LineNo, ColumnNo] = Buffer->GetLineAndColumn(D.Loc);
+  CompileError(LineNo - 1, ColumnNo - 1) << D.Message.c_str();
+  UnreachablePoint();
+}
+
+Lexer::Lexer(weak::middleEnd::Storage *TheStorage,
+             const SourceBuffer *TheBuffer)
+    : Storage(TheStorage), Buffer(TheBuffer),
+      BufferStart(TheBuffer->GetBufferStart()),
+      BufferEnd(TheBuffer->GetBufferEnd()), CurrentBufferPtr(BufferStart),
+      ErrorRecovery(false), Diagnostics() {
   assert(BufferStart);
   assert(BufferEnd);
   assert(BufferStart <= BufferEnd);
 }
 
+Lexer::Lexer(weak::middleEnd::Storage *TheStorage,
+             const SourceBuffer *TheBuffer, SourceLocation Begin,
+             SourceLocation End)
+    : Storage(TheStorage), Buffer(TheBuffer),
+      BufferStart(TheBuffer->GetBufferStart()), BufferEnd(BufferStart + End),
+      CurrentBufferPtr(BufferStart + Begin), ErrorRecovery(false),
+      Diagnostics() {
+  assert(Begin <= End);
+  assert(End <= TheBuffer->GetText().size());
+  assert(End == TheBuffer->GetText().size() || BufferStart[End - 1] == '\n');
+}
+
 std::vector<Token> Lexer::Analyze() {
   std::vector<Token> ProcessedTokens;
 
-  long InputSize = std::distance(BufferStart, BufferEnd);
-  ProcessedTokens.reserve(InputSize / 2);
+  for (Token T = Next(); T.Type != TokenType::NONE; T = Next())
+    ProcessedTokens.push_back(T);
 
+  return ProcessedTokens;
+}
+
+Token Lexer::Next() {
   while (CurrentBufferPtr != BufferEnd) {
-    if (char Atom = PeekCurrent(); std::isdigit(Atom)) {
-      ProcessedTokens.push_back(AnalyzeDigit());
-    } else if (std::isalpha(Atom)) {
-      ProcessedTokens.push_back(AnalyzeSymbol());
-    } else if (Atom == '\"') {
-      ProcessedTokens.push_back(AnalyzeStringLiteral());
-    } else if (std::isspace(Atom)) {
-      PeekNext();
+    char Atom = PeekCurrent();
+    std::uint8_t Class = CharClassTable[static_cast<unsigned char>(Atom)];
+
+    if (Class & CHAR_SPACE) {
+      CurrentBufferPtr = scan::SkipWhitespace(CurrentBufferPtr, BufferEnd);
       continue;
-    } else {
-      ProcessedTokens.push_back(AnalyzeOperator());
     }
+
+    if (Class & CHAR_DIGIT)
+      return AnalyzeDigit();
+    if (Class & CHAR_LETTER)
+      return AnalyzeSymbol();
+    if (Atom == '\"')
+      return AnalyzeStringLiteral();
+    return AnalyzeOperator();
   }
 
-  return ProcessedTokens;
+  return MakeToken(TokenType::NONE, BufferEnd);
 }
 
 Token Lexer::AnalyzeDigit() {
-  std::string Digit;
-  bool DotErrorOccurred = false;
-  unsigned DotErrorColumn = 0U;
+  const char *DigitStart = CurrentBufferPtr;
+  const char *DotErrorPosition = nullptr;
   unsigned DotsReached = 0U;
 
-  while (std::isdigit(PeekCurrent()) || PeekCurrent() == '.') {
+  while (IsDigit(PeekCurrent()) || PeekCurrent() == '.') {
     if (PeekCurrent() == '.')
       ++DotsReached;
     if (DotsReached > 1) {
-      DotErrorOccurred = true;
-      DotErrorColumn = CurrentColumnNo;
+      DotErrorPosition = CurrentBufferPtr;
       break;
     }
-    Digit += PeekNext();
+    PeekNext();
   }
 
-  unsigned LexColumnName = DotErrorOccurred ? DotErrorColumn : CurrentColumnNo;
+  std::string_view Digit(DigitStart, CurrentBufferPtr - DigitStart);
+  const char *ErrorPosition =
+      DotErrorPosition ? DotErrorPosition : CurrentBufferPtr;
 
   LexDigitCheck Checker(Digit, PeekCurrent(), DotsReached);
-  Checker.LastDigitRequire(CurrentLineNo, LexColumnName);
-  Checker.ExactOneDotRequire(CurrentLineNo, LexColumnName);
+  const char *Error = Checker.LastDigitRequire();
+  if (!Error)
+    Error = Checker.ExactOneDotRequire();
+
+  if (Error) {
+    /// Skip the rest of malformed literal to continue right after it.
+    while (IsIdentifierBody(PeekCurrent()) || PeekCurrent() == '.')
+      PeekNext();
+    return MakeError(DigitStart, ErrorPosition, Error);
+  }
+
+  if (DotsReached == 0U) {
+    std::optional<signed> Value = DecodeIntegral(Digit);
+    if (!Value)
+      return MakeError(DigitStart, DigitStart,
+                       "Integral literal is out of range: " +
+                           std::string(Digit));
+    return MakeToken(TokenType::INTEGRAL_LITERAL, DigitStart,
+                     static_cast<std::uint32_t>(*Value));
+  }
+
+  std::optional<double> Value = DecodeFloatingPoint(Digit);
+  if (!Value)
+    return MakeError(DigitStart, DigitStart,
+                     "Floating point literal is out of range: " +
+                         std::string(Digit));
+  return MakeToken(TokenType::FLOATING_POINT_LITERAL, DigitStart,
+                   Storage->AddFloatingPointLiteral(*Value));
+}
+
+std::optional<signed> Lexer::DecodeIntegral(std::string_view Digit) const {
+  constexpr std::uint64_t Max = std::numeric_limits<signed>::max();
+  const char *Ptr = Digit.data();
+  const char *End = Ptr + Digit.size();
+  std::uint64_t Value = 0U;
+
+  /// Value is checked after each step, so it is never greater than
+  /// Max * 10^8 + 10^8, which fits in 64 bits.
+  for (; End - Ptr >= 8 && Value <= Max; Ptr += 8)
+    Value = Value * 100000000U + DecodeEightDigits(Ptr);
 
-  return MakeToken(Digit, DotsReached == 0U
-                              ? TokenType::INTEGRAL_LITERAL
-                              : TokenType::FLOATING_POINT_LITERAL);
+  for (; Ptr != End && Value <= Max; ++Ptr)
+    Value = Value * 10U + (*Ptr - '0');
+
+  if (Value > Max)
+    return std::nullopt;
+
+  return static_cast<signed>(Value);
+}
+
+std::optional<double>
+Lexer::DecodeFloatingPoint(std::string_view Digit) const {
+  const char *End = Digit.data() + Digit.size();
+  double Value = 0.0;
+
+  /// Correctly rounded, and without intermediate std::string, as
+  /// std::stod would require.
+  auto [Ptr, Errc] = std::from_chars(Digit.data(), End, Value);
+  if (Errc == std::errc::result_out_of_range)
+    return std::nullopt;
+  assert(Errc == std::errc{} && Ptr == End);
+
+  return Value;
 }
 
 Token Lexer::AnalyzeStringLiteral() {
+  const char *QuoteStart = CurrentBufferPtr;
   PeekNext(); // Eat "
 
-  if (PeekNext() == '\"') {
-    return MakeToken("", TokenType::STRING_LITERAL);
-  }
-  --CurrentBufferPtr;
+  const char *LiteralStart = CurrentBufferPtr;
+  bool HasEscapes = false;
 
-  std::string Literal;
-  while (PeekCurrent() != '\"') {
-    Literal += PeekNext();
+  /// Plain characters are skipped in bulk, so only escapes and
+  /// terminators are examined one by one. End of buffer is checked as
+  /// null-terminator, which always follows the buffer.
+  while (true) {
+    CurrentBufferPtr =
+        scan::SkipStringLiteralBody(CurrentBufferPtr, BufferEnd);
+    char Atom = PeekCurrent();
+    if (Atom == '\"')
+      break;
 
-    LexStringLiteralCheck Check(PeekCurrent());
-    Check.ClosingQuoteCheck(CurrentLineNo, CurrentColumnNo);
+    if (Atom == '\\') {
+      HasEscapes = true;
+      PeekNext();
+    }
 
-    if (Literal.back() == '\\')
-      Literal.back() = PeekNext();
+    LexStringLiteralCheck Check(PeekCurrent());
+    if (const char *Error = Check.ClosingQuoteCheck())
+      return MakeError(QuoteStart, CurrentBufferPtr, Error);
+    PeekNext();
   }
   assert(PeekCurrent() == '\"');
 
+  std::string_view Literal(LiteralStart, CurrentBufferPtr - LiteralStart);
+
   PeekNext(); // Eat "
-  --CurrentColumnNo;
 
-  return MakeToken(Literal, TokenType::STRING_LITERAL);
+  if (!HasEscapes)
+    return MakeToken(TokenType::STRING_LITERAL, QuoteStart, Token::NoPayload);
+
+  /// Slow path. Since unescaped literal differs from source text,
+  /// it cannot be taken from source and should be stored separately.
+  std::string Unescaped;
+  Unescaped.reserve(Literal.length());
+  for (auto It = Literal.begin(); It != Literal.end(); ++It) {
+    if (*It == '\\')
+      ++It;
+    Unescaped += *It;
+  }
+
+  return MakeToken(TokenType::STRING_LITERAL, QuoteStart,
+                   Storage->AddStringLiteral(std::move(Unescaped)));
 }
 
 Token Lexer::AnalyzeSymbol() {
-  std::string Symbol;
-
-  while ((IsAlphanumeric(PeekCurrent()) || std::isdigit(PeekCurrent())))
-    Symbol += PeekNext();
+  const char *SymbolStart = CurrentBufferPtr;
 
-  if (LexKeywords.find(Symbol) != LexKeywords.end())
-    return MakeToken("", LexKeywords.at(Symbol));
+  CurrentBufferPtr = scan::SkipIdentifierBody(CurrentBufferPtr, BufferEnd);
 
-  unsigned Attribute = Storage->AddSymbol(Symbol);
+  std::string_view Symbol(SymbolStart, CurrentBufferPtr - SymbolStart);
 
-  unsigned LineNo = CurrentLineNo + 1;
-  unsigned ColumnNo = CurrentColumnNo + 1;
+  if (TokenType Type = LookupKeyword(Symbol); Type != TokenType::NONE)
+    return MakeToken(Type, SymbolStart);
 
-  NormalizeColumnPosition(Symbol, TokenType::SYMBOL, ColumnNo);
-  Token T(std::move(Symbol), TokenType::SYMBOL, LineNo, ColumnNo, Attribute);
-  return T;
+  return MakeToken(TokenType::SYMBOL, SymbolStart, Storage->AddSymbol(Symbol));
 }
 
 Token Lexer::AnalyzeOperator() {
-  std::string Operator(1, PeekNext());
-  unsigned SavedColumnNo = 0U;
-  bool SearchFailed = false;
-  char WrongOperator = '\0';
+  const char *OperatorStart = CurrentBufferPtr;
+  auto [Type, Length] = MatchOperator(OperatorStart);
 
-  while (true) {
-    if (LexOperators.find(Operator) == LexOperators.end()) {
-      WrongOperator = Operator.front();
-      Operator.pop_back();
-      --CurrentBufferPtr;
-
-      if (CurrentColumnNo > 0U)
-        --CurrentColumnNo;
-
-      if (PeekCurrent() == '\n')
-        --CurrentLineNo;
+  if (Type == TokenType::NONE) {
+    /// Whole run of unknown characters is reported once.
+    do
+      PeekNext();
+    while (CurrentBufferPtr != BufferEnd &&
+           IsUnknownCharacter(CurrentBufferPtr));
+    return MakeError(OperatorStart, OperatorStart,
+                     "Unknown character sequence: " +
+                         std::string(OperatorStart, CurrentBufferPtr));
+  }
 
-      SearchFailed = true;
-      break;
-    }
+  CurrentBufferPtr += Length;
+  return MakeToken(Type, OperatorStart);
+}
 
-    char Next = *CurrentBufferPtr++;
-    SavedColumnNo = CurrentColumnNo;
-    if (Next == '\n') {
-      CurrentColumnNo = 0U;
-      CurrentLineNo++;
-    }
-    ++CurrentColumnNo;
-    Operator += Next;
-  }
+middleEnd::Storage *Lexer::GetStorage() const { return Storage; }
 
-  if (SearchFailed && !Operator.empty()) {
-    return Token("", LexOperators.at(Operator), CurrentLineNo + 1,
-                 SavedColumnNo - Operator.length() + 1);
-  }
+void Lexer::EnableErrorRecovery() { ErrorRecovery = true; }
 
-  --CurrentColumnNo;
-  CompileError(CurrentLineNo, CurrentColumnNo)
-      << "Unknown character sequence: " << WrongOperator;
-  UnreachablePoint();
+const std::vector<LexDiagnostic> &Lexer::GetDiagnostics() const {
+  return Diagnostics;
 }
 
-char Lexer::PeekNext() {
-  char Atom = *CurrentBufferPtr++;
-  if (Atom == '\n') {
-    CurrentLineNo++;
-    CurrentColumnNo = 0U;
-  } else {
-    CurrentColumnNo++;
-  }
-  return Atom;
-}
+char Lexer::PeekNext() { return *CurrentBufferPtr++; }
 
 char Lexer::PeekCurrent() const { return *CurrentBufferPtr; }
 
-Token Lexer::MakeToken(std::string_view Data, TokenType Type) const {
-  unsigned LineNo = CurrentLineNo + 1;
-  unsigned ColumnNo = CurrentColumnNo + 1;
+Token Lexer::MakeError(const char *TokenStart, const char *Position,
+                       std::string Message) {
+  LexDiagnostic Diagnostic{static_cast<SourceLocation>(Position - BufferStart),
+                           std::move(Message)};
+  if (!ErrorRecovery)
+    ReportLexError(Buffer, Diagnostic);
 
-  NormalizeColumnPosition(Data, Type, ColumnNo);
-  Token T(Data, Type, LineNo, ColumnNo);
+  Diagnostics.push_back(std::move(Diagnostic));
+  return MakeToken(TokenType::ERROR, TokenStart, Diagnostics.size() - 1U);
+}
 
-  return T;
+Token Lexer::MakeToken(TokenType Type, const char *TokenStart,
+                       std::uint32_t Payload) const {
+  return Token{Type, static_cast<SourceLocation>(TokenStart - BufferStart),
+               static_cast<std::uint32_t>(CurrentBufferPtr - TokenStart),
+               Payload};
 }
 
 } // namespace frontEnd
-} // namespace weak
\ No newline at end of file
+} // namespace weak
@@ -0,0 +1,150 @@
+/* ParallelLexer.cpp - Lexical analyzer, splitting input between threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Lex/ParallelLexer.hpp"
+#include "FrontEnd/Lex/CharClass.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace weak {
+namespace frontEnd {
+
+ParallelLexer::ParallelLexer(middleEnd::Storage *TheStorage,
+                             const SourceBuffer *TheBuffer,
+                             ThreadPool *ThePool,
+                             SourceLocation TheMinChunkSize)
+    : Storage(TheStorage), Buffer(TheBuffer), Pool(ThePool),
+      MinChunkSize(TheMinChunkSize), ErrorRecovery(false), Diagnostics() {
+  assert(Storage);
+  assert(Buffer);
+  assert(Pool);
+  assert(MinChunkSize > 0U);
+}
+
+std::vector<ParallelLexer::Chunk> ParallelLexer::SplitToChunks() const {
+  const char *Start = Buffer->GetBufferStart();
+  const char *End = Buffer->GetBufferEnd();
+  SourceLocation Size = End - Start;
+
+  SourceLocation TargetSize =
+      std::max(MinChunkSize, Size / Pool->TotalThreads() + 1U);
+
+  /// String literal cannot contain newline, even escaped one, so every
+  /// newline is outside any token and it is the only thing to look for.
+  std::vector<Chunk> Chunks;
+  SourceLocation Begin = 0U;
+  while (Size - Begin > TargetSize) {
+    const char *Newline = scan::FindNewline(Start + Begin + TargetSize, End);
+    if (Newline == End)
+      break;
+    SourceLocation ChunkEnd = Newline - Start + 1U;
+    Chunks.emplace_back(Begin, ChunkEnd);
+    Begin = ChunkEnd;
+  }
+  Chunks.emplace_back(Begin, Size);
+  return Chunks;
+}
+
+std::vector<Token> ParallelLexer::Analyze() {
+  std::vector<Chunk> Chunks = SplitToChunks();
+
+  if (Chunks.size() == 1U) {
+    Lexer Lex(Storage, Buffer);
+    if (ErrorRecovery)
+      Lex.EnableErrorRecovery();
+    std::vector<Token> Tokens = Lex.Analyze();
+    Diagnostics = Lex.GetDiagnostics();
+    return Tokens;
+  }
+
+  struct ChunkResult {
+    std::unique_ptr<middleEnd::Storage> LocalStorage;
+    std::vector<Token> Tokens;
+    std::vector<LexDiagnostic> Diagnostics;
+  };
+  std::vector<ChunkResult> Results(Chunks.size());
+
+  for (std::size_t I = 0U; I < Chunks.size(); ++I) {
+    Pool->Submit([this, &Chunks, &Results, I] {
+      auto &[LocalStorage, Tokens, LocalDiagnostics] = Results[I];
+      LocalStorage = std::make_unique<middleEnd::Storage>();
+      auto [Begin, End] = Chunks[I];
+      Lexer Lex(LocalStorage.get(), Buffer, Begin, End);
+      Lex.EnableErrorRecovery();
+      Tokens = Lex.Analyze();
+      LocalDiagnostics = Lex.GetDiagnostics();
+    });
+  }
+  Pool->Wait();
+
+  /// Symbols are merged strictly in chunk order, so each of them gets the
+  /// same attribute as with sequential lexing, where attributes are
+  /// assigned in order of first occurrence. Literal pools are appended in
+  /// the same order, so indices of literals are also the same.
+  std::vector<std::vector<unsigned>> AttributeMaps;
+  std::vector<middleEnd::Storage::LiteralOffsets> LiteralOffsets;
+  std::vector<unsigned> DiagnosticOffsets;
+  std::vector<std::size_t> Offsets;
+  std::size_t TotalTokens = 0U;
+  Diagnostics.clear();
+  for (ChunkResult &R : Results) {
+    AttributeMaps.push_back(Storage->MergeSymbols(*R.LocalStorage));
+    LiteralOffsets.push_back(Storage->MergeLiterals(*R.LocalStorage));
+    DiagnosticOffsets.push_back(Diagnostics.size());
+    Diagnostics.insert(Diagnostics.end(), R.Diagnostics.begin(),
+                       R.Diagnostics.end());
+    Offsets.push_back(TotalTokens);
+    TotalTokens += R.Tokens.size();
+  }
+
+  if (!ErrorRecovery && !Diagnostics.empty())
+    ReportLexError(Buffer, Diagnostics.front());
+
+  std::vector<Token> Tokens(TotalTokens, Token{});
+  for (std::size_t I = 0U; I < Chunks.size(); ++I) {
+    Pool->Submit([&Results, &AttributeMaps, &LiteralOffsets,
+                  &DiagnosticOffsets, &Offsets, &Tokens, I] {
+      Token *Output = Tokens.data() + Offsets[I];
+      auto [StringOffset, FloatingPointOffset] = LiteralOffsets[I];
+      for (Token T : Results[I].Tokens) {
+        switch (T.Type) {
+        case TokenType::SYMBOL:
+          T.Payload = AttributeMaps[I][T.Payload];
+          break;
+        case TokenType::FLOATING_POINT_LITERAL:
+          T.Payload += FloatingPointOffset;
+          break;
+        case TokenType::STRING_LITERAL:
+          if (T.Payload != Token::NoPayload)
+            T.Payload += StringOffset;
+          break;
+        case TokenType::ERROR:
+          T.Payload += DiagnosticOffsets[I];
+          break;
+        default:
+          break;
+        }
+        *Output++ = T;
+      }
+    });
+  }
+  Pool->Wait();
+
+  return Tokens;
+}
+
+void ParallelLexer::EnableErrorRecovery() { ErrorRecovery = true; }
+
+const std::vector<LexDiagnostic> &ParallelLexer::GetDiagnostics() const {
+  return Diagnostics;
+}
+
+} // namespace frontEnd
+} // namespace weak
@@ -0,0 +1,167 @@
+/* SourceManager.cpp - Owner of all source buffers.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Lex/CharClass.hpp"
+#include "Utility/Diagnostic.hpp"
+#include <algorithm>
+#include <cassert>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace weak {
+namespace frontEnd {
+
+SourceBuffer::SourceBuffer(std::string_view TheName, std::string_view TheText)
+    : Name(TheName), Text(TheText), LineOffsets() {
+  /// Lexer reads one character past the end.
+  assert(Text.data() && Text.data()[Text.size()] == '\0');
+  if (Text.size() > std::numeric_limits<SourceLocation>::max()) {
+    CompileError() << "File too large: " << Name;
+    UnreachablePoint();
+  }
+}
+
+std::string_view SourceBuffer::GetName() const { return Name; }
+
+std::string_view SourceBuffer::GetText() const { return Text; }
+
+const char *SourceBuffer::GetBufferStart() const { return Text.data(); }
+
+const char *SourceBuffer::GetBufferEnd() const {
+  return Text.data() + Text.size();
+}
+
+std::pair<unsigned, unsigned>
+SourceBuffer::GetLineAndColumn(SourceLocation Loc) const {
+  if (LineOffsets.empty())
+    ComputeLineOffsets();
+
+  assert(Loc <= Text.size());
+  auto Line = std::upper_bound(LineOffsets.begin(), LineOffsets.end(), Loc);
+  --Line;
+
+  unsigned LineNo = std::distance(LineOffsets.begin(), Line) + 1;
+  unsigned ColumnNo = Loc - *Line + 1;
+  return {LineNo, ColumnNo};
+}
+
+unsigned SourceBuffer::GetLineNo(SourceLocation Loc) const {
+  return GetLineAndColumn(Loc).first;
+}
+
+unsigned SourceBuffer::GetColumnNo(SourceLocation Loc) const {
+  return GetLineAndColumn(Loc).second;
+}
+
+void SourceBuffer::ComputeLineOffsets() const {
+  const char *Start = GetBufferStart();
+  const char *End = GetBufferEnd();
+
+  LineOffsets.reserve(scan::CountNewlines(Start, End) + 1);
+  LineOffsets.push_back(0U);
+
+  for (const char *Ptr = scan::FindNewline(Start, End); Ptr != End;
+       Ptr = scan::FindNewline(Ptr + 1, End))
+    LineOffsets.push_back(Ptr - Start + 1);
+}
+
+SourceManager::~SourceManager() {
+  for (const auto &E : Entries)
+    if (E->MappedAddress)
+      munmap(E->MappedAddress, E->MappedSize);
+}
+
+FileID SourceManager::AddFile(std::string_view Path) {
+  std::string PathString(Path);
+  int Descriptor = open(PathString.c_str(), O_RDONLY);
+  if (Descriptor < 0) {
+    CompileError() << "Cannot open file: " << Path;
+    UnreachablePoint();
+  }
+
+  struct stat Stat {};
+  if (fstat(Descriptor, &Stat) < 0 || !S_ISREG(Stat.st_mode)) {
+    FileID ID = ReadFromDescriptor(Path, Descriptor);
+    close(Descriptor);
+    return ID;
+  }
+
+  auto Size = static_cast<std::size_t>(Stat.st_size);
+  auto PageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+  /// The rest of the last page is filled with zeros by mmap(), and gives
+  /// us null-terminator. If file ends exactly at the page boundary,
+  /// there is no such guarantee. Empty files cannot be mapped at all.
+  if (Size == 0U || Size % PageSize == 0U) {
+    FileID ID = ReadFromDescriptor(Path, Descriptor);
+    close(Descriptor);
+    return ID;
+  }
+
+  void *Address = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+  close(Descriptor);
+
+  if (Address == MAP_FAILED) {
+    CompileError() << "Cannot map file: " << Path;
+    UnreachablePoint();
+  }
+
+  auto E = std::make_unique<Entry>();
+  E->MappedAddress = Address;
+  E->MappedSize = Size;
+  E->Buffer = std::make_unique<SourceBuffer>(
+      Path, std::string_view(static_cast<const char *>(Address), Size));
+  return AddEntry(std::move(E));
+}
+
+FileID SourceManager::AddStdin() {
+  return ReadFromDescriptor("<stdin>", STDIN_FILENO);
+}
+
+FileID SourceManager::AddBuffer(std::string_view Name, std::string Text) {
+  auto E = std::make_unique<Entry>();
+  E->Content = std::move(Text);
+  E->Buffer = std::make_unique<SourceBuffer>(Name, E->Content);
+  return AddEntry(std::move(E));
+}
+
+const SourceBuffer *SourceManager::GetBuffer(FileID ID) const {
+  assert(ID < Entries.size());
+  return Entries[ID]->Buffer.get();
+}
+
+unsigned SourceManager::TotalBuffers() const { return Entries.size(); }
+
+FileID SourceManager::AddEntry(std::unique_ptr<Entry> &&E) {
+  Entries.push_back(std::move(E));
+  return Entries.size() - 1;
+}
+
+FileID SourceManager::ReadFromDescriptor(std::string_view Name,
+                                         int Descriptor) {
+  std::string Content;
+  char Chunk[4096];
+
+  while (true) {
+    ssize_t Read = read(Descriptor, Chunk, sizeof(Chunk));
+    if (Read == 0)
+      break;
+    if (Read < 0) {
+      CompileError() << "Cannot read file: " << Name;
+      UnreachablePoint();
+    }
+    Content.append(Chunk, static_cast<std::size_t>(Read));
+  }
+
+  return AddBuffer(Name, std::move(Content));
+}
+
+} // namespace frontEnd
+} // namespace weak
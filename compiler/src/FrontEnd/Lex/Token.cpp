@@ -5,11 +5,15 @@
  */
 
 #include "FrontEnd/Lex/Token.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include <cassert>
 
 using namespace weak::frontEnd;
 
 const char *weak::frontEnd::TokenToString(TokenType Type) {
   switch (Type) {
+  case TokenType::ERROR:
+    return "<ERROR>";
   case TokenType::BOOLEAN:
     return "<BOOLEAN>";
   case TokenType::BREAK:
@@ -135,15 +139,35 @@ const char *weak::frontEnd::TokenToString(TokenType Type) {
   }
 }
 
-Token::Token(std::string_view TheData, TokenType TheType, unsigned TheLineNo,
-             unsigned TheColumnNo, unsigned TheAttribute)
-    : Data(TheData), Type(TheType), LineNo(TheLineNo), ColumnNo(TheColumnNo),
-      Attribute(TheAttribute) {}
-
 bool Token::operator==(const Token &rhs) const {
-  return (Data == rhs.Data) && (Type == rhs.Type);
+  return Type == rhs.Type && Loc == rhs.Loc && Length == rhs.Length &&
+         Payload == rhs.Payload;
+}
+
+bool Token::operator!=(const Token &rhs) const { return !(*this == rhs); }
+
+std::string_view weak::frontEnd::GetTokenText(const SourceBuffer *Buffer,
+                                              const Token &T) {
+  return Buffer->GetText().substr(T.Loc, T.Length);
+}
+
+std::string_view weak::frontEnd::GetStringLiteral(const SourceBuffer *Buffer,
+                                                  const middleEnd::Storage *S,
+                                                  const Token &T) {
+  assert(T.Type == TokenType::STRING_LITERAL);
+  if (T.Payload != Token::NoPayload)
+    return S->GetStringLiteral(T.Payload);
+  /// Strip quotes.
+  return Buffer->GetText().substr(T.Loc + 1U, T.Length - 2U);
+}
+
+signed weak::frontEnd::GetIntegralValue(const Token &T) {
+  assert(T.Type == TokenType::INTEGRAL_LITERAL);
+  return static_cast<signed>(T.Payload);
 }
 
-bool Token::operator!=(const Token &rhs) const {
-  return (Data != rhs.Data) || (Type != rhs.Type);
+double weak::frontEnd::GetFloatingPointValue(const middleEnd::Storage *S,
+                                             const Token &T) {
+  assert(T.Type == TokenType::FLOATING_POINT_LITERAL);
+  return S->GetFloatingPointLiteral(T.Payload);
 }
@@ -0,0 +1,166 @@
+/* IncrementalParser.cpp - Syntax analyzer, reusing functions after edit.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Parse/IncrementalParser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+using namespace weak::frontEnd;
+
+namespace weak {
+namespace frontEnd {
+
+IncrementalParser::IncrementalParser(std::size_t TheMinGarbageSize)
+    : Context(std::make_unique<ASTContext>()), Text(), Functions(),
+      FunctionsByHash(), MinGarbageSize(TheMinGarbageSize), ReusedCount(0U),
+      ErrorRecovery(false), ErrorLimit(Parser::DefaultErrorLimit),
+      DepthLimit(0U), Diagnostics() {}
+
+IncrementalParser::~IncrementalParser() = default;
+
+ASTCompoundStmt *IncrementalParser::Reparse(const SourceBuffer *Source,
+                                            const middleEnd::Storage *Storage,
+                                            const Token *BufferStart,
+                                            const Token *BufferEnd) {
+  CollectGarbage();
+
+  std::string_view NewText = Source->GetText();
+  std::vector<TokenRange> Ranges = SplitToFunctions(BufferStart, BufferEnd);
+  /// Unbalanced brackets are syntax error, so whole input is parsed as one
+  /// range to report it.
+  if (Ranges.empty() && BufferStart != BufferEnd)
+    Ranges.emplace_back(BufferStart, BufferEnd);
+
+  std::vector<Function> NewFunctions;
+  std::vector<ASTNode *> GlobalEntities;
+  ReusedCount = 0U;
+  Diagnostics.clear();
+  /// Index of the first declaration of the next function.
+  unsigned Declarations = 0U;
+
+  for (auto [Begin, End] : Ranges) {
+    const Token &Last = *(End - 1);
+    Function F;
+    F.Offset = Begin->Loc;
+    F.Length = Last.Loc + Last.Length - Begin->Loc;
+    std::tie(F.LineNo, F.ColumnNo) = Source->GetLineAndColumn(F.Offset);
+    std::string_view FunctionText = NewText.substr(F.Offset, F.Length);
+    F.Hash = std::hash<std::string_view>{}(FunctionText);
+    F.FirstDeclaration = Declarations;
+    bool Reused = false;
+
+    /// Hash only selects candidates, text is compared to be sure.
+    auto Found = FunctionsByHash.find(F.Hash);
+    if (Found != FunctionsByHash.end()) {
+      std::vector<std::size_t> &Candidates = Found->second;
+      for (auto It = Candidates.rbegin(); It != Candidates.rend(); ++It) {
+        const Function &Old = Functions[*It];
+        if (Old.ColumnNo != F.ColumnNo || Old.Length != F.Length ||
+            std::string_view(Text).substr(Old.Offset, Old.Length) !=
+                FunctionText)
+          continue;
+        if (Old.LineNo != F.LineNo ||
+            Old.FirstDeclaration != F.FirstDeclaration)
+          for (ASTNode *Node : Old.Nodes)
+            ShiftSubtree(Node, F.LineNo - Old.LineNo,
+                         F.FirstDeclaration - Old.FirstDeclaration);
+        F.TotalDeclarations = Old.TotalDeclarations;
+        F.Bytes = Old.Bytes;
+        F.Nodes = Old.Nodes;
+        F.Diagnostics = Old.Diagnostics;
+        for (ParseDiagnostic &D : F.Diagnostics)
+          D.Loc = D.Loc - Old.Offset + F.Offset;
+        Reused = true;
+        ++ReusedCount;
+        /// Subtree cannot be in two places.
+        Candidates.erase(std::next(It).base());
+        break;
+      }
+    }
+
+    if (!Reused)
+      ParseFunction(F, Source, Storage, {Begin, End});
+    Declarations += F.TotalDeclarations;
+
+    GlobalEntities.insert(GlobalEntities.end(), F.Nodes.begin(),
+                          F.Nodes.end());
+    Diagnostics.insert(Diagnostics.end(), F.Diagnostics.begin(),
+                       F.Diagnostics.end());
+    NewFunctions.push_back(std::move(F));
+  }
+  if (Diagnostics.size() > ErrorLimit)
+    Diagnostics.resize(ErrorLimit);
+
+  Text = NewText;
+  Functions = std::move(NewFunctions);
+  FunctionsByHash.clear();
+  for (std::size_t I = Functions.size(); I > 0U; --I)
+    FunctionsByHash[Functions[I - 1U].Hash].push_back(I - 1U);
+
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(GlobalEntities));
+}
+
+void IncrementalParser::EnableErrorRecovery(unsigned TheErrorLimit) {
+  assert(TheErrorLimit > 0U);
+  ErrorRecovery = true;
+  ErrorLimit = TheErrorLimit;
+}
+
+void IncrementalParser::EnableDepthLimit(unsigned TheDepthLimit) {
+  assert(TheDepthLimit > 0U);
+  DepthLimit = TheDepthLimit;
+}
+
+const std::vector<ParseDiagnostic> &IncrementalParser::GetDiagnostics() const {
+  return Diagnostics;
+}
+
+std::size_t IncrementalParser::GetFunctionHash(unsigned Index) const {
+  assert(Index < Functions.size());
+  return Functions[Index].Hash;
+}
+
+unsigned IncrementalParser::GetReusedCount() const { return ReusedCount; }
+
+void IncrementalParser::ParseFunction(Function &F,
+                                      const SourceBuffer *Source,
+                                      const middleEnd::Storage *Storage,
+                                      TokenRange Range) {
+  std::size_t AllocatedBefore = Context->TotalAllocated();
+  Parser Parse(Context.get(), Source, Storage, Range.first, Range.second);
+  if (ErrorRecovery)
+    Parse.EnableErrorRecovery(ErrorLimit);
+  if (DepthLimit > 0U)
+    Parse.EnableDepthLimit(DepthLimit);
+  Parse.SetFirstDeclaration(F.FirstDeclaration);
+  /// Range ends after function body, so without errors it holds exactly
+  /// one function.
+  F.Nodes = Parse.Parse()->GetStmts();
+  F.TotalDeclarations = Parse.TotalDeclarations();
+  F.Bytes = Context->TotalAllocated() - AllocatedBefore;
+  F.Diagnostics = Parse.GetDiagnostics();
+}
+
+void IncrementalParser::CollectGarbage() {
+  std::size_t LiveBytes = 0U;
+  for (const Function &F : Functions)
+    LiveBytes += F.Bytes;
+  std::size_t GarbageBytes = Context->TotalAllocated() - LiveBytes;
+  if (GarbageBytes <= LiveBytes || GarbageBytes < MinGarbageSize)
+    return;
+  Context = std::make_unique<ASTContext>();
+  Functions.clear();
+  FunctionsByHash.clear();
+}
+
+} // namespace frontEnd
+} // namespace weak
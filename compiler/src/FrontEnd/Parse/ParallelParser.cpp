@@ -0,0 +1,141 @@
+/* ParallelParser.cpp - Syntax analyzer, splitting input between threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "FrontEnd/Parse/ParallelParser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "Utility/ThreadPool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace weak {
+namespace frontEnd {
+
+ParallelParser::ParallelParser(ASTContext *TheContext,
+                               const SourceBuffer *TheSource,
+                               const middleEnd::Storage *TheStorage,
+                               const Token *TheBufferStart,
+                               const Token *TheBufferEnd, ThreadPool *ThePool,
+                               std::size_t TheMinChunkSize)
+    : Context(TheContext), Source(TheSource), Storage(TheStorage),
+      BufferStart(TheBufferStart), BufferEnd(TheBufferEnd), Pool(ThePool),
+      MinChunkSize(TheMinChunkSize), ErrorRecovery(false),
+      ErrorLimit(Parser::DefaultErrorLimit), DepthLimit(0U), Diagnostics() {
+  assert(Context);
+  assert(Source);
+  assert(Storage);
+  assert(BufferStart <= BufferEnd);
+  assert(Pool);
+  assert(MinChunkSize > 0U);
+}
+
+std::vector<ParallelParser::Chunk> ParallelParser::SplitToChunks() const {
+  std::size_t Size = BufferEnd - BufferStart;
+  std::size_t TargetSize =
+      std::max(MinChunkSize, Size / Pool->TotalThreads() + 1U);
+
+  std::vector<Chunk> Chunks;
+  for (auto [Begin, End] : SplitToFunctions(BufferStart, BufferEnd)) {
+    if (!Chunks.empty() &&
+        static_cast<std::size_t>(Chunks.back().second - Chunks.back().first) <
+            TargetSize)
+      Chunks.back().second = End;
+    else
+      Chunks.emplace_back(Begin, End);
+  }
+  return Chunks;
+}
+
+ASTCompoundStmt *ParallelParser::Parse() {
+  std::vector<Chunk> Chunks = SplitToChunks();
+
+  if (Chunks.size() <= 1U) {
+    Parser Parse(Context, Source, Storage, BufferStart, BufferEnd);
+    if (ErrorRecovery)
+      Parse.EnableErrorRecovery(ErrorLimit);
+    if (DepthLimit > 0U)
+      Parse.EnableDepthLimit(DepthLimit);
+    ASTCompoundStmt *AST = Parse.Parse();
+    Diagnostics = Parse.GetDiagnostics();
+    return AST;
+  }
+
+  /// Line table of source buffer is built lazily on first request, so
+  /// build it before buffer is shared between threads.
+  Source->GetLineNo(0U);
+
+  struct ChunkResult {
+    std::unique_ptr<ASTContext> LocalContext;
+    ASTCompoundStmt *Functions;
+    std::vector<ParseDiagnostic> Diagnostics;
+    unsigned TotalDeclarations;
+  };
+  std::vector<ChunkResult> Results(Chunks.size());
+
+  for (std::size_t I = 0U; I < Chunks.size(); ++I) {
+    Pool->Submit([this, &Chunks, &Results, I] {
+      auto &[LocalContext, Functions, LocalDiagnostics, Declarations] =
+          Results[I];
+      LocalContext = std::make_unique<ASTContext>();
+      auto [Begin, End] = Chunks[I];
+      Parser Parse(LocalContext.get(), Source, Storage, Begin, End);
+      Parse.EnableErrorRecovery(ErrorLimit);
+      if (DepthLimit > 0U)
+        Parse.EnableDepthLimit(DepthLimit);
+      Functions = Parse.Parse();
+      LocalDiagnostics = Parse.GetDiagnostics();
+      Declarations = Parse.TotalDeclarations();
+    });
+  }
+  Pool->Wait();
+
+  /// Chunks number declarations from zero, so they are shifted by count
+  /// of declarations in chunks before.
+  unsigned FirstDeclaration = 0U;
+  for (ChunkResult &R : Results) {
+    if (FirstDeclaration > 0U)
+      Pool->Submit([&R, FirstDeclaration] {
+        ShiftSubtree(R.Functions, /*LineDelta=*/0U, FirstDeclaration);
+      });
+    FirstDeclaration += R.TotalDeclarations;
+  }
+  Pool->Wait();
+
+  std::vector<ASTNode *> GlobalEntities;
+  Diagnostics.clear();
+  for (ChunkResult &R : Results) {
+    for (ASTNode *Function : R.Functions->GetStmts())
+      GlobalEntities.push_back(Function);
+    Context->Adopt(*R.LocalContext);
+    Diagnostics.insert(Diagnostics.end(), R.Diagnostics.begin(),
+                       R.Diagnostics.end());
+  }
+  if (Diagnostics.size() > ErrorLimit)
+    Diagnostics.resize(ErrorLimit);
+
+  if (!ErrorRecovery && !Diagnostics.empty())
+    ReportParseError(Source, Diagnostics.front());
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(GlobalEntities));
+}
+
+void ParallelParser::EnableErrorRecovery(unsigned TheErrorLimit) {
+  assert(TheErrorLimit > 0U);
+  ErrorRecovery = true;
+  ErrorLimit = TheErrorLimit;
+}
+
+void ParallelParser::EnableDepthLimit(unsigned TheDepthLimit) {
+  assert(TheDepthLimit > 0U);
+  DepthLimit = TheDepthLimit;
+}
+
+const std::vector<ParseDiagnostic> &ParallelParser::GetDiagnostics() const {
+  return Diagnostics;
+}
+
+} // namespace frontEnd
+} // namespace weak
@@ -9,8 +9,10 @@
 #include "FrontEnd/AST/ASTBooleanLiteral.hpp"
 #include "FrontEnd/AST/ASTBreakStmt.hpp"
 #include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
 #include "FrontEnd/AST/ASTContinueStmt.hpp"
 #include "FrontEnd/AST/ASTDoWhileStmt.hpp"
+#include "FrontEnd/AST/ASTErrorNode.hpp"
 #include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
 #include "FrontEnd/AST/ASTForStmt.hpp"
 #include "FrontEnd/AST/ASTFunctionCall.hpp"
@@ -24,129 +26,328 @@
 #include "FrontEnd/AST/ASTUnaryOperator.hpp"
 #include "FrontEnd/AST/ASTVarDecl.hpp"
 #include "FrontEnd/AST/ASTWhileStmt.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
 #include "Utility/Diagnostic.hpp"
+#include <array>
 #include <cassert>
-
-static std::string
-TokensToString(const std::vector<weak::frontEnd::TokenType> &Tokens) {
-  std::string result;
-
-  for (const auto &T : Tokens) {
-    result += "(";
-    result += TokenToString(T);
-    result += ")";
-    result += ", ";
-  }
-
-  if (!result.empty()) {
-    result.pop_back();
-    result.pop_back();
+#include <cstdint>
+#include <string>
+
+namespace {
+
+/// Binding strength of binary operators, from the weakest one.
+namespace Precedence {
+enum : unsigned {
+  None,
+  Assignment,
+  LogicalOr,
+  LogicalAnd,
+  InclusiveOr,
+  ExclusiveOr,
+  And,
+  Equality,
+  Relational,
+  Shift,
+  Additive,
+  Multiplicative
+};
+} // namespace Precedence
+
+using weak::frontEnd::ASTNode;
+using weak::frontEnd::ASTSymbol;
+using weak::frontEnd::ASTVarDecl;
+using weak::frontEnd::RecursiveASTVisitor;
+using weak::frontEnd::TokenSet;
+using weak::frontEnd::TokenType;
+
+/// \see weak::frontEnd::ShiftSubtree.
+class SubtreeShifter
+    : public RecursiveASTVisitor<SubtreeShifter, /*IsConst=*/false> {
+public:
+  using RecursiveASTVisitor::Visit;
+
+  SubtreeShifter(unsigned TheLineDelta, unsigned TheDeclarationDelta)
+      : LineDelta(TheLineDelta), DeclarationDelta(TheDeclarationDelta) {}
+
+  /// Nullable nodes are skipped.
+  void Traverse(ASTNode *Node) {
+    if (!Node)
+      return;
+    Node->SetLineNo(Node->GetLineNo() + LineDelta);
+    RecursiveASTVisitor::Traverse(Node);
+  }
+
+  void Visit(ASTVarDecl *VarDecl) {
+    if (VarDecl->GetDeclaration() != ASTVarDecl::NoDeclaration)
+      VarDecl->SetDeclaration(VarDecl->GetDeclaration() + DeclarationDelta);
+    RecursiveASTVisitor::Visit(VarDecl);
+  }
+
+  void Visit(ASTSymbol *Symbol) {
+    if (Symbol->GetDeclaration() != ASTVarDecl::NoDeclaration)
+      Symbol->SetDeclaration(Symbol->GetDeclaration() + DeclarationDelta);
+  }
+
+private:
+  unsigned LineDelta;
+  unsigned DeclarationDelta;
+};
+
+using PrecedenceTable = std::array<unsigned char, 256U>;
+
+constexpr PrecedenceTable MakePrecedenceTable() {
+  PrecedenceTable Table{};
+  auto Set = [&](TokenType T, unsigned P) {
+    Table[static_cast<std::uint8_t>(T)] = P;
+  };
+  Set(TokenType::ASSIGN, Precedence::Assignment);
+  Set(TokenType::MUL_ASSIGN, Precedence::Assignment);
+  Set(TokenType::DIV_ASSIGN, Precedence::Assignment);
+  Set(TokenType::MOD_ASSIGN, Precedence::Assignment);
+  Set(TokenType::PLUS_ASSIGN, Precedence::Assignment);
+  Set(TokenType::MINUS_ASSIGN, Precedence::Assignment);
+  Set(TokenType::SHL_ASSIGN, Precedence::Assignment);
+  Set(TokenType::SHR_ASSIGN, Precedence::Assignment);
+  Set(TokenType::BIT_AND_ASSIGN, Precedence::Assignment);
+  Set(TokenType::BIT_OR_ASSIGN, Precedence::Assignment);
+  Set(TokenType::XOR_ASSIGN, Precedence::Assignment);
+  Set(TokenType::OR, Precedence::LogicalOr);
+  Set(TokenType::AND, Precedence::LogicalAnd);
+  Set(TokenType::BIT_OR, Precedence::InclusiveOr);
+  Set(TokenType::XOR, Precedence::ExclusiveOr);
+  Set(TokenType::BIT_AND, Precedence::And);
+  Set(TokenType::EQ, Precedence::Equality);
+  Set(TokenType::NEQ, Precedence::Equality);
+  Set(TokenType::GT, Precedence::Relational);
+  Set(TokenType::LT, Precedence::Relational);
+  Set(TokenType::GE, Precedence::Relational);
+  Set(TokenType::LE, Precedence::Relational);
+  Set(TokenType::SHL, Precedence::Shift);
+  Set(TokenType::SHR, Precedence::Shift);
+  Set(TokenType::PLUS, Precedence::Additive);
+  Set(TokenType::MINUS, Precedence::Additive);
+  Set(TokenType::STAR, Precedence::Multiplicative);
+  Set(TokenType::SLASH, Precedence::Multiplicative);
+  Set(TokenType::MOD, Precedence::Multiplicative);
+  return Table;
+}
+
+constexpr PrecedenceTable BinaryPrecedence = MakePrecedenceTable();
+
+/// \return precedence of binary operator or Precedence::None.
+unsigned GetBinaryPrecedence(TokenType T) {
+  return BinaryPrecedence[static_cast<std::uint8_t>(T)];
+}
+
+/// Return types, that start global entity.
+constexpr TokenSet FunctionBegin = {TokenType::VOID, TokenType::INT,
+                                    TokenType::CHAR, TokenType::STRING,
+                                    TokenType::BOOLEAN};
+
+/// Tokens, accepted by ParseConstant().
+constexpr TokenSet Literals = {
+    TokenType::INTEGRAL_LITERAL, TokenType::FLOATING_POINT_LITERAL,
+    TokenType::STRING_LITERAL, TokenType::FALSE, TokenType::TRUE};
+
+/// Tokens allowed after function call argument.
+constexpr TokenSet ArgumentSeparators = {TokenType::COMMA,
+                                         TokenType::CLOSE_PAREN};
+
+/// List expected tokens for error message. Called only on failure, so it
+/// is fine to build string here.
+std::string TokensToString(TokenSet Tokens) {
+  std::string Result;
+  for (unsigned I = 0U; I < TokenSet::Capacity; ++I) {
+    auto T = static_cast<TokenType>(I);
+    if (!Tokens.Contains(T))
+      continue;
+    if (!Result.empty())
+      Result += ", ";
+    Result += "(";
+    Result += TokenToString(T);
+    Result += ")";
   }
-
-  return result;
+  return Result;
 }
 
+} // namespace
+
 namespace weak {
 namespace frontEnd {
 
-Parser::Parser(const Token *TheBufferStart, const Token *TheBufferEnd)
-    : BufferStart(TheBufferStart), BufferEnd(TheBufferEnd),
-      CurrentBufferPtr(BufferStart), LoopsDepth(0U) {
-  assert(BufferStart);
-  assert(BufferEnd);
+void ReportParseError(const SourceBuffer *Buffer, const ParseDiagnostic &D) {
+  auto [LineNo, ColumnNo] = Buffer->GetLineAndColumn(D.Loc);
+  CompileError(LineNo - 1, ColumnNo - 1) << D.Message.c_str();
+  UnreachablePoint();
+}
+
+void PrintParseErrors(const SourceBuffer *Buffer,
+                      const std::vector<ParseDiagnostic> &D) {
+  for (const ParseDiagnostic &Diagnostic : D) {
+    auto [LineNo, ColumnNo] = Buffer->GetLineAndColumn(Diagnostic.Loc);
+    PrintError(LineNo - 1, ColumnNo - 1, Diagnostic.Message.c_str());
+  }
+}
+
+std::vector<TokenRange> SplitToFunctions(const Token *Begin,
+                                         const Token *End) {
+  std::vector<TokenRange> Functions;
+  const Token *FunctionBegin = Begin;
+  unsigned Depth = 0U;
+  for (const Token *Current = Begin; Current != End; ++Current) {
+    switch (Current->Type) {
+    case TokenType::OPEN_CURLY_BRACKET:
+      ++Depth;
+      break;
+    case TokenType::CLOSE_CURLY_BRACKET:
+      if (Depth == 0U)
+        return {};
+      if (--Depth == 0U) {
+        Functions.emplace_back(FunctionBegin, Current + 1);
+        FunctionBegin = Current + 1;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  if (Depth != 0U)
+    return {};
+  if (FunctionBegin != End)
+    Functions.emplace_back(FunctionBegin, End);
+  return Functions;
+}
+
+void ShiftSubtree(ASTNode *Root, unsigned LineDelta,
+                  unsigned DeclarationDelta) {
+  SubtreeShifter(LineDelta, DeclarationDelta).Traverse(Root);
+}
+
+Parser::Parser(ASTContext *TheContext, const SourceBuffer *TheSource,
+               Lexer *TheLexer)
+    : Context(TheContext), Source(TheSource), Storage(TheLexer->GetStorage()),
+      TokenSource(TheLexer), BufferStart(nullptr), BufferEnd(nullptr),
+      CurrentBufferPtr(nullptr),
+      Lookahead{MakeEndToken(), MakeEndToken()}, LookaheadStart(0U),
+      LookaheadCount(0U), Declarations(), FirstDeclaration(0U),
+      LoopsDepth(0U), NestingDepth(0U), DepthLimit(0U),
+      BinaryOperands(), BinaryOperators(), ErrorRecovery(false),
+      ErrorLimit(DefaultErrorLimit), Panicking(false), Stopped(false),
+      Diagnostics() {
+  assert(Context);
+  assert(Source);
+  assert(Storage);
+  assert(TokenSource);
+}
+
+Parser::Parser(ASTContext *TheContext, const SourceBuffer *TheSource,
+               const middleEnd::Storage *TheStorage,
+               const Token *TheBufferStart, const Token *TheBufferEnd)
+    : Context(TheContext), Source(TheSource), Storage(TheStorage),
+      TokenSource(nullptr),
+      BufferStart(TheBufferStart), BufferEnd(TheBufferEnd),
+      CurrentBufferPtr(BufferStart),
+      Lookahead{MakeEndToken(), MakeEndToken()}, LookaheadStart(0U),
+      LookaheadCount(0U), Declarations(), FirstDeclaration(0U),
+      LoopsDepth(0U), NestingDepth(0U), DepthLimit(0U),
+      BinaryOperands(), BinaryOperators(), ErrorRecovery(false),
+      ErrorLimit(DefaultErrorLimit), Panicking(false), Stopped(false),
+      Diagnostics() {
+  assert(Context);
+  assert(Source);
+  assert(Storage);
   assert(BufferStart <= BufferEnd);
 }
 
-std::unique_ptr<ASTCompoundStmt> Parser::Parse() {
-  std::vector<std::unique_ptr<ASTNode>> GlobalEntities;
-  while (CurrentBufferPtr != BufferEnd) {
+ASTCompoundStmt *Parser::Parse() {
+  std::vector<ASTNode *> GlobalEntities;
+  while (!Stopped && PeekAhead(0U).Type != TokenType::NONE) {
     const Token &Current = PeekCurrent();
+    ASTNode *Entity = nullptr;
     switch (Current.Type) {
     case TokenType::VOID:
     case TokenType::INT:
     case TokenType::CHAR:
     case TokenType::STRING:
     case TokenType::BOOLEAN: // Fall through.
-      GlobalEntities.push_back(ParseFunctionDecl());
+      Entity = ParseFunctionDecl();
       break;
     default:
-      CompileError(Current.LineNo, Current.ColumnNo)
-          << "Functions as global statements supported only.";
+      ReportError(Current, "Functions as global statements supported only.");
       break;
     }
+    if (Panicking)
+      Entity = RecoverFunction(Current);
+    GlobalEntities.push_back(Entity);
   }
-  return std::make_unique<ASTCompoundStmt>(std::move(GlobalEntities));
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(GlobalEntities));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseFunctionDecl() {
+ASTNode *Parser::ParseFunctionDecl() {
   /// Guaranteed data type, no checks needed.
   const Token &ReturnType = ParseReturnType();
   const Token &FunctionName = PeekNext();
-  std::vector<std::unique_ptr<ASTNode>> ParameterList;
+  ASTNodeList ParameterList;
 
   if (FunctionName.Type != TokenType::SYMBOL)
-    CompileError(FunctionName.LineNo, FunctionName.ColumnNo)
-        << "Function name expected.";
+    ReportError(FunctionName, "Function name expected.");
 
+  /// Parameters are visible in body and can be shadowed by its variables.
+  Declarations.ScopeBegin();
   Require(TokenType::OPEN_PAREN);
   ParameterList = ParseParameterList();
   Require(TokenType::CLOSE_PAREN);
 
   auto Block = ParseBlock();
+  Declarations.ScopeEnd();
 
-  return std::make_unique<ASTFunctionDecl>(
-      ReturnType.Type, std::string(FunctionName.Data), std::move(ParameterList),
-      std::move(Block), ReturnType.LineNo, ReturnType.ColumnNo);
+  return Context->Make<ASTFunctionDecl>(
+      ReturnType.Type, Context->MakeString(GetText(FunctionName)),
+      ParameterList, Block, GetLineNo(ReturnType), GetColumnNo(ReturnType));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseFunctionCall() {
+ASTNode *Parser::ParseFunctionCall() {
   const Token &FunctionName = PeekNext();
-  std::string Name = FunctionName.Data;
-  std::vector<std::unique_ptr<ASTNode>> Arguments;
+  std::string_view Name = Context->MakeString(GetText(FunctionName));
+  std::vector<ASTNode *> Arguments;
 
   Require(TokenType::OPEN_PAREN);
 
-  if (PeekNext().Type == TokenType::CLOSE_PAREN) {
-    return std::make_unique<ASTFunctionCall>(
-        std::move(Name), std::move(Arguments), FunctionName.LineNo,
-        FunctionName.ColumnNo);
-  }
-
-  --CurrentBufferPtr;
-  while (PeekCurrent().Type != TokenType::CLOSE_PAREN) {
+  while (!Panicking && !Match(TokenType::CLOSE_PAREN)) {
     Arguments.push_back(ParseLogicalOr());
-    Require({TokenType::CLOSE_PAREN, TokenType::COMMA});
-    if ((CurrentBufferPtr - 1)->Type == TokenType::CLOSE_PAREN) {
-      /// Move back to token before '('.
-      --CurrentBufferPtr;
-      break;
-    }
+    /// Closing parenthesis is consumed by the loop condition.
+    if (PeekCurrent().Type != TokenType::CLOSE_PAREN)
+      Require(ArgumentSeparators);
   }
 
-  Require(TokenType::CLOSE_PAREN);
-
-  return std::make_unique<ASTFunctionCall>(
-      std::move(Name), std::move(Arguments), FunctionName.LineNo,
-      FunctionName.ColumnNo);
+  return Context->Make<ASTFunctionCall>(Name, Context->MakeList(Arguments),
+                                        GetLineNo(FunctionName),
+                                        GetColumnNo(FunctionName));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseVarDecl() {
+ASTNode *Parser::ParseVarDecl() {
   const Token &DataType = ParseType();
-  std::string VariableName = PeekNext().Data;
-  const Token &Current = PeekNext(); // Assignment op.
+  const Token &Name = Require(TokenType::SYMBOL);
+  StringInterner::ID VariableName = GetIdentifier(Name);
 
-  if (Current.Type == TokenType::ASSIGN) {
-    return std::make_unique<ASTVarDecl>(DataType.Type, std::move(VariableName),
-                                        ParseLogicalOr(), DataType.LineNo,
-                                        DataType.ColumnNo);
+  if (Match(TokenType::ASSIGN)) {
+    auto *VarDecl = Context->Make<ASTVarDecl>(
+        DataType.Type, VariableName, ParseLogicalOr(), GetLineNo(DataType),
+        GetColumnNo(DataType));
+    /// Declared after initializer, so the same name in initializer refers
+    /// to outer variable.
+    Declare(VarDecl);
+    return VarDecl;
   }
 
-  CompileError(Current.LineNo, Current.ColumnNo)
-      << "Assignment operator expected.";
-  UnreachablePoint();
+  ReportError(PeekCurrent(), "Assignment operator expected.");
+  return Context->Make<ASTErrorNode>(GetLineNo(DataType),
+                                     GetColumnNo(DataType));
 }
 
-const Token &Parser::ParseType() {
+Token Parser::ParseType() {
   switch (const Token &Current = PeekCurrent(); Current.Type) {
   case TokenType::INT:
   case TokenType::CHAR:
@@ -156,12 +357,12 @@ const Token &Parser::ParseType() {
     PeekNext();
     return Current;
   default:
-    CompileError(Current.LineNo, Current.ColumnNo) << "Data type expected.";
-    UnreachablePoint();
+    ReportError(Current, "Data type expected.");
+    return Current;
   }
 }
 
-const Token &Parser::ParseReturnType() {
+Token Parser::ParseReturnType() {
   const Token &Current = PeekCurrent();
   if (Current.Type != TokenType::VOID)
     return ParseType();
@@ -169,49 +370,47 @@ const Token &Parser::ParseReturnType() {
   return Current;
 }
 
-std::unique_ptr<ASTNode> Parser::ParseParameter() {
+ASTNode *Parser::ParseParameter() {
   const Token &DataType = ParseType();
   const Token &VariableName = PeekNext();
 
   if (VariableName.Type != TokenType::SYMBOL)
-    CompileError(VariableName.LineNo, VariableName.ColumnNo)
-        << "Variable name expected.";
+    ReportError(VariableName, "Variable name expected.");
 
-  return std::make_unique<ASTVarDecl>(
-      DataType.Type, std::string(VariableName.Data),
-      /*DeclareBody=*/nullptr, DataType.LineNo, DataType.ColumnNo);
+  auto *Parameter = Context->Make<ASTVarDecl>(
+      DataType.Type, GetIdentifier(VariableName), /*DeclareBody=*/nullptr,
+      GetLineNo(DataType), GetColumnNo(DataType));
+  Declare(Parameter);
+  return Parameter;
 }
 
-std::vector<std::unique_ptr<ASTNode>> Parser::ParseParameterList() {
-  std::vector<std::unique_ptr<ASTNode>> ParameterList;
-  if (PeekNext().Type == TokenType::CLOSE_PAREN) {
-    --CurrentBufferPtr;
-    return ParameterList;
-  }
-
-  --CurrentBufferPtr;
-  while (PeekCurrent().Type != TokenType::CLOSE_PAREN) {
+ASTNodeList Parser::ParseParameterList() {
+  std::vector<ASTNode *> ParameterList;
+  /// Closing parenthesis is left to the caller.
+  while (!Panicking && PeekCurrent().Type != TokenType::CLOSE_PAREN) {
     ParameterList.push_back(ParseParameter());
-    Match({TokenType::CLOSE_PAREN, TokenType::COMMA});
-    if ((CurrentBufferPtr - 1)->Type == TokenType::CLOSE_PAREN) {
-      /// Move back to token before '('.
-      --CurrentBufferPtr;
-      break;
-    }
+    Match(TokenType::COMMA);
   }
-  return ParameterList;
+  return Context->MakeList(ParameterList);
 }
 
-std::unique_ptr<ASTCompoundStmt> Parser::ParseBlock() {
+ASTCompoundStmt *Parser::ParseBlock() {
   if (LoopsDepth > 0)
     return ParseIterationStmtBlock();
 
-  std::vector<std::unique_ptr<ASTNode>> Statements;
+  std::vector<ASTNode *> Statements;
 
   const Token &BeginOfBlock = Require(TokenType::OPEN_CURLY_BRACKET);
-  while (PeekCurrent().Type != TokenType::CLOSE_CURLY_BRACKET) {
-    Statements.push_back(ParseStatement());
-    switch (const ASTType Type = Statements.back()->GetASTType(); Type) {
+  /// Without '{' body is skipped by the caller.
+  if (Panicking)
+    return Context->Make<ASTCompoundStmt>(ASTNodeList(),
+                                          GetLineNo(BeginOfBlock),
+                                          GetColumnNo(BeginOfBlock));
+  Declarations.ScopeBegin();
+  while (!Stopped && PeekCurrent().Type != TokenType::CLOSE_CURLY_BRACKET) {
+    const Token &BeginOfStmt = PeekCurrent();
+    ASTNode *Stmt = ParseStatement();
+    switch (const ASTType Type = Stmt->GetASTType(); Type) {
     case ASTType::BINARY:
     case ASTType::POSTFIX_UNARY:
     case ASTType::PREFIX_UNARY:
@@ -225,20 +424,32 @@ std::unique_ptr<ASTCompoundStmt> Parser::ParseBlock() {
     default:
       break;
     }
+    if (Panicking)
+      Stmt = RecoverStatement(BeginOfStmt);
+    Statements.push_back(Stmt);
   }
   Require(TokenType::CLOSE_CURLY_BRACKET);
+  Declarations.ScopeEnd();
 
-  return std::make_unique<ASTCompoundStmt>(
-      std::move(Statements), BeginOfBlock.LineNo, BeginOfBlock.ColumnNo);
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(Statements),
+                                        GetLineNo(BeginOfBlock),
+                                        GetColumnNo(BeginOfBlock));
 }
 
-std::unique_ptr<ASTCompoundStmt> Parser::ParseIterationStmtBlock() {
-  std::vector<std::unique_ptr<ASTNode>> Statements;
+ASTCompoundStmt *Parser::ParseIterationStmtBlock() {
+  std::vector<ASTNode *> Statements;
 
   const Token &BeginOfBlock = Require(TokenType::OPEN_CURLY_BRACKET);
-  while (PeekCurrent().Type != TokenType::CLOSE_CURLY_BRACKET) {
-    Statements.push_back(ParseLoopStatement());
-    switch (const ASTType Type = Statements.back()->GetASTType(); Type) {
+  /// Without '{' body is skipped by the caller.
+  if (Panicking)
+    return Context->Make<ASTCompoundStmt>(ASTNodeList(),
+                                          GetLineNo(BeginOfBlock),
+                                          GetColumnNo(BeginOfBlock));
+  Declarations.ScopeBegin();
+  while (!Stopped && PeekCurrent().Type != TokenType::CLOSE_CURLY_BRACKET) {
+    const Token &BeginOfStmt = PeekCurrent();
+    ASTNode *Stmt = ParseLoopStatement();
+    switch (const ASTType Type = Stmt->GetASTType(); Type) {
     case ASTType::BINARY:
     case ASTType::POSTFIX_UNARY:
     case ASTType::PREFIX_UNARY:
@@ -254,14 +465,28 @@ std::unique_ptr<ASTCompoundStmt> Parser::ParseIterationStmtBlock() {
     default:
       break;
     }
+    if (Panicking)
+      Stmt = RecoverStatement(BeginOfStmt);
+    Statements.push_back(Stmt);
   }
   Require(TokenType::CLOSE_CURLY_BRACKET);
+  Declarations.ScopeEnd();
+
+  return Context->Make<ASTCompoundStmt>(Context->MakeList(Statements),
+                                        GetLineNo(BeginOfBlock),
+                                        GetColumnNo(BeginOfBlock));
+}
 
-  return std::make_unique<ASTCompoundStmt>(
-      std::move(Statements), BeginOfBlock.LineNo, BeginOfBlock.ColumnNo);
+ASTNode *Parser::ParseStatement() {
+  const Token &Begin = PeekCurrent();
+  if (!EnterNesting(Begin))
+    return Context->Make<ASTErrorNode>(GetLineNo(Begin), GetColumnNo(Begin));
+  ASTNode *Stmt = ParseStatementWithoutNesting();
+  LeaveNesting();
+  return Stmt;
 }
 
-std::unique_ptr<ASTNode> Parser::ParseStatement() {
+ASTNode *Parser::ParseStatementWithoutNesting() {
   switch (const Token &Current = PeekCurrent(); Current.Type) {
   case TokenType::IF:
     return ParseSelectionStatement();
@@ -283,16 +508,17 @@ std::unique_ptr<ASTNode> Parser::ParseStatement() {
   case TokenType::DEC: // Fall through.
     return ParsePrefixUnary();
   default:
-    CompileError(Current.LineNo, Current.ColumnNo)
-        << "Unexpected token: " << TokenToString(Current.Type);
-    UnreachablePoint();
+    ReportError(Current, std::string("Unexpected token: ") +
+                             TokenToString(Current.Type));
+    return Context->Make<ASTErrorNode>(GetLineNo(Current),
+                                       GetColumnNo(Current));
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParseSelectionStatement() {
-  std::unique_ptr<ASTNode> Condition;
-  std::unique_ptr<ASTCompoundStmt> ThenBody;
-  std::unique_ptr<ASTCompoundStmt> ElseBody;
+ASTNode *Parser::ParseSelectionStatement() {
+  ASTNode *Condition = nullptr;
+  ASTCompoundStmt *ThenBody = nullptr;
+  ASTCompoundStmt *ElseBody = nullptr;
 
   const Token &BeginOfSelectionStmt = Require(TokenType::IF);
   Require(TokenType::OPEN_PAREN);
@@ -303,12 +529,12 @@ std::unique_ptr<ASTNode> Parser::ParseSelectionStatement() {
     ElseBody = ParseBlock();
   }
 
-  return std::make_unique<ASTIfStmt>(
-      std::move(Condition), std::move(ThenBody), std::move(ElseBody),
-      BeginOfSelectionStmt.LineNo, BeginOfSelectionStmt.ColumnNo);
+  return Context->Make<ASTIfStmt>(Condition, ThenBody, ElseBody,
+                                  GetLineNo(BeginOfSelectionStmt),
+                                  GetColumnNo(BeginOfSelectionStmt));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseIterationStatement() {
+ASTNode *Parser::ParseIterationStatement() {
   switch (const Token &Current = PeekCurrent(); Current.Type) {
   case TokenType::FOR:
     return ParseForStatement();
@@ -317,36 +543,33 @@ std::unique_ptr<ASTNode> Parser::ParseIterationStatement() {
   case TokenType::WHILE:
     return ParseWhileStatement();
   default:
-    CompileError(Current.LineNo, Current.ColumnNo) << "Should not reach here.";
+    CompileError(GetLineNo(Current), GetColumnNo(Current))
+        << "Should not reach here.";
     UnreachablePoint();
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParseForStatement() {
+ASTNode *Parser::ParseForStatement() {
   const Token &ForStmtBegin = Require(TokenType::FOR);
   Require(TokenType::OPEN_PAREN);
+  /// Variable of initializer is visible in the whole statement.
+  Declarations.ScopeBegin();
 
-  std::unique_ptr<ASTNode> Init;
-  if (PeekNext().Type != TokenType::SEMICOLON) {
-    --CurrentBufferPtr;
+  ASTNode *Init = nullptr;
+  if (!Match(TokenType::SEMICOLON)) {
     Init = ParseExpression();
-    PeekNext();
+    Require(TokenType::SEMICOLON);
   }
 
-  std::unique_ptr<ASTNode> Condition;
-  if (PeekNext().Type != TokenType::SEMICOLON) {
-    --CurrentBufferPtr;
+  ASTNode *Condition = nullptr;
+  if (!Match(TokenType::SEMICOLON)) {
     Condition = ParseExpression();
-    PeekNext();
+    Require(TokenType::SEMICOLON);
   }
 
-  std::unique_ptr<ASTNode> Increment;
-  if (PeekNext().Type != TokenType::CLOSE_PAREN) {
-    --CurrentBufferPtr;
+  ASTNode *Increment = nullptr;
+  if (PeekCurrent().Type != TokenType::CLOSE_PAREN)
     Increment = ParseExpression();
-    PeekNext();
-  }
-  --CurrentBufferPtr;
 
   ++LoopsDepth;
 
@@ -354,13 +577,14 @@ std::unique_ptr<ASTNode> Parser::ParseForStatement() {
   auto Body = ParseIterationStmtBlock();
 
   --LoopsDepth;
+  Declarations.ScopeEnd();
 
-  return std::make_unique<ASTForStmt>(
-      std::move(Init), std::move(Condition), std::move(Increment),
-      std::move(Body), ForStmtBegin.LineNo, ForStmtBegin.ColumnNo);
+  return Context->Make<ASTForStmt>(Init, Condition, Increment, Body,
+                                   GetLineNo(ForStmtBegin),
+                                   GetColumnNo(ForStmtBegin));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseDoWhileStatement() {
+ASTNode *Parser::ParseDoWhileStatement() {
   const Token &DoWhileBegin = Require(TokenType::DO);
 
   ++LoopsDepth;
@@ -375,12 +599,11 @@ std::unique_ptr<ASTNode> Parser::ParseDoWhileStatement() {
   auto Condition = ParseLogicalOr();
   Require(TokenType::CLOSE_PAREN);
 
-  return std::make_unique<ASTDoWhileStmt>(std::move(Body), std::move(Condition),
-                                          DoWhileBegin.LineNo,
-                                          DoWhileBegin.ColumnNo);
+  return Context->Make<ASTDoWhileStmt>(Body, Condition, GetLineNo(DoWhileBegin),
+                                       GetColumnNo(DoWhileBegin));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseWhileStatement() {
+ASTNode *Parser::ParseWhileStatement() {
   const Token &WhileBegin = Require(TokenType::WHILE);
   Require(TokenType::OPEN_PAREN);
   auto Condition = ParseLogicalOr();
@@ -392,38 +615,40 @@ std::unique_ptr<ASTNode> Parser::ParseWhileStatement() {
 
   --LoopsDepth;
 
-  return std::make_unique<ASTWhileStmt>(std::move(Condition), std::move(Body),
-                                        WhileBegin.LineNo, WhileBegin.ColumnNo);
+  return Context->Make<ASTWhileStmt>(Condition, Body, GetLineNo(WhileBegin),
+                                     GetColumnNo(WhileBegin));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseLoopStatement() {
-  switch (const Token &Current = PeekNext(); Current.Type) {
+ASTNode *Parser::ParseLoopStatement() {
+  switch (const Token &Current = PeekCurrent(); Current.Type) {
   case TokenType::BREAK:
-    return std::make_unique<ASTBreakStmt>(Current.LineNo, Current.ColumnNo);
+    PeekNext();
+    return Context->Make<ASTBreakStmt>(GetLineNo(Current),
+                                       GetColumnNo(Current));
   case TokenType::CONTINUE:
-    return std::make_unique<ASTContinueStmt>(Current.LineNo, Current.ColumnNo);
+    PeekNext();
+    return Context->Make<ASTContinueStmt>(GetLineNo(Current),
+                                          GetColumnNo(Current));
   default:
-    --CurrentBufferPtr;
     return ParseStatement();
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParseJumpStatement() {
+ASTNode *Parser::ParseJumpStatement() {
   const Token &ReturnStmt = Require(TokenType::RETURN);
-  if (Match(TokenType::SEMICOLON)) {
-    // Rollback to allow match ';' in block parse function.
-    --CurrentBufferPtr;
-    return std::make_unique<ASTReturnStmt>(nullptr, ReturnStmt.LineNo,
-                                           ReturnStmt.ColumnNo);
+  // Leave ';' to be matched in block parse function.
+  if (PeekCurrent().Type == TokenType::SEMICOLON) {
+    return Context->Make<ASTReturnStmt>(nullptr, GetLineNo(ReturnStmt),
+                                        GetColumnNo(ReturnStmt));
   }
   // We want to forbid expressions like int var = var = var, so we
   // expect the first expression to have the precedence is lower than
   // the assignment operator.
-  return std::make_unique<ASTReturnStmt>(ParseLogicalOr(), ReturnStmt.LineNo,
-                                         ReturnStmt.ColumnNo);
+  return Context->Make<ASTReturnStmt>(ParseLogicalOr(), GetLineNo(ReturnStmt),
+                                      GetColumnNo(ReturnStmt));
 }
 
-std::unique_ptr<ASTNode> Parser::ParseExpression() {
+ASTNode *Parser::ParseExpression() {
   switch (PeekCurrent().Type) {
   case TokenType::INT:
   case TokenType::CHAR:
@@ -433,359 +658,364 @@ std::unique_ptr<ASTNode> Parser::ParseExpression() {
   default:
     break;
   }
-  PeekNext();
-  switch (PeekCurrent().Type) {
+  switch (PeekAhead(1U).Type) {
   case TokenType::OPEN_PAREN:
-    --CurrentBufferPtr;
     return ParseFunctionCall();
   default:
-    --CurrentBufferPtr;
     return ParseAssignment();
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParseAssignment() {
-  auto Expr = ParseLogicalOr();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::ASSIGN:
-    case TokenType::MUL_ASSIGN:
-    case TokenType::DIV_ASSIGN:
-    case TokenType::MOD_ASSIGN:
-    case TokenType::PLUS_ASSIGN:
-    case TokenType::MINUS_ASSIGN:
-    case TokenType::SHL_ASSIGN:
-    case TokenType::SHR_ASSIGN:
-    case TokenType::BIT_AND_ASSIGN:
-    case TokenType::BIT_OR_ASSIGN:
-    case TokenType::XOR_ASSIGN:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseAssignment(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseLogicalOr() {
-  auto Expr = ParseLogicalAnd();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::OR:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseLogicalOr(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseLogicalAnd() {
-  auto Expr = ParseInclusiveOr();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::AND:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseLogicalAnd(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseInclusiveOr() {
-  auto Expr = ParseExclusiveOr();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::BIT_OR:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseInclusiveOr(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseExclusiveOr() {
-  auto Expr = ParseAnd();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::XOR:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseExclusiveOr(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
+ASTNode *Parser::ParseAssignment() {
+  return ParseBinary(Precedence::Assignment);
 }
 
-std::unique_ptr<ASTNode> Parser::ParseAnd() {
-  auto Expr = ParseEquality();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::BIT_AND:
-      Expr = std::make_unique<ASTBinaryOperator>(Current.Type, std::move(Expr),
-                                                 ParseAnd(), Current.LineNo,
-                                                 Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseEquality() {
-  auto Expr = ParseRelational();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::EQ:
-    case TokenType::NEQ:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseEquality(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
+ASTNode *Parser::ParseLogicalOr() {
+  return ParseBinary(Precedence::LogicalOr);
 }
 
-std::unique_ptr<ASTNode> Parser::ParseRelational() {
-  auto Expr = ParseShift();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::GT:
-    case TokenType::LT:
-    case TokenType::GE:
-    case TokenType::LE:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseRelational(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
+ASTNode *Parser::ParseBinary(unsigned MinPrecedence) {
+  const Token &Begin = PeekCurrent();
+  if (!EnterNesting(Begin))
+    return Context->Make<ASTErrorNode>(GetLineNo(Begin), GetColumnNo(Begin));
 
-std::unique_ptr<ASTNode> Parser::ParseShift() {
-  auto Expr = ParseAdditive();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::SHL:
-    case TokenType::SHR:
-      Expr = std::make_unique<ASTBinaryOperator>(Current.Type, std::move(Expr),
-                                                 ParseShift(), Current.LineNo,
-                                                 Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
-      break;
-    }
-    break;
-  }
-  return Expr;
-}
+  /// Stacks are shared with nested expressions, which are parsed above
+  /// the base.
+  std::size_t OperatorsBase = BinaryOperators.size();
+  auto Reduce = [&] {
+    ASTNode *RHS = BinaryOperands.back();
+    BinaryOperands.pop_back();
+    const Token &Operator = BinaryOperators.back();
+    BinaryOperands.back() = Context->Make<ASTBinaryOperator>(
+        Operator.Type, BinaryOperands.back(), RHS, GetLineNo(Operator),
+        GetColumnNo(Operator));
+    BinaryOperators.pop_back();
+  };
 
-std::unique_ptr<ASTNode> Parser::ParseAdditive() {
-  auto Expr = ParseMultiplicative();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::PLUS:
-    case TokenType::MINUS:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseAdditive(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
+  /// Each operator may make tree one level deeper, so it is counted as
+  /// nesting, although chain is parsed without recursion.
+  unsigned Operators = 0U;
+  BinaryOperands.push_back(ParsePrefixUnary());
+  while (!Panicking) {
+    const Token &Current = PeekCurrent();
+    unsigned CurrentPrecedence = GetBinaryPrecedence(Current.Type);
+    if (CurrentPrecedence == Precedence::None ||
+        CurrentPrecedence < MinPrecedence)
       break;
-    }
-    break;
-  }
-  return Expr;
-}
-
-std::unique_ptr<ASTNode> Parser::ParseMultiplicative() {
-  auto Expr = ParsePrefixUnary();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
-    case TokenType::STAR:
-    case TokenType::SLASH:
-    case TokenType::MOD:
-      Expr = std::make_unique<ASTBinaryOperator>(
-          Current.Type, std::move(Expr), ParseMultiplicative(), Current.LineNo,
-          Current.ColumnNo);
-      continue;
-    default:
-      --CurrentBufferPtr;
+    if (!EnterNesting(Current))
       break;
-    }
-    break;
-  }
+    ++Operators;
+    PeekNext();
+    /// All operators are right-associative, so operator of the same
+    /// precedence is not reduced and takes the rest of chain as right
+    /// operand.
+    while (BinaryOperators.size() > OperatorsBase &&
+           GetBinaryPrecedence(BinaryOperators.back().Type) >
+               CurrentPrecedence)
+      Reduce();
+    BinaryOperators.push_back(Current);
+    BinaryOperands.push_back(ParsePrefixUnary());
+  }
+  while (BinaryOperators.size() > OperatorsBase)
+    Reduce();
+
+  ASTNode *Expr = BinaryOperands.back();
+  BinaryOperands.pop_back();
+  LeaveNesting(Operators + 1U);
   return Expr;
 }
 
-std::unique_ptr<ASTNode> Parser::ParsePrefixUnary() {
-  switch (const Token Current = PeekNext(); Current.Type) {
+ASTNode *Parser::ParsePrefixUnary() {
+  switch (const Token &Current = PeekCurrent(); Current.Type) {
   case TokenType::INC:
   case TokenType::DEC:
-    return std::make_unique<ASTUnaryOperator>(
+    PeekNext();
+    return Context->Make<ASTUnaryOperator>(
         ASTUnaryOperator::UnaryType::PREFIX, Current.Type, ParsePostfixUnary(),
-        Current.LineNo, Current.ColumnNo);
+        GetLineNo(Current), GetColumnNo(Current));
   default:
-    // Rollback current token pointer because there's no unary operator.
-    --CurrentBufferPtr;
     return ParsePostfixUnary();
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParsePostfixUnary() {
+ASTNode *Parser::ParsePostfixUnary() {
   auto Expr = ParsePrimary();
-  while (true) {
-    switch (const Token &Current = PeekNext(); Current.Type) {
+  /// Each operator wraps the previous ones.
+  unsigned Operators = 0U;
+  while (!Panicking) {
+    switch (const Token &Current = PeekCurrent(); Current.Type) {
     case TokenType::INC:
     case TokenType::DEC:
-      Expr = std::make_unique<ASTUnaryOperator>(
-          ASTUnaryOperator::UnaryType::POSTFIX, Current.Type, std::move(Expr),
-          Current.LineNo, Current.ColumnNo);
+      if (!EnterNesting(Current))
+        break;
+      ++Operators;
+      PeekNext();
+      Expr = Context->Make<ASTUnaryOperator>(
+          ASTUnaryOperator::UnaryType::POSTFIX, Current.Type, Expr,
+          GetLineNo(Current), GetColumnNo(Current));
       continue;
     default:
-      --CurrentBufferPtr;
       break;
     }
     break;
   }
+  LeaveNesting(Operators);
   return Expr;
 }
 
-std::unique_ptr<ASTNode> Parser::ParsePrimary() {
-  switch (const Token &Current = PeekNext(); Current.Type) {
-  case TokenType::SYMBOL:
-    return std::make_unique<ASTSymbol>(Current.Data, Current.LineNo,
-                                       Current.ColumnNo);
+ASTNode *Parser::ParsePrimary() {
+  switch (const Token &Current = PeekCurrent(); Current.Type) {
+  case TokenType::SYMBOL: {
+    PeekNext();
+    auto *Symbol = Context->Make<ASTSymbol>(
+        GetIdentifier(Current), GetLineNo(Current), GetColumnNo(Current));
+    Resolve(Symbol);
+    return Symbol;
+  }
   case TokenType::OPEN_PAREN: {
+    PeekNext();
     /// We expect all binary/unary/constant statements expect assignment.
     auto Expr = ParseLogicalOr();
     Require(TokenType::CLOSE_PAREN);
     return Expr;
   }
   default:
-    --CurrentBufferPtr;
     return ParseConstant();
   }
 }
 
-std::unique_ptr<ASTNode> Parser::ParseConstant() {
-  switch (const Token &Current = PeekNext(); Current.Type) {
+ASTNode *Parser::ParseConstant() {
+  const Token &Current = PeekCurrent();
+  if (!Literals.Contains(Current.Type)) {
+    ReportError(Current, "Literal expected.");
+    return Context->Make<ASTErrorNode>(GetLineNo(Current),
+                                       GetColumnNo(Current));
+  }
+  PeekNext();
+
+  switch (Current.Type) {
   case TokenType::INTEGRAL_LITERAL:
-    return std::make_unique<ASTIntegerLiteral>(
-        std::stoi(Current.Data), Current.LineNo, Current.ColumnNo);
+    return Context->Make<ASTIntegerLiteral>(
+        GetIntegralValue(Current), GetLineNo(Current), GetColumnNo(Current));
 
   case TokenType::FLOATING_POINT_LITERAL:
-    return std::make_unique<ASTFloatingPointLiteral>(
-        std::stod(Current.Data), Current.LineNo, Current.ColumnNo);
+    return Context->Make<ASTFloatingPointLiteral>(
+        GetFloatingPointValue(Storage, Current), GetLineNo(Current),
+        GetColumnNo(Current));
 
   case TokenType::STRING_LITERAL:
-    return std::make_unique<ASTStringLiteral>(Current.Data, Current.LineNo,
-                                              Current.ColumnNo);
+    return Context->Make<ASTStringLiteral>(
+        Context->MakeString(GetStringLiteral(Source, Storage, Current)),
+        GetLineNo(Current), GetColumnNo(Current));
 
   case TokenType::FALSE:
   case TokenType::TRUE:
-    return std::make_unique<ASTBooleanLiteral>(
-        Current.Type == TokenType::TRUE, Current.LineNo, Current.ColumnNo);
+    return Context->Make<ASTBooleanLiteral>(Current.Type == TokenType::TRUE,
+                                            GetLineNo(Current),
+                                            GetColumnNo(Current));
 
   default:
-    CompileError(Current.LineNo, Current.ColumnNo) << "Literal expected.";
     UnreachablePoint();
   }
 }
 
-const Token &Parser::PeekNext() {
-  CheckIfHaveMoreTokens();
+std::string_view Parser::GetText(const Token &T) const {
+  return GetTokenText(Source, T);
+}
+
+StringInterner::ID Parser::GetIdentifier(const Token &T) const {
+  if (T.Type == TokenType::SYMBOL)
+    return Storage->GetSymbolName(T.Payload);
+  return StringInterner::Global().Intern(GetText(T));
+}
+
+void Parser::Declare(ASTVarDecl *VarDecl) {
+  unsigned Attribute = Declarations.AddDeclaration(VarDecl->GetSymbolNameID());
+  VarDecl->SetDeclaration(FirstDeclaration + Attribute);
+}
+
+void Parser::Resolve(ASTSymbol *Symbol) {
+  unsigned Attribute = Declarations.Lookup(Symbol->GetNameID());
+  if (Attribute != middleEnd::Storage::NoAttribute)
+    Symbol->SetDeclaration(FirstDeclaration + Attribute);
+}
+
+unsigned Parser::GetLineNo(const Token &T) const {
+  return Source->GetLineNo(T.Loc);
+}
+
+unsigned Parser::GetColumnNo(const Token &T) const {
+  return Source->GetColumnNo(T.Loc);
+}
+
+Token Parser::MakeEndToken() const {
+  return Token{TokenType::NONE,
+               static_cast<SourceLocation>(Source->GetText().size()),
+               /*Length=*/0U, /*Payload=*/0U};
+}
+
+Token Parser::Fetch() {
+  if (TokenSource)
+    return TokenSource->Next();
+  if (CurrentBufferPtr == BufferEnd)
+    return MakeEndToken();
   return *CurrentBufferPtr++;
 }
 
-const Token &Parser::PeekCurrent() const {
-  CheckIfHaveMoreTokens();
-  return *CurrentBufferPtr;
+const Token &Parser::PeekAhead(unsigned N) {
+  assert(N < LookaheadSize);
+  while (LookaheadCount <= N) {
+    Lookahead[(LookaheadStart + LookaheadCount) % LookaheadSize] = Fetch();
+    ++LookaheadCount;
+  }
+  return Lookahead[(LookaheadStart + N) % LookaheadSize];
 }
 
-bool Parser::Match(const std::vector<TokenType> &Expected) {
-  CheckIfHaveMoreTokens();
-  for (TokenType Token : Expected) {
-    if (CurrentBufferPtr == BufferEnd)
-      return false;
-    if (PeekCurrent().Type == Token) {
-      PeekNext();
-      return true;
-    }
+Token Parser::PeekNext() {
+  Token Current = PeekCurrent();
+  if (Panicking)
+    return Current;
+  LookaheadStart = (LookaheadStart + 1) % LookaheadSize;
+  --LookaheadCount;
+  return Current;
+}
+
+Token Parser::PeekCurrent() {
+  const Token &Current = PeekAhead(0U);
+  CheckIfHaveMoreTokens(Current);
+  return Current;
+}
+
+bool Parser::Match(TokenSet Expected) {
+  if (Panicking || !Expected.Contains(PeekCurrent().Type))
+    return false;
+  PeekNext();
+  return true;
+}
+
+Token Parser::Require(TokenSet Expected) {
+  Token Current = PeekCurrent();
+  if (Match(Expected))
+    return Current;
+
+  ReportError(Current, "Expected " + TokensToString(Expected) + ", got " +
+                           TokenToString(Current.Type));
+  return Current;
+}
+
+void Parser::CheckIfHaveMoreTokens(const Token &Current) {
+  if (Current.Type != TokenType::NONE)
+    return;
+  if (!ErrorRecovery) {
+    CompileError() << "End of buffer reached.";
+    UnreachablePoint();
   }
-  return false;
+  ReportError(Current, "End of buffer reached.");
+  Stopped = true;
+}
+
+void Parser::EnableErrorRecovery(unsigned TheErrorLimit) {
+  assert(TheErrorLimit > 0U);
+  ErrorRecovery = true;
+  ErrorLimit = TheErrorLimit;
 }
 
-bool Parser::Match(TokenType Expected) {
-  return Match(std::vector<TokenType>{Expected});
+void Parser::EnableDepthLimit(unsigned TheDepthLimit) {
+  assert(TheDepthLimit > 0U);
+  DepthLimit = TheDepthLimit;
 }
 
-const Token &Parser::Require(const std::vector<TokenType> &Expected) {
-  CheckIfHaveMoreTokens();
-  if (Match(Expected)) {
-    /// Something from vector successfully matched and located in previous
-    /// token.
-    return *(CurrentBufferPtr - 1);
+bool Parser::EnterNesting(const Token &At) {
+  if (DepthLimit > 0U && NestingDepth >= DepthLimit) {
+    ReportError(At, "Nesting is too deep.");
+    return false;
   }
+  ++NestingDepth;
+  return true;
+}
 
-  CompileError(CurrentBufferPtr->LineNo, CurrentBufferPtr->ColumnNo)
-      << "Expected " << TokensToString(Expected) << ", got "
-      << TokenToString(CurrentBufferPtr->Type);
-  UnreachablePoint();
+void Parser::LeaveNesting(unsigned Levels) {
+  assert(NestingDepth >= Levels);
+  NestingDepth -= Levels;
 }
 
-const Token &Parser::Require(TokenType Expected) {
-  return Require(std::vector<TokenType>{Expected});
+const std::vector<ParseDiagnostic> &Parser::GetDiagnostics() const {
+  return Diagnostics;
 }
 
-void Parser::CheckIfHaveMoreTokens() const {
-  if (CurrentBufferPtr == BufferEnd) {
-    CompileError(CurrentBufferPtr->LineNo, CurrentBufferPtr->LineNo)
-        << "End of buffer reached.";
-    UnreachablePoint();
+void Parser::SetFirstDeclaration(unsigned First) {
+  assert(Declarations.NextAttribute() == 0U);
+  FirstDeclaration = First;
+}
+
+unsigned Parser::TotalDeclarations() const {
+  return Declarations.NextAttribute();
+}
+
+void Parser::ReportError(const Token &At, std::string Message) {
+  if (!ErrorRecovery)
+    ReportParseError(Source, ParseDiagnostic{At.Loc, std::move(Message)});
+  if (Panicking)
+    return;
+  Panicking = true;
+  if (At.Type == TokenType::ERROR)
+    return;
+  Diagnostics.push_back(ParseDiagnostic{At.Loc, std::move(Message)});
+  if (Diagnostics.size() >= ErrorLimit)
+    Stopped = true;
+}
+
+ASTNode *Parser::RecoverStatement(const Token &Begin) {
+  auto *Error = Context->Make<ASTErrorNode>(GetLineNo(Begin),
+                                            GetColumnNo(Begin));
+  if (Stopped)
+    return Error;
+  Panicking = false;
+  unsigned Depth = 0U;
+  while (true) {
+    TokenType Type = PeekAhead(0U).Type;
+    if (Type == TokenType::NONE)
+      break;
+    if (Type == TokenType::CLOSE_CURLY_BRACKET && Depth == 0U)
+      break;
+    PeekNext();
+    if (Type == TokenType::SEMICOLON && Depth == 0U)
+      break;
+    if (Type == TokenType::OPEN_CURLY_BRACKET)
+      ++Depth;
+    /// Statement with nested block ends with it, unless else branch
+    /// follows.
+    if (Type == TokenType::CLOSE_CURLY_BRACKET && --Depth == 0U &&
+        PeekAhead(0U).Type != TokenType::ELSE)
+      break;
+  }
+  return Error;
+}
+
+ASTNode *Parser::RecoverFunction(const Token &Begin) {
+  auto *Error = Context->Make<ASTErrorNode>(GetLineNo(Begin),
+                                            GetColumnNo(Begin));
+  if (Stopped)
+    return Error;
+  Panicking = false;
+  unsigned Depth = 0U;
+  TokenType Previous = TokenType::NONE;
+  while (true) {
+    TokenType Type = PeekAhead(0U).Type;
+    if (Type == TokenType::NONE)
+      break;
+    /// Type keyword in parameter list is not the beginning of function.
+    if (Depth == 0U && FunctionBegin.Contains(Type) &&
+        Previous != TokenType::OPEN_PAREN && Previous != TokenType::COMMA)
+      break;
+    PeekNext();
+    if (Type == TokenType::OPEN_CURLY_BRACKET)
+      ++Depth;
+    if (Type == TokenType::CLOSE_CURLY_BRACKET && Depth > 0U && --Depth == 0U)
+      break;
+    Previous = Type;
   }
+  return Error;
 }
 
 } // namespace frontEnd
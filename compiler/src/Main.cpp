@@ -1,7 +1,181 @@
-/* Main.cpp - Compiler library main function.
+/* Main.cpp - Compiler driver.
  * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
  *
  * This file is distributed under the MIT license.
  */
 
-int main() {}
\ No newline at end of file
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTPrettyPrint.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/ParallelLexer.hpp"
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "FrontEnd/Parse/ParallelParser.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Analysis/SemanticAnalyzer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/Diagnostic.hpp"
+#include "Utility/ThreadPool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace weak::frontEnd;
+
+/// Parse with error recovery if ErrorLimit is not zero, so all syntax
+/// errors are collected to Diagnostics. Too deep nesting is reported as
+/// error instead of stack overflow.
+template <typename ParserT>
+static ASTNode *RunParser(ParserT &&Parse, unsigned ErrorLimit,
+                          std::vector<ParseDiagnostic> *Diagnostics) {
+  if (ErrorLimit > 0U)
+    Parse.EnableErrorRecovery(ErrorLimit);
+  Parse.EnableDepthLimit();
+  ASTNode *AST = Parse.Parse();
+  *Diagnostics = Parse.GetDiagnostics();
+  return AST;
+}
+
+/// Put lexical errors before syntax errors they caused, keeping at most
+/// ErrorLimit of them.
+static void MergeLexErrors(const std::vector<LexDiagnostic> &LexDiagnostics,
+                           unsigned ErrorLimit,
+                           std::vector<ParseDiagnostic> *Diagnostics) {
+  if (LexDiagnostics.empty())
+    return;
+  std::vector<ParseDiagnostic> Merged;
+  Merged.reserve(LexDiagnostics.size() + Diagnostics->size());
+  for (const LexDiagnostic &D : LexDiagnostics)
+    Merged.push_back(ParseDiagnostic{D.Loc, D.Message});
+  Merged.insert(Merged.end(), Diagnostics->begin(), Diagnostics->end());
+  std::stable_sort(Merged.begin(), Merged.end(),
+                   [](const ParseDiagnostic &L, const ParseDiagnostic &R) {
+                     return L.Loc < R.Loc;
+                   });
+  if (Merged.size() > ErrorLimit)
+    Merged.resize(ErrorLimit);
+  *Diagnostics = std::move(Merged);
+}
+
+static ASTNode *ParseStreaming(ASTContext *Context,
+                               weak::middleEnd::Storage *S,
+                               const SourceBuffer *Buffer, unsigned ErrorLimit,
+                               std::vector<ParseDiagnostic> *Diagnostics) {
+  Lexer Lex(S, Buffer);
+  if (ErrorLimit > 0U)
+    Lex.EnableErrorRecovery();
+  ASTNode *AST =
+      RunParser(Parser(Context, Buffer, &Lex), ErrorLimit, Diagnostics);
+  MergeLexErrors(Lex.GetDiagnostics(), ErrorLimit, Diagnostics);
+  return AST;
+}
+
+static ASTNode *ParseParallel(ASTContext *Context, weak::middleEnd::Storage *S,
+                              const SourceBuffer *Buffer,
+                              weak::ThreadPool *Pool, unsigned ErrorLimit,
+                              std::vector<ParseDiagnostic> *Diagnostics) {
+  ParallelLexer Lex(S, Buffer, Pool);
+  if (ErrorLimit > 0U)
+    Lex.EnableErrorRecovery();
+  auto Tokens = Lex.Analyze();
+  ASTNode *AST =
+      RunParser(ParallelParser(Context, Buffer, S, Tokens.data(),
+                               Tokens.data() + Tokens.size(), Pool),
+                ErrorLimit, Diagnostics);
+  MergeLexErrors(Lex.GetDiagnostics(), ErrorLimit, Diagnostics);
+  return AST;
+}
+
+/// Check types, so later passes get annotated tree. With error recovery,
+/// up to ErrorLimit errors are printed.
+///
+/// \return false if tree has semantic errors.
+static bool Analyze(ASTNode *AST, unsigned ErrorLimit) {
+  weak::middleEnd::SemanticAnalyzer Analyzer(AST);
+  if (ErrorLimit > 0U)
+    Analyzer.EnableErrorRecovery();
+  Analyzer.Analyze();
+
+  const auto &Diagnostics = Analyzer.GetDiagnostics();
+  for (std::size_t I = 0U; I < Diagnostics.size() && I < ErrorLimit; ++I)
+    weak::PrintError(Diagnostics[I].LineNo - 1U, Diagnostics[I].ColumnNo - 1U,
+                     Diagnostics[I].Message.c_str());
+  return Diagnostics.empty();
+}
+
+/// \return false if input has syntax or semantic errors.
+static bool Compile(const SourceBuffer *Buffer, weak::ThreadPool *Pool,
+                    unsigned ErrorLimit, bool DumpAST) {
+  weak::middleEnd::Storage Storage;
+  /// Owns the whole AST of translation unit.
+  ASTContext Context;
+  std::vector<ParseDiagnostic> Diagnostics;
+  ASTNode *AST =
+      Pool ? ParseParallel(&Context, &Storage, Buffer, Pool, ErrorLimit,
+                           &Diagnostics)
+           : ParseStreaming(&Context, &Storage, Buffer, ErrorLimit,
+                            &Diagnostics);
+
+  if (!Diagnostics.empty()) {
+    PrintParseErrors(Buffer, Diagnostics);
+    return false;
+  }
+
+  if (!Analyze(AST, ErrorLimit))
+    return false;
+
+  if (DumpAST)
+    ASTPrettyPrint(AST, std::cout);
+  return true;
+}
+
+/// Parse positive number, given as value of command line option, or
+/// terminate program.
+static unsigned ParseCount(std::string_view Option, std::string_view Value) {
+  unsigned Count = 0U;
+  const char *End = Value.data() + Value.size();
+  auto [Ptr, Error] = std::from_chars(Value.data(), End, Count);
+  if (Error != std::errc() || Ptr != End || Count == 0U) {
+    weak::CompileError() << "Expected positive number for " << Option
+                         << ", got \"" << Value << "\"";
+    weak::UnreachablePoint();
+  }
+  return Count;
+}
+
+int main(int Argc, char *Argv[]) {
+  SourceManager SM;
+  bool DumpAST = false;
+  /// Lex and parse with given number of threads. Not set means sequential
+  /// streaming.
+  std::unique_ptr<weak::ThreadPool> Pool;
+  /// Report up to given number of syntax errors per file instead of
+  /// stopping at the first one. Zero means no error recovery.
+  unsigned ErrorLimit = 0U;
+
+  for (int I = 1; I < Argc; ++I) {
+    std::string_view Arg = Argv[I];
+    if (Arg == "--dump-ast")
+      DumpAST = true;
+    else if (Arg.substr(0, 2) == "-j" && Arg.size() > 2)
+      Pool = std::make_unique<weak::ThreadPool>(
+          ParseCount("-j", Arg.substr(2)));
+    else if (Arg.substr(0, 14) == "--error-limit=" && Arg.size() > 14)
+      ErrorLimit = ParseCount("--error-limit", Arg.substr(14));
+    else if (Arg == "-")
+      SM.AddStdin();
+    else
+      SM.AddFile(Arg);
+  }
+
+  if (SM.TotalBuffers() == 0U)
+    SM.AddStdin();
+
+  bool Success = true;
+  for (FileID ID = 0U; ID < SM.TotalBuffers(); ++ID)
+    Success &= Compile(SM.GetBuffer(ID), Pool.get(), ErrorLimit, DumpAST);
+  return Success ? 0 : 1;
+}
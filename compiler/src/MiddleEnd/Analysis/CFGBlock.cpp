@@ -11,7 +11,8 @@ namespace weak {
 namespace middleEnd {
 
 CFGBlock::CFGBlock(int TheIndex, std::string TheLabel)
-    : Index(TheIndex), Label(std::move(TheLabel)) {}
+    : Statements(), Successors(), Predecessors(), Dominator(nullptr),
+      DominatingBlocks(), Index(TheIndex), Label(std::move(TheLabel)) {}
 
 CFGBlock::~CFGBlock() {
   for (IRNode *Statement : Statements)
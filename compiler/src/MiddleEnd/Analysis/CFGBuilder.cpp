@@ -20,25 +20,32 @@
 #include "MiddleEnd/IR/IRBranch.hpp"
 #include "MiddleEnd/IR/IRPhiNode.hpp"
 #include <algorithm>
+#include <cassert>
 
 using namespace weak::frontEnd;
 
 namespace weak {
 namespace middleEnd {
 
-CFGBuilder::CFGBuilder(
-    const std::vector<std::unique_ptr<frontEnd::ASTNode>> &TheStatements)
-    : StatementsRef(TheStatements), CFGraph(), CurrentBlock(MakeBlock("Entry")),
-      BlocksForVariable() {}
+CFGBuilder::CFGBuilder(frontEnd::ASTNodeList TheStatements)
+    : Statements(TheStatements), Flat(nullptr), SymbolContext(), CFGraph(),
+      CurrentBlock(MakeBlock("Entry")), BlocksForVariable() {}
+
+CFGBuilder::CFGBuilder(const frontEnd::FlatAST *TheFlat)
+    : Statements(), Flat(TheFlat), SymbolContext(), CFGraph(),
+      CurrentBlock(MakeBlock("Entry")), BlocksForVariable() {}
 
 void CFGBuilder::Build() {
-  for (const auto &Expression : StatementsRef)
-    Expression->Accept(this);
+  if (Flat)
+    VisitFlat(0U);
+  else
+    for (const auto *Expression : Statements)
+      Traverse(Expression);
   ReduceGraph();
   BuildSSAForm();
 }
 
-CFGBlock *CFGBuilder::MakeBlock(std::string Label) const {
+CFGBlock *CFGBuilder::MakeBlock(std::string Label) {
   int NextIndex = static_cast<int>(CFGraph.GetBlocks().size());
   auto *Block = new CFGBlock(NextIndex, Label);
   CFGraph.AddBlock(Block);
@@ -46,41 +53,133 @@ CFGBlock *CFGBuilder::MakeBlock(std::string Label) const {
 }
 
 void CFGBuilder::MakeBranch(ASTNode *Condition, CFGBlock *ThenBlock,
-                            CFGBlock *ElseBlock) const {
+                            CFGBlock *ElseBlock) {
   CFGBlock::AddLink(CurrentBlock, ThenBlock);
   CFGBlock::AddLink(CurrentBlock, ElseBlock);
   CurrentBlock->AddStatement(new IRBranch(Condition, ThenBlock, ElseBlock));
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTCompoundStmt *Stmt) const {
-  for (const auto &Expression : Stmt->GetStmts())
-    Expression->Accept(this);
+void CFGBuilder::AddAssignment(ASTSymbol *Variable, ASTNode *Operand) {
+  /// Checked by SemanticAnalyzer.
+  assert(Variable->GetDeclaration() != ASTVarDecl::NoDeclaration);
+  auto &[Name, Blocks] = BlocksForVariable[Variable->GetDeclaration()];
+  Name = Variable->GetNameID();
+  Blocks.insert(CurrentBlock);
+  CurrentBlock->AddStatement(new IRAssignment(Variable, Operand));
+}
+
+void CFGBuilder::Visit(const frontEnd::ASTCompoundStmt *Stmt) {
+  for (const auto *Expression : Stmt->GetStmts())
+    Traverse(Expression);
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTFunctionDecl *Stmt) const {
-  Stmt->GetBody()->Accept(this);
+void CFGBuilder::Visit(const frontEnd::ASTFunctionDecl *Stmt) {
+  Traverse(Stmt->GetBody());
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTVarDecl *Stmt) const {
-  BlocksForVariable[Stmt->GetSymbolName()].insert(CurrentBlock);
-  CurrentBlock->AddStatement(new IRAssignment(
-      new ASTSymbol(Stmt->GetSymbolName()), Stmt->GetDeclareBody().get()));
+void CFGBuilder::Visit(const frontEnd::ASTVarDecl *Stmt) {
+  AddAssignment(
+      MakeVariable(Stmt->GetDeclaration(), Stmt->GetSymbolNameID()),
+      Stmt->GetDeclareBody());
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTBinaryOperator *Stmt) const {
+void CFGBuilder::Visit(const frontEnd::ASTBinaryOperator *Stmt) {
   if (Stmt->GetOperation() == TokenType::ASSIGN) {
-    const ASTSymbol *Symbol =
-        static_cast<const ASTSymbol *>(Stmt->GetLHS().get());
-    BlocksForVariable[Symbol->GetName()].insert(CurrentBlock);
-    CurrentBlock->AddStatement(
-        new IRAssignment(new ASTSymbol(*Symbol), Stmt->GetRHS().get()));
+    /// Checked by SemanticAnalyzer.
+    assert(Stmt->GetLHS()->GetASTType() == ASTType::SYMBOL);
+    const ASTSymbol *Symbol = static_cast<const ASTSymbol *>(Stmt->GetLHS());
+    AddAssignment(SymbolContext.Make<ASTSymbol>(*Symbol), Stmt->GetRHS());
     return;
   }
-  Stmt->GetLHS()->Accept(this);
-  Stmt->GetRHS()->Accept(this);
+  Traverse(Stmt->GetLHS());
+  Traverse(Stmt->GetRHS());
+}
+
+void CFGBuilder::Visit(const frontEnd::ASTIfStmt *Stmt) {
+  BodyBuilder ElseBody;
+  if (Stmt->GetElseBody())
+    ElseBody = [&] { Traverse(Stmt->GetElseBody()); };
+  BuildIf(
+      Stmt->GetCondition(), [&] { Traverse(Stmt->GetThenBody()); },
+      ElseBody);
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTIfStmt *Stmt) const {
+void CFGBuilder::Visit(const frontEnd::ASTWhileStmt *Stmt) {
+  BuildWhile(Stmt->GetCondition(), [&] { Traverse(Stmt->GetBody()); });
+}
+
+void CFGBuilder::Visit(const frontEnd::ASTDoWhileStmt *Stmt) {
+  BuildDoWhile(Stmt->GetCondition(), [&] { Traverse(Stmt->GetBody()); });
+}
+
+void CFGBuilder::Visit(const frontEnd::ASTForStmt *Stmt) {
+  BuildFor(
+      Stmt->GetCondition(), [&] { Traverse(Stmt->GetInit()); },
+      [&] {
+        Traverse(Stmt->GetBody());
+        Traverse(Stmt->GetIncrement());
+      });
+}
+
+void CFGBuilder::VisitFlat(FlatAST::NodeIndex I) {
+  auto Child = [&](unsigned Index) { return Flat->GetChild(I, Index); };
+  auto Node = [&](unsigned Index) { return Flat->GetNode(Child(Index)); };
+
+  switch (Flat->GetType(I)) {
+  case ASTType::COMPOUND_STMT:
+    for (FlatAST::NodeIndex C = Flat->GetFirstChild(I); C != FlatAST::None;
+         C = Flat->GetNextSibling(C))
+      VisitFlat(C);
+    break;
+  case ASTType::FUNCTION_DECL:
+    /// Body is the last child, after arguments.
+    VisitFlat(Child(Flat->GetChildrenCount(I) - 1U));
+    break;
+  case ASTType::VAR_DECL: {
+    const auto *Decl = static_cast<const ASTVarDecl *>(Flat->GetNode(I));
+    AddAssignment(
+        MakeVariable(Flat->GetDeclaration(I), Decl->GetSymbolNameID()),
+        Node(0U));
+    break;
+  }
+  case ASTType::BINARY:
+    if (Flat->GetOperation(I) == TokenType::ASSIGN) {
+      assert(Flat->GetType(Child(0U)) == ASTType::SYMBOL);
+      const auto *Symbol = static_cast<const ASTSymbol *>(Node(0U));
+      AddAssignment(SymbolContext.Make<ASTSymbol>(*Symbol), Node(1U));
+      break;
+    }
+    VisitFlat(Child(0U));
+    VisitFlat(Child(1U));
+    break;
+  case ASTType::IF_STMT: {
+    BodyBuilder ElseBody;
+    if (Flat->GetType(Child(2U)) != ASTType::BASE_NODE)
+      ElseBody = [&] { VisitFlat(Child(2U)); };
+    BuildIf(Node(0U), [&] { VisitFlat(Child(1U)); }, ElseBody);
+    break;
+  }
+  case ASTType::WHILE_STMT:
+    BuildWhile(Node(0U), [&] { VisitFlat(Child(1U)); });
+    break;
+  case ASTType::DO_WHILE_STMT:
+    BuildDoWhile(Node(1U), [&] { VisitFlat(Child(0U)); });
+    break;
+  case ASTType::FOR_STMT:
+    BuildFor(
+        Node(1U), [&] { VisitFlat(Child(0U)); },
+        [&] {
+          VisitFlat(Child(3U));
+          VisitFlat(Child(2U));
+        });
+    break;
+  default:
+    break;
+  }
+}
+
+void CFGBuilder::BuildIf(ASTNode *Condition, const BodyBuilder &ThenBody,
+                         const BodyBuilder &ElseBody) {
   CFGBlock *BranchBlock = MakeBlock("Branch");
   CFGBlock *ThenBlock = MakeBlock("Then");
   CFGBlock *MergeBlock = MakeBlock("MergeBlock");
@@ -89,28 +188,28 @@ void CFGBuilder::Visit(const frontEnd::ASTIfStmt *Stmt) const {
   CFGBlock::AddLink(CurrentBlock, BranchBlock);
   CurrentBlock = BranchBlock;
 
-  if (Stmt->GetElseBody()) {
+  if (ElseBody) {
     ElseBlock = MakeBlock("Else");
-    MakeBranch(Stmt->GetCondition().get(), ThenBlock, ElseBlock);
+    MakeBranch(Condition, ThenBlock, ElseBlock);
   } else
-    MakeBranch(Stmt->GetCondition().get(), ThenBlock, MergeBlock);
+    MakeBranch(Condition, ThenBlock, MergeBlock);
 
   CurrentBlock = ThenBlock;
-  Stmt->GetThenBody()->Accept(this);
+  ThenBody();
 
-  if (Stmt->GetElseBody()) {
+  if (ElseBody) {
     CFGBlock::AddLink(ThenBlock, MergeBlock);
     CFGBlock::AddLink(ElseBlock, MergeBlock);
     CFGBlock::AddLink(BranchBlock, ElseBlock);
     CurrentBlock = ElseBlock;
-    Stmt->GetElseBody()->Accept(this);
+    ElseBody();
   } else
     CFGBlock::AddLink(CurrentBlock, MergeBlock);
 
   CurrentBlock = MergeBlock;
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTWhileStmt *Stmt) const {
+void CFGBuilder::BuildWhile(ASTNode *Condition, const BodyBuilder &Body) {
   CFGBlock *BranchBlock = MakeBlock("Branch");
   CFGBlock *BodyBlock = MakeBlock("Body");
   CFGBlock *MergeBlock = MakeBlock("MergeBlock");
@@ -119,16 +218,15 @@ void CFGBuilder::Visit(const frontEnd::ASTWhileStmt *Stmt) const {
   CFGBlock::AddLink(BranchBlock, BodyBlock);
   CFGBlock::AddLink(BranchBlock, MergeBlock);
 
-  BranchBlock->AddStatement(
-      new IRBranch(Stmt->GetCondition().get(), BodyBlock, MergeBlock));
+  BranchBlock->AddStatement(new IRBranch(Condition, BodyBlock, MergeBlock));
 
   CurrentBlock = BodyBlock;
-  Stmt->GetBody()->Accept(this);
+  Body();
   CFGBlock::AddLink(CurrentBlock, BranchBlock);
   CurrentBlock = MergeBlock;
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTDoWhileStmt *Stmt) const {
+void CFGBuilder::BuildDoWhile(ASTNode *Condition, const BodyBuilder &Body) {
   CFGBlock *BranchBlock = MakeBlock("Branch");
   CFGBlock *BodyBlock = MakeBlock("Body");
   CFGBlock *MergeBlock = MakeBlock("MergeBlock");
@@ -137,16 +235,16 @@ void CFGBuilder::Visit(const frontEnd::ASTDoWhileStmt *Stmt) const {
   CFGBlock::AddLink(BranchBlock, BodyBlock);
   CFGBlock::AddLink(BranchBlock, MergeBlock);
 
-  BranchBlock->AddStatement(
-      new IRBranch(Stmt->GetCondition().get(), BodyBlock, MergeBlock));
+  BranchBlock->AddStatement(new IRBranch(Condition, BodyBlock, MergeBlock));
 
   CurrentBlock = BodyBlock;
-  Stmt->GetBody()->Accept(this);
+  Body();
   CFGBlock::AddLink(CurrentBlock, BranchBlock);
   CurrentBlock = MergeBlock;
 }
 
-void CFGBuilder::Visit(const frontEnd::ASTForStmt *Stmt) const {
+void CFGBuilder::BuildFor(ASTNode *Condition, const BodyBuilder &Init,
+                          const BodyBuilder &Body) {
   CFGBlock *InitBlock = MakeBlock("Init");
   CFGBlock *BranchBlock = MakeBlock("Branch");
   CFGBlock *BodyBlock = MakeBlock("Body"); ///< Increment here.
@@ -157,29 +255,35 @@ void CFGBuilder::Visit(const frontEnd::ASTForStmt *Stmt) const {
   CFGBlock::AddLink(BranchBlock, BodyBlock);
   CFGBlock::AddLink(BranchBlock, MergeBlock);
 
-  BranchBlock->AddStatement(
-      new IRBranch(Stmt->GetCondition().get(), BodyBlock, MergeBlock));
+  BranchBlock->AddStatement(new IRBranch(Condition, BodyBlock, MergeBlock));
 
   CurrentBlock = InitBlock;
-  Stmt->GetInit()->Accept(this);
+  Init();
 
   CurrentBlock = BodyBlock;
-  Stmt->GetBody()->Accept(this);
-  Stmt->GetIncrement()->Accept(this);
+  Body();
 
   CFGBlock::AddLink(CurrentBlock, BranchBlock);
   CurrentBlock = MergeBlock;
 }
 
+ASTSymbol *CFGBuilder::MakeVariable(unsigned Declaration,
+                                    StringInterner::ID Name) {
+  auto *Variable = SymbolContext.Make<ASTSymbol>(Name);
+  Variable->SetDeclaration(Declaration);
+  return Variable;
+}
+
 void CFGBuilder::InsertPhiNodes() {
-  for (const auto &[VariableName, AssignedBlocks] : BlocksForVariable) {
+  for (const auto &[Declaration, Variable] : BlocksForVariable) {
+    const auto &[Name, AssignedBlocks] = Variable;
     std::set<CFGBlock *> DominanceFrontier =
         CFGraph.GetDominanceFrontierForSubset(AssignedBlocks);
     for (auto *Block : DominanceFrontier) {
       std::map<CFGBlock *, ASTSymbol *> VariablesMap;
       for (auto *Predecessor : Block->Predecessors)
-        VariablesMap[Predecessor] = new ASTSymbol(VariableName);
-      auto *Phi = new IRPhiNode(std::make_unique<ASTSymbol>(VariableName),
+        VariablesMap[Predecessor] = MakeVariable(Declaration, Name);
+      auto *Phi = new IRPhiNode(MakeVariable(Declaration, Name),
                                 std::move(VariablesMap));
       Block->Statements.insert(Block->Statements.begin(), Phi);
     }
@@ -227,8 +331,8 @@ void CFGBuilder::BuildSSAForm() {
   InsertPhiNodes();
 
   SSAForm SSABuilder(&CFGraph);
-  for (const auto &[Variable, _] : BlocksForVariable)
-    SSABuilder.Compute(Variable);
+  for (const auto &[Declaration, _] : BlocksForVariable)
+    SSABuilder.Compute(Declaration);
 }
 
 CFG &CFGBuilder::GetCFG() const { return CFGraph; }
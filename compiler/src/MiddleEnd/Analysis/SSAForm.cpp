@@ -14,18 +14,18 @@ namespace middleEnd {
 
 SSAForm::SSAForm(CFG *Graph) : CFGraph(Graph) {}
 
-void SSAForm::Compute(std::string_view Variable) {
+void SSAForm::Compute(unsigned Declaration) {
   SSAIndex = 0;
   std::stack<int>().swap(IndicesStack);
-  Compute(CFGraph->GetBlocks().front(), Variable);
+  Compute(CFGraph->GetBlocks().front(), Declaration);
 }
 
-void SSAForm::Compute(CFGBlock *Block, std::string_view Variable) {
+void SSAForm::Compute(CFGBlock *Block, unsigned Declaration) {
   for (const auto &Stmt : Block->Statements) {
     switch (Stmt->Type) {
     case IRNode::PHI: {
       const auto &Symbol = (static_cast<IRPhiNode *>(Stmt))->Variable;
-      if (Symbol->GetName() == Variable) {
+      if (Symbol->GetDeclaration() == Declaration) {
         Symbol->SetSSAIndex(SSAIndex);
         IndicesStack.push(SSAIndex++);
       }
@@ -33,13 +33,13 @@ void SSAForm::Compute(CFGBlock *Block, std::string_view Variable) {
     }
     case IRNode::BRANCH: {
       for (auto *Symbol : VariableSearcher.AllVarsUsedInStatement(Stmt))
-        if (Symbol->GetName() == Variable)
+        if (Symbol->GetDeclaration() == Declaration)
           Symbol->SetSSAIndex(IndicesStack.top());
       break;
     }
     case IRNode::ASSIGN: {
       auto *Symbol = (static_cast<IRAssignment *>(Stmt))->GetVariable();
-      if (Symbol->GetName() == Variable) {
+      if (Symbol->GetDeclaration() == Declaration) {
         Symbol->SetSSAIndex(SSAIndex);
         IndicesStack.push(SSAIndex++);
       }
@@ -56,20 +56,20 @@ void SSAForm::Compute(CFGBlock *Block, std::string_view Variable) {
         continue;
       auto *PhiNode = static_cast<IRPhiNode *>(Stmt);
       if (PhiNode->VariableMap.count(Block) &&
-          PhiNode->VariableMap[Block]->GetName() == Variable &&
+          PhiNode->VariableMap[Block]->GetDeclaration() == Declaration &&
           !IndicesStack.empty())
         PhiNode->VariableMap[Block]->SetSSAIndex(IndicesStack.top());
     }
   }
 
   for (auto *Child : Block->DominatingBlocks)
-    Compute(Child, Variable);
+    Compute(Child, Declaration);
 
   for (const auto &Stmt : Block->Statements) {
     if (Stmt->Type != IRNode::ASSIGN)
       continue;
     auto *Symbol = (static_cast<IRAssignment *>(Stmt))->GetVariable();
-    if (Symbol->GetName() == Variable)
+    if (Symbol->GetDeclaration() == Declaration)
       IndicesStack.pop();
   }
 }
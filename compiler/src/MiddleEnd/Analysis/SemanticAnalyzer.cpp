@@ -0,0 +1,346 @@
+/* SemanticAnalyzer.cpp - Type checking of AST.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "MiddleEnd/Analysis/SemanticAnalyzer.hpp"
+#include "Utility/Diagnostic.hpp"
+#include <cassert>
+
+using namespace weak::frontEnd;
+
+namespace {
+
+bool IsIntegral(TokenType Type) {
+  return Type == TokenType::INT || Type == TokenType::CHAR;
+}
+
+bool IsArithmetic(TokenType Type) {
+  return IsIntegral(Type) || Type == TokenType::FLOAT;
+}
+
+bool IsScalar(TokenType Type) {
+  return IsArithmetic(Type) || Type == TokenType::BOOLEAN;
+}
+
+/// \return operator, applied by compound assignment, or NONE.
+TokenType GetCompoundOperation(TokenType Operation) {
+  switch (Operation) {
+  case TokenType::MUL_ASSIGN:
+    return TokenType::STAR;
+  case TokenType::DIV_ASSIGN:
+    return TokenType::SLASH;
+  case TokenType::MOD_ASSIGN:
+    return TokenType::MOD;
+  case TokenType::PLUS_ASSIGN:
+    return TokenType::PLUS;
+  case TokenType::MINUS_ASSIGN:
+    return TokenType::MINUS;
+  case TokenType::SHL_ASSIGN:
+    return TokenType::SHL;
+  case TokenType::SHR_ASSIGN:
+    return TokenType::SHR;
+  case TokenType::BIT_AND_ASSIGN:
+    return TokenType::BIT_AND;
+  case TokenType::BIT_OR_ASSIGN:
+    return TokenType::BIT_OR;
+  case TokenType::XOR_ASSIGN:
+    return TokenType::XOR;
+  default:
+    return TokenType::NONE;
+  }
+}
+
+/// \return type of binary operation on operands of given types or NONE
+///         if operands are not allowed.
+TokenType GetBinaryType(TokenType Operation, TokenType LHS, TokenType RHS) {
+  switch (Operation) {
+  case TokenType::PLUS:
+  case TokenType::MINUS:
+  case TokenType::STAR:
+  case TokenType::SLASH:
+    if (!IsArithmetic(LHS) || !IsArithmetic(RHS))
+      return TokenType::NONE;
+    return LHS == TokenType::FLOAT || RHS == TokenType::FLOAT
+               ? TokenType::FLOAT
+               : TokenType::INT;
+  case TokenType::MOD:
+  case TokenType::SHL:
+  case TokenType::SHR:
+  case TokenType::BIT_AND:
+  case TokenType::BIT_OR:
+  case TokenType::XOR:
+    return IsIntegral(LHS) && IsIntegral(RHS) ? TokenType::INT
+                                              : TokenType::NONE;
+  case TokenType::LT:
+  case TokenType::GT:
+  case TokenType::LE:
+  case TokenType::GE:
+    return IsArithmetic(LHS) && IsArithmetic(RHS) ? TokenType::BOOLEAN
+                                                  : TokenType::NONE;
+  case TokenType::EQ:
+  case TokenType::NEQ:
+    if (IsArithmetic(LHS) && IsArithmetic(RHS))
+      return TokenType::BOOLEAN;
+    return LHS == RHS && LHS != TokenType::VOID ? TokenType::BOOLEAN
+                                                : TokenType::NONE;
+  case TokenType::AND:
+  case TokenType::OR:
+    return IsScalar(LHS) && IsScalar(RHS) ? TokenType::BOOLEAN
+                                          : TokenType::NONE;
+  default:
+    return TokenType::NONE;
+  }
+}
+
+} // namespace
+
+namespace weak {
+namespace middleEnd {
+
+SemanticAnalyzer::SemanticAnalyzer(frontEnd::ASTNode *TheRoot)
+    : Root(TheRoot), Functions(), CurrentFunction(nullptr), VariableTypes(),
+      ErrorRecovery(false), Diagnostics() {
+  assert(Root);
+}
+
+void SemanticAnalyzer::Analyze() {
+  if (Root->GetASTType() == ASTType::COMPOUND_STMT) {
+    const auto *Program = static_cast<const ASTCompoundStmt *>(Root);
+    for (const ASTNode *Node : Program->GetStmts()) {
+      if (Node->GetASTType() != ASTType::FUNCTION_DECL)
+        continue;
+      const auto *Function = static_cast<const ASTFunctionDecl *>(Node);
+      if (!Functions.emplace(Function->GetName(), Function).second)
+        ReportError(Function, "Function redefined: " +
+                                  std::string(Function->GetName()));
+    }
+  }
+  Traverse(Root);
+}
+
+void SemanticAnalyzer::EnableErrorRecovery() { ErrorRecovery = true; }
+
+const std::vector<SemanticDiagnostic> &
+SemanticAnalyzer::GetDiagnostics() const {
+  return Diagnostics;
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTBinaryOperator *Binary) {
+  Traverse(Binary->GetLHS());
+  Traverse(Binary->GetRHS());
+  TokenType LHS = Binary->GetLHS()->GetExprType();
+  TokenType RHS = Binary->GetRHS()->GetExprType();
+  if (LHS == TokenType::NONE || RHS == TokenType::NONE)
+    return;
+
+  if (Binary->GetOperation() == TokenType::ASSIGN) {
+    if (!CheckAssignable(Binary->GetLHS()))
+      return;
+    CheckConversion(Binary->GetRHS(), RHS, LHS);
+    Binary->SetExprType(LHS);
+    return;
+  }
+
+  TokenType Operation = GetCompoundOperation(Binary->GetOperation());
+  bool IsCompound = Operation != TokenType::NONE;
+  if (!IsCompound)
+    Operation = Binary->GetOperation();
+
+  TokenType Result = GetBinaryType(Operation, LHS, RHS);
+  if (Result == TokenType::NONE) {
+    ReportError(Binary, std::string("Invalid operands of ") +
+                            TokenToString(Binary->GetOperation()) + ": " +
+                            TokenToString(LHS) + " and " +
+                            TokenToString(RHS));
+    return;
+  }
+  if (IsCompound) {
+    if (!CheckAssignable(Binary->GetLHS()))
+      return;
+    CheckConversion(Binary, Result, LHS);
+    Result = LHS;
+  }
+  Binary->SetExprType(Result);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTBooleanLiteral *Boolean) {
+  Boolean->SetExprType(TokenType::BOOLEAN);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTCompoundStmt *CompoundStmt) {
+  RecursiveASTVisitor::Visit(CompoundStmt);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTDoWhileStmt *DoWhileStmt) {
+  Traverse(DoWhileStmt->GetBody());
+  Traverse(DoWhileStmt->GetCondition());
+  CheckCondition(DoWhileStmt->GetCondition());
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTFloatingPointLiteral *Float) {
+  Float->SetExprType(TokenType::FLOAT);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTForStmt *ForStmt) {
+  Traverse(ForStmt->GetInit());
+  Traverse(ForStmt->GetCondition());
+  CheckCondition(ForStmt->GetCondition());
+  Traverse(ForStmt->GetIncrement());
+  Traverse(ForStmt->GetBody());
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTFunctionCall *FunctionCall) {
+  RecursiveASTVisitor::Visit(FunctionCall);
+
+  auto It = Functions.find(FunctionCall->GetName());
+  if (It == Functions.end()) {
+    ReportError(FunctionCall, "Function not declared: " +
+                                  std::string(FunctionCall->GetName()));
+    return;
+  }
+  const ASTFunctionDecl *Function = It->second;
+  ASTNodeList Arguments = FunctionCall->GetArguments();
+  ASTNodeList Parameters = Function->GetArguments();
+
+  if (Arguments.size() != Parameters.size())
+    ReportError(FunctionCall, "Expected " + std::to_string(Parameters.size()) +
+                                  " arguments, got " +
+                                  std::to_string(Arguments.size()));
+  else
+    for (unsigned I = 0U; I < Arguments.size(); ++I)
+      if (Parameters[I]->GetASTType() == ASTType::VAR_DECL)
+        CheckConversion(
+            Arguments[I], Arguments[I]->GetExprType(),
+            static_cast<const ASTVarDecl *>(Parameters[I])->GetDataType());
+
+  FunctionCall->SetExprType(Function->GetReturnType());
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTFunctionDecl *FunctionDecl) {
+  CurrentFunction = FunctionDecl;
+  RecursiveASTVisitor::Visit(FunctionDecl);
+  CurrentFunction = nullptr;
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTIfStmt *IfStmt) {
+  Traverse(IfStmt->GetCondition());
+  CheckCondition(IfStmt->GetCondition());
+  Traverse(IfStmt->GetThenBody());
+  Traverse(IfStmt->GetElseBody());
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTIntegerLiteral *Integer) {
+  Integer->SetExprType(TokenType::INT);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTReturnStmt *ReturnStmt) {
+  assert(CurrentFunction);
+  ASTNode *Operand = ReturnStmt->GetOperand();
+  TokenType Expected = CurrentFunction->GetReturnType();
+  if (!Operand) {
+    if (Expected != TokenType::VOID)
+      ReportError(ReturnStmt, "Return value expected");
+    return;
+  }
+  Traverse(Operand);
+  if (Expected == TokenType::VOID) {
+    ReportError(Operand, "Void function cannot return value");
+    return;
+  }
+  CheckConversion(Operand, Operand->GetExprType(), Expected);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTStringLiteral *String) {
+  String->SetExprType(TokenType::STRING);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTSymbol *Symbol) {
+  unsigned Declaration = Symbol->GetDeclaration();
+  if (Declaration == ASTVarDecl::NoDeclaration) {
+    ReportError(Symbol,
+                "Variable not declared: " + std::string(Symbol->GetName()));
+    return;
+  }
+  assert(Declaration < VariableTypes.size());
+  Symbol->SetExprType(VariableTypes[Declaration]);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTUnaryOperator *Unary) {
+  ASTNode *Operand = Unary->GetOperand();
+  Traverse(Operand);
+  TokenType Type = Operand->GetExprType();
+  if (Type == TokenType::NONE || !CheckAssignable(Operand))
+    return;
+  if (!IsArithmetic(Type)) {
+    ReportError(Unary, std::string("Invalid operand of ") +
+                           TokenToString(Unary->GetOperation()) + ": " +
+                           TokenToString(Type));
+    return;
+  }
+  Unary->SetExprType(Type);
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTVarDecl *VarDecl) {
+  if (ASTNode *Body = VarDecl->GetDeclareBody()) {
+    Traverse(Body);
+    CheckConversion(Body, Body->GetExprType(), VarDecl->GetDataType());
+  }
+  /// Declarations are numbered in order of traversal, but tree may be
+  /// a part of translation unit, so they do not start from zero.
+  unsigned Declaration = VarDecl->GetDeclaration();
+  assert(Declaration != ASTVarDecl::NoDeclaration);
+  if (Declaration >= VariableTypes.size())
+    VariableTypes.resize(Declaration + 1U, TokenType::NONE);
+  VariableTypes[Declaration] = VarDecl->GetDataType();
+}
+
+void SemanticAnalyzer::Visit(frontEnd::ASTWhileStmt *WhileStmt) {
+  Traverse(WhileStmt->GetCondition());
+  CheckCondition(WhileStmt->GetCondition());
+  Traverse(WhileStmt->GetBody());
+}
+
+void SemanticAnalyzer::CheckConversion(const frontEnd::ASTNode *At,
+                                       TokenType From, TokenType To) {
+  if (From == TokenType::NONE || From == To)
+    return;
+  if (IsArithmetic(From) && IsArithmetic(To))
+    return;
+  ReportError(At, std::string("Cannot convert ") + TokenToString(From) +
+                      " to " + TokenToString(To));
+}
+
+void SemanticAnalyzer::CheckCondition(const frontEnd::ASTNode *Condition) {
+  /// Condition of 'for' can be omitted.
+  if (!Condition)
+    return;
+  TokenType Type = Condition->GetExprType();
+  if (Type == TokenType::NONE || IsScalar(Type))
+    return;
+  ReportError(Condition, std::string("Condition must be scalar, got ") +
+                             TokenToString(Type));
+}
+
+bool SemanticAnalyzer::CheckAssignable(const frontEnd::ASTNode *Operand) {
+  if (Operand->GetASTType() == ASTType::SYMBOL)
+    return true;
+  ReportError(Operand, "Expression is not assignable");
+  return false;
+}
+
+void SemanticAnalyzer::ReportError(const frontEnd::ASTNode *At,
+                                   std::string Message) {
+  if (!ErrorRecovery) {
+    CompileError(At->GetLineNo() - 1, At->GetColumnNo() - 1)
+        << Message.c_str();
+    UnreachablePoint();
+  }
+  Diagnostics.push_back(SemanticDiagnostic{At->GetLineNo(),
+                                           At->GetColumnNo(),
+                                           std::move(Message)});
+}
+
+} // namespace middleEnd
+} // namespace weak
@@ -19,8 +19,6 @@ IRAssignment::IRAssignment(frontEnd::ASTNode *TheVariable,
     : IRNode(IRNode::ASSIGN), Variable(TheVariable),
       OperandView(TheOperandView) {}
 
-IRAssignment::~IRAssignment() { delete Variable; }
-
 std::string IRAssignment::Dump() const {
   assert(Variable);
   assert(OperandView);
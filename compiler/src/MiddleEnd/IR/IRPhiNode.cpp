@@ -11,21 +11,16 @@
 namespace weak {
 namespace middleEnd {
 
-IRPhiNode::IRPhiNode(std::unique_ptr<frontEnd::ASTSymbol> &&TheVariable,
+IRPhiNode::IRPhiNode(frontEnd::ASTSymbol *TheVariable,
                      std::map<CFGBlock *, frontEnd::ASTSymbol *> VarMap)
-    : IRNode(IRNode::PHI), Variable(std::move(TheVariable)),
+    : IRNode(IRNode::PHI), Variable(TheVariable),
       VariableMap(std::move(VarMap)) {}
 
-IRPhiNode::~IRPhiNode() {
-  for ([[maybe_unused]] auto [NodeView, Symbol] : VariableMap)
-    delete Symbol;
-}
-
 std::string IRPhiNode::Dump() const {
   std::string Result;
 
   for (const auto &[Block, Symbol] : VariableMap)
-    Result += Block->ToString() + ":" + Symbol->GetName() + ", ";
+    Result += Block->ToString() + ":" + std::string(Symbol->GetName()) + ", ";
 
   if (!Result.empty()) {
     Result.pop_back();
@@ -6,6 +6,7 @@
 
 #include "MiddleEnd/IR/VariableSearchVisitor.hpp"
 #include "FrontEnd/AST/ASTBinaryOperator.hpp"
+#include "FrontEnd/AST/ASTTraversal.hpp"
 #include "MiddleEnd/IR/IRAssignment.hpp"
 #include "MiddleEnd/IR/IRBranch.hpp"
 
@@ -23,24 +24,36 @@ VariableSearchVisitor::AllVarsUsedInStatement(IRNode *Stmt) {
 
 void VariableSearchVisitor::Visit(const IRBranch *Stmt) const {
   if (Stmt->ConditionView)
-    Stmt->ConditionView->Accept(this);
+    Search(Stmt->ConditionView);
 }
 
 void VariableSearchVisitor::Visit(const IRAssignment *Stmt) const {
-  Stmt->GetOperand()->Accept(this);
+  Search(Stmt->GetOperand());
 }
 
-void VariableSearchVisitor::Visit(const ASTSymbol *Stmt) const {
-  Variables.insert(const_cast<ASTSymbol *>(Stmt));
-}
-
-void VariableSearchVisitor::Visit(const ASTBinaryOperator *Stmt) const {
-  if (Stmt->GetOperation() == TokenType::ASSIGN) {
-    Variables.insert(static_cast<ASTSymbol *>(Stmt->GetLHS().get()));
+void VariableSearchVisitor::Search(const ASTNode *Expression) const {
+  for (ASTWalker Walker(Expression); Walker.Next();) {
+    if (Walker.IsLeaving())
+      continue;
+    const ASTNode *Node = Walker.GetNode();
+    switch (Node->GetASTType()) {
+    case ASTType::SYMBOL:
+      Variables.insert(
+          const_cast<ASTSymbol *>(static_cast<const ASTSymbol *>(Node)));
+      break;
+    case ASTType::BINARY: {
+      const auto *Binary = static_cast<const ASTBinaryOperator *>(Node);
+      if (Binary->GetOperation() == TokenType::ASSIGN)
+        Variables.insert(static_cast<ASTSymbol *>(Binary->GetLHS()));
+      break;
+    }
+    default:
+      /// Operands of other nodes are not searched.
+      Walker.SkipChildren();
+      break;
+    }
   }
-  Stmt->GetLHS()->Accept(this);
-  Stmt->GetRHS()->Accept(this);
 }
 
 } // namespace middleEnd
-} // namespace weak
\ No newline at end of file
+} // namespace weak
@@ -7,6 +7,7 @@
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "Utility/Diagnostic.hpp"
 #include <algorithm>
+#include <cassert>
 
 using namespace weak::frontEnd;
 using namespace weak::middleEnd;
@@ -14,75 +15,209 @@ using namespace weak::middleEnd;
 namespace weak {
 namespace middleEnd {
 
-void Storage::ScopeBegin() { ++CurrentScopeDepth; }
+Storage::Storage()
+    : Records(), Visible(), VisibleNames(0U), ScopeLog(), ScopeStarts(),
+      StringLiterals(), FloatingPointLiterals(), FreeStringLiterals(),
+      FreeFloatingPointLiterals() {}
+
+void Storage::ScopeBegin() { ScopeStarts.push_back(ScopeLog.size()); }
 
 void Storage::ScopeEnd() {
-  if (CurrentScopeDepth == 0) {
+  if (ScopeStarts.empty()) {
     CompileError() << "No scopes left.";
     UnreachablePoint();
   }
 
-  for (auto It = Records.begin(); It != Records.end();) {
-    if (It->second.Depth == CurrentScopeDepth) {
-      It = Records.erase(It);
-    } else {
-      ++It;
-    }
+  while (ScopeLog.size() > ScopeStarts.back()) {
+    Record &R = Records[ScopeLog.back()];
+    R.Closed = true;
+    GetVisible(R.Name) = R.Shadowed;
+    ScopeLog.pop_back();
   }
-  --CurrentScopeDepth;
+  ScopeStarts.pop_back();
 }
 
 unsigned Storage::AddSymbol(std::string_view Name) {
-  auto Found = std::find_if(Records.begin(), Records.end(),
-                            [&](const std::pair<unsigned, Record> &R) {
-                              return R.second.Name == Name;
-                            });
-  if (Found == Records.end()) {
-    Record Variable{/*Depth=*/CurrentScopeDepth,
-                    /*Attribute=*/CurrentAttribute,
-                    /*TemporaryLabel=*/0U,
-                    /*Name=*/Name.data(),
-                    /*DataType=*/TokenType::NONE};
-    unsigned SavedAttribute = CurrentAttribute;
-    Records.emplace(CurrentAttribute++, std::move(Variable));
-    return SavedAttribute;
+  return AddInternedSymbol(StringInterner::Global().Intern(Name));
+}
+
+unsigned Storage::AddInternedSymbol(StringInterner::ID Name) {
+  unsigned &Innermost = GetVisible(Name);
+  if (Innermost != NoAttribute)
+    return Innermost;
+  return AddRecord(Name, Innermost);
+}
+
+unsigned Storage::AddDeclaration(StringInterner::ID Name) {
+  return AddRecord(Name, GetVisible(Name));
+}
+
+unsigned Storage::AddRecord(StringInterner::ID Name, unsigned &Innermost) {
+  auto Attribute = static_cast<unsigned>(Records.size());
+  Records.push_back(Record{/*Depth=*/static_cast<unsigned>(ScopeStarts.size()),
+                           /*Attribute=*/Attribute,
+                           /*TemporaryLabel=*/0U,
+                           /*Name=*/Name,
+                           /*Shadowed=*/Innermost,
+                           /*Closed=*/false,
+                           /*DataType=*/TokenType::NONE});
+  Innermost = Attribute;
+  ScopeLog.push_back(Attribute);
+  return Attribute;
+}
+
+unsigned Storage::Lookup(StringInterner::ID Name) const {
+  if (Visible.empty())
+    return NoAttribute;
+  std::size_t Mask = Visible.size() - 1U;
+  for (std::size_t I = HashName(Name) & Mask; Visible[I].Name != NoName;
+       I = (I + 1U) & Mask)
+    if (Visible[I].Name == Name)
+      return Visible[I].Attribute;
+  return NoAttribute;
+}
+
+std::size_t Storage::HashName(StringInterner::ID Name) {
+  /// Names are mostly consecutive, but may have strides, if other names
+  /// are interned between, so bits are mixed.
+  std::uint32_t Hash = Name * 0x9E3779B1U;
+  return Hash ^ (Hash >> 16U);
+}
+
+unsigned &Storage::GetVisible(StringInterner::ID Name) {
+  if ((VisibleNames + 1U) * 2U > Visible.size()) {
+    std::size_t Size = std::max<std::size_t>(16U, Visible.size() * 2U);
+    std::vector<VisibleName> Old(Size, VisibleName{NoName, NoAttribute});
+    Old.swap(Visible);
+    std::size_t Mask = Visible.size() - 1U;
+    for (const VisibleName &V : Old) {
+      if (V.Name == NoName)
+        continue;
+      std::size_t I = HashName(V.Name) & Mask;
+      while (Visible[I].Name != NoName)
+        I = (I + 1U) & Mask;
+      Visible[I] = V;
+    }
   }
 
-  const auto &[RecordAttribute, _] = *Found;
-  return RecordAttribute;
+  std::size_t Mask = Visible.size() - 1U;
+  std::size_t I = HashName(Name) & Mask;
+  for (; Visible[I].Name != NoName; I = (I + 1U) & Mask)
+    if (Visible[I].Name == Name)
+      return Visible[I].Attribute;
+  ++VisibleNames;
+  Visible[I].Name = Name;
+  return Visible[I].Attribute;
 }
 
-Storage::Record *Storage::GetSymbol(unsigned Attribute) {
-  auto Found = Records.find(Attribute);
+std::vector<unsigned> Storage::MergeSymbols(const Storage &Other) {
+  std::vector<unsigned> Attributes;
+  Attributes.reserve(Other.Records.size());
+  /// Records of closed scopes are merged too, since tokens still refer to
+  /// them. Log holds only variables of open scopes.
+  for (const Record &R : Other.Records)
+    Attributes.push_back(AddInternedSymbol(R.Name));
+  return Attributes;
+}
 
-  if (Found == Records.end() || Found->second.Depth > CurrentScopeDepth) {
+StringInterner::ID Storage::GetSymbolName(unsigned Attribute) const {
+  if (Attribute >= Records.size()) {
+    CompileError() << "Variable not found.";
+    UnreachablePoint();
+  }
+  return Records[Attribute].Name;
+}
+
+Storage::Record *Storage::GetSymbol(unsigned Attribute) {
+  if (Attribute >= Records.size() || Records[Attribute].Closed) {
     CompileError() << "Variable not found.";
     UnreachablePoint();
   }
 
-  return &Found->second;
+  return &Records[Attribute];
 }
 
 Storage::Record *Storage::GetByName(std::string_view Name) {
-  auto Found = std::find_if(Records.begin(), Records.end(),
-                            [&](const std::pair<unsigned, Record> &R) {
-                              return R.second.Name == Name;
-                            });
-  if (Found == Records.end()) {
+  unsigned Found = Lookup(StringInterner::Global().Intern(Name));
+  if (Found == NoAttribute) {
     CompileError() << "Variable not found: " << Name;
+    UnreachablePoint();
   }
 
-  auto &[_, Variable] = *Found;
-  return &Variable;
+  return &Records[Found];
 }
 
 void Storage::SetSymbolType(unsigned Attribute, TokenType Type) {
-  auto Found = Records.find(Attribute);
-  if (Found == Records.end()) {
+  if (Attribute >= Records.size() || Records[Attribute].Closed) {
     CompileError() << "Attempt to set type for variable that not exists.";
     UnreachablePoint();
   }
-  Found->second.DataType = Type;
+  Records[Attribute].DataType = Type;
+}
+
+TokenType Storage::GetSymbolType(unsigned Attribute) const {
+  if (Attribute >= Records.size()) {
+    CompileError() << "Variable not found.";
+    UnreachablePoint();
+  }
+  return Records[Attribute].DataType;
+}
+
+unsigned Storage::AddStringLiteral(std::string &&Literal) {
+  if (!FreeStringLiterals.empty()) {
+    unsigned Index = FreeStringLiterals.back();
+    FreeStringLiterals.pop_back();
+    StringLiterals[Index] = std::move(Literal);
+    return Index;
+  }
+  StringLiterals.push_back(std::move(Literal));
+  return StringLiterals.size() - 1;
+}
+
+void Storage::RemoveStringLiteral(unsigned Index) {
+  assert(Index < StringLiterals.size());
+  /// Release memory of long literals right away.
+  std::string().swap(StringLiterals[Index]);
+  FreeStringLiterals.push_back(Index);
+}
+
+std::string_view Storage::GetStringLiteral(unsigned Index) const {
+  assert(Index < StringLiterals.size());
+  return StringLiterals[Index];
+}
+
+unsigned Storage::AddFloatingPointLiteral(double Value) {
+  if (!FreeFloatingPointLiterals.empty()) {
+    unsigned Index = FreeFloatingPointLiterals.back();
+    FreeFloatingPointLiterals.pop_back();
+    FloatingPointLiterals[Index] = Value;
+    return Index;
+  }
+  FloatingPointLiterals.push_back(Value);
+  return FloatingPointLiterals.size() - 1;
+}
+
+void Storage::RemoveFloatingPointLiteral(unsigned Index) {
+  assert(Index < FloatingPointLiterals.size());
+  FreeFloatingPointLiterals.push_back(Index);
+}
+
+double Storage::GetFloatingPointLiteral(unsigned Index) const {
+  assert(Index < FloatingPointLiterals.size());
+  return FloatingPointLiterals[Index];
+}
+
+Storage::LiteralOffsets Storage::MergeLiterals(const Storage &Other) {
+  LiteralOffsets Offsets{
+      /*StringLiteral=*/static_cast<unsigned>(StringLiterals.size()),
+      /*FloatingPointLiteral=*/
+      static_cast<unsigned>(FloatingPointLiterals.size())};
+  StringLiterals.insert(StringLiterals.end(), Other.StringLiterals.begin(),
+                        Other.StringLiterals.end());
+  FloatingPointLiterals.insert(FloatingPointLiterals.end(),
+                               Other.FloatingPointLiterals.begin(),
+                               Other.FloatingPointLiterals.end());
+  return Offsets;
 }
 
 } // namespace middleEnd
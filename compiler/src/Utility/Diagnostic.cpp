@@ -66,4 +66,10 @@ weak::OstreamRAII weak::CompileError() {
 weak::OstreamRAII weak::CompileError(unsigned LineNo, unsigned ColumnNo) {
   [[maybe_unused]] Diagnostic _(Diagnostic::DiagLevel::ERROR, LineNo, ColumnNo);
   return OstreamRAII{OstreamRAII::ShouldTerminate};
-}
\ No newline at end of file
+}
+
+void weak::PrintError(unsigned LineNo, unsigned ColumnNo,
+                      const char *Message) {
+  [[maybe_unused]] Diagnostic _(Diagnostic::DiagLevel::ERROR, LineNo, ColumnNo);
+  std::cerr << Message << std::endl;
+}
@@ -0,0 +1,134 @@
+/* StringInterner.cpp - Table of unique strings.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "Utility/StringInterner.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+namespace weak {
+
+StringInterner::Shard::Shard()
+    : Chunks(), ChunkPtr(nullptr), ChunkEnd(nullptr),
+      Buckets(16U, Bucket{0U, EmptyBucket}), Count(0U), Lock() {}
+
+StringInterner::StringInterner()
+    : Shards(), Pages(new std::atomic<std::string_view *>[PagesCount]()),
+      NextIdentifier(0U) {}
+
+StringInterner::~StringInterner() {
+  for (std::size_t I = 0U; I < PagesCount; ++I)
+    delete[] Pages[I].load(std::memory_order_relaxed);
+}
+
+StringInterner::ID StringInterner::Intern(std::string_view String) {
+  std::size_t FullHash = std::hash<std::string_view>()(String);
+  /// Low bits select bucket inside shard, so take high bits for shard.
+  Shard &S = Shards[FullHash >> (std::numeric_limits<std::size_t>::digits -
+                                 ShardBits)];
+  auto Hash = static_cast<std::uint32_t>(FullHash);
+  std::size_t I = 0U;
+
+  {
+    /// Most of identifiers are already known, so look up first without
+    /// blocking other readers.
+    std::shared_lock Reader(S.Lock);
+    if (ID Found = S.Find(*this, String, Hash, I); Found != EmptyBucket)
+      return Found;
+  }
+
+  std::unique_lock Writer(S.Lock);
+  /// Other thread might add the same string between locks.
+  if (ID Found = S.Find(*this, String, Hash, I); Found != EmptyBucket)
+    return Found;
+
+  ID Identifier = NextIdentifier.fetch_add(1U, std::memory_order_relaxed);
+  Publish(Identifier, S.Store(String));
+  S.Buckets[I] = Bucket{Hash, Identifier};
+  if (++S.Count * 2U > S.Buckets.size())
+    S.Grow();
+  return Identifier;
+}
+
+std::string_view StringInterner::GetString(ID Identifier) const {
+  assert(Identifier < NextIdentifier.load(std::memory_order_relaxed));
+  const std::string_view *Page =
+      Pages[Identifier >> PageBits].load(std::memory_order_acquire);
+  assert(Page);
+  return Page[Identifier & (PageSize - 1U)];
+}
+
+unsigned StringInterner::Size() const {
+  return NextIdentifier.load(std::memory_order_relaxed);
+}
+
+StringInterner &StringInterner::Global() {
+  static StringInterner Interner;
+  return Interner;
+}
+
+void StringInterner::Publish(ID Identifier, std::string_view String) {
+  std::atomic<std::string_view *> &Slot = Pages[Identifier >> PageBits];
+  std::string_view *Page = Slot.load(std::memory_order_acquire);
+  if (!Page) {
+    auto *NewPage = new std::string_view[PageSize];
+    /// On failure Page is set to page of other thread.
+    if (Slot.compare_exchange_strong(Page, NewPage,
+                                     std::memory_order_acq_rel))
+      Page = NewPage;
+    else
+      delete[] NewPage;
+  }
+  Page[Identifier & (PageSize - 1U)] = String;
+}
+
+StringInterner::ID
+StringInterner::Shard::Find(const StringInterner &Interner,
+                            std::string_view String, std::uint32_t Hash,
+                            std::size_t &I) const {
+  std::size_t Mask = Buckets.size() - 1U;
+  for (I = Hash & Mask; Buckets[I].Identifier != EmptyBucket;
+       I = (I + 1U) & Mask) {
+    const Bucket &B = Buckets[I];
+    if (B.Hash == Hash && Interner.GetString(B.Identifier) == String)
+      return B.Identifier;
+  }
+  return EmptyBucket;
+}
+
+std::string_view StringInterner::Shard::Store(std::string_view String) {
+  if (String.empty())
+    return {};
+  if (static_cast<std::size_t>(ChunkEnd - ChunkPtr) < String.size()) {
+    std::size_t NewChunkSize = std::max(ChunkSize, String.size());
+    Chunks.emplace_back(new char[NewChunkSize]);
+    ChunkPtr = Chunks.back().get();
+    ChunkEnd = ChunkPtr + NewChunkSize;
+  }
+  std::memcpy(ChunkPtr, String.data(), String.size());
+  std::string_view Stored(ChunkPtr, String.size());
+  ChunkPtr += String.size();
+  return Stored;
+}
+
+void StringInterner::Shard::Grow() {
+  std::vector<Bucket> Old(Buckets.size() * 2U, Bucket{0U, EmptyBucket});
+  Old.swap(Buckets);
+  std::size_t Mask = Buckets.size() - 1U;
+  for (const Bucket &B : Old) {
+    if (B.Identifier == EmptyBucket)
+      continue;
+    std::size_t I = B.Hash & Mask;
+    while (Buckets[I].Identifier != EmptyBucket)
+      I = (I + 1U) & Mask;
+    Buckets[I] = B;
+  }
+}
+
+} // namespace weak
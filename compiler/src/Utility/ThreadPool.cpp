@@ -0,0 +1,68 @@
+/* ThreadPool.cpp - Fixed-size pool of worker threads.
+ * Copyright (C) 2022 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "Utility/ThreadPool.hpp"
+#include <algorithm>
+
+namespace weak {
+
+ThreadPool::ThreadPool(unsigned TheThreads) {
+  if (TheThreads == 0U)
+    TheThreads = std::max(1U, std::thread::hardware_concurrency());
+
+  Workers.reserve(TheThreads);
+  for (unsigned I = 0U; I < TheThreads; ++I)
+    Workers.emplace_back([this] { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stopping = true;
+  }
+  TaskAvailable.notify_all();
+  for (std::thread &Worker : Workers)
+    Worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> Task) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Tasks.push_back(std::move(Task));
+    ++PendingTasks;
+  }
+  TaskAvailable.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  TasksDone.wait(Lock, [this] { return PendingTasks == 0U; });
+}
+
+unsigned ThreadPool::TotalThreads() const { return Workers.size(); }
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> Task;
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      TaskAvailable.wait(Lock, [this] { return Stopping || !Tasks.empty(); });
+      if (Tasks.empty())
+        return;
+      Task = std::move(Tasks.front());
+      Tasks.pop_front();
+    }
+
+    Task();
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (--PendingTasks == 0U)
+      TasksDone.notify_all();
+  }
+}
+
+} // namespace weak
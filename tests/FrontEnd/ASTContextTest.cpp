@@ -0,0 +1,75 @@
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTIntegerLiteral.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "TestHelpers.hpp"
+#include <cstdint>
+
+using namespace weak::frontEnd;
+
+int main() {
+  SECTION(NodesAreAllocatedInOneSlab) {
+    ASTContext Context;
+    std::vector<ASTNode *> Nodes;
+    for (signed I = 0; I < 100; ++I)
+      Nodes.push_back(Context.Make<ASTIntegerLiteral>(I, 1U, I + 1U));
+    TEST_CASE(Context.TotalSlabs() == 1U);
+    for (signed I = 0; I < 100; ++I) {
+      auto *Literal = static_cast<ASTIntegerLiteral *>(Nodes[I]);
+      TEST_CASE(Literal->GetValue() == I);
+      TEST_CASE(Literal->GetColumnNo() == I + 1U);
+      auto Address = reinterpret_cast<std::uintptr_t>(Literal);
+      TEST_CASE(Address % alignof(ASTIntegerLiteral) == 0U);
+    }
+  }
+  SECTION(StringsAreCopied) {
+    ASTContext Context;
+    std::string Name = "variable";
+    auto *Symbol = Context.Make<ASTSymbol>(Context.MakeString(Name));
+    Name = "changed";
+    TEST_CASE(Symbol->GetName() == "variable");
+    TEST_CASE(Context.MakeString("").empty());
+  }
+  SECTION(ListsAreCopied) {
+    ASTContext Context;
+    std::vector<ASTNode *> Nodes;
+    for (signed I = 0; I < 3; ++I)
+      Nodes.push_back(Context.Make<ASTIntegerLiteral>(I));
+    auto *Compound = Context.Make<ASTCompoundStmt>(Context.MakeList(Nodes));
+    Nodes.clear();
+    TEST_CASE(Compound->GetStmts().size() == 3U);
+    signed Expected = 0;
+    for (ASTNode *Stmt : Compound->GetStmts())
+      TEST_CASE(static_cast<ASTIntegerLiteral *>(Stmt)->GetValue() ==
+                Expected++);
+    TEST_CASE(Context.MakeList({}).empty());
+  }
+  SECTION(LargeAllocationsGetOwnSlab) {
+    ASTContext Context;
+    Context.Make<ASTIntegerLiteral>(0);
+    std::string Large(1024U * 1024U, 'a');
+    std::string_view Copy = Context.MakeString(Large);
+    TEST_CASE(Copy == Large);
+    TEST_CASE(Context.TotalSlabs() == 2U);
+    TEST_CASE(Context.TotalAllocated() ==
+              sizeof(ASTIntegerLiteral) + Large.size());
+  }
+  SECTION(AdoptedNodesOutliveContext) {
+    ASTContext Context;
+    Context.Make<ASTIntegerLiteral>(0);
+    ASTIntegerLiteral *Literal = nullptr;
+    {
+      ASTContext Local;
+      Literal = Local.Make<ASTIntegerLiteral>(1);
+      Context.Adopt(Local);
+      TEST_CASE(Local.TotalSlabs() == 0U);
+      TEST_CASE(Local.TotalAllocated() == 0U);
+    }
+    TEST_CASE(Literal->GetValue() == 1);
+    TEST_CASE(Context.TotalSlabs() == 2U);
+    TEST_CASE(Context.TotalAllocated() == 2U * sizeof(ASTIntegerLiteral));
+    /// Allocation continues in the original slab.
+    Context.Make<ASTIntegerLiteral>(2);
+    TEST_CASE(Context.TotalSlabs() == 2U);
+  }
+}
@@ -5,6 +5,7 @@
 #include "FrontEnd/AST/ASTBooleanLiteral.hpp"
 #include "FrontEnd/AST/ASTBreakStmt.hpp"
 #include "FrontEnd/AST/ASTCompoundStmt.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
 #include "FrontEnd/AST/ASTContinueStmt.hpp"
 #include "FrontEnd/AST/ASTDoWhileStmt.hpp"
 #include "FrontEnd/AST/ASTFloatingPointLiteral.hpp"
@@ -22,102 +23,82 @@
 
 using namespace weak::frontEnd;
 
-static std::unique_ptr<ASTNode> MakeBreak() {
-  return std::make_unique<ASTBreakStmt>();
-}
+/// Owner of all nodes, created in test.
+static ASTContext TestContext;
 
-static std::unique_ptr<ASTNode> MakeContinue() {
-  return std::make_unique<ASTContinueStmt>();
-}
+static ASTNode *MakeBreak() { return TestContext.Make<ASTBreakStmt>(); }
+
+static ASTNode *MakeContinue() { return TestContext.Make<ASTContinueStmt>(); }
 
-static std::unique_ptr<ASTNode> MakeReturn(std::unique_ptr<ASTNode> &&Operand) {
-  return std::make_unique<ASTReturnStmt>(std::move(Operand));
+static ASTNode *MakeReturn(ASTNode *Operand) {
+  return TestContext.Make<ASTReturnStmt>(Operand);
 }
 
-static std::unique_ptr<ASTNode> MakeBoolean(bool Value) {
-  return std::make_unique<ASTBooleanLiteral>(Value);
+static ASTNode *MakeBoolean(bool Value) {
+  return TestContext.Make<ASTBooleanLiteral>(Value);
 }
 
-static std::unique_ptr<ASTNode> MakeFloat(double Value) {
-  return std::make_unique<ASTFloatingPointLiteral>(Value);
+static ASTNode *MakeFloat(double Value) {
+  return TestContext.Make<ASTFloatingPointLiteral>(Value);
 }
 
-static std::unique_ptr<ASTNode> MakeInteger(signed Value) {
-  return std::make_unique<ASTIntegerLiteral>(Value);
+static ASTNode *MakeInteger(signed Value) {
+  return TestContext.Make<ASTIntegerLiteral>(Value);
 }
 
-static std::unique_ptr<ASTNode> MakeString(std::string Value) {
-  return std::make_unique<ASTStringLiteral>(std::move(Value));
+static ASTNode *MakeString(std::string_view Value) {
+  return TestContext.Make<ASTStringLiteral>(TestContext.MakeString(Value));
 }
 
-static std::unique_ptr<ASTNode> MakeBinary(TokenType Type,
-                                           std::unique_ptr<ASTNode> &&LHS,
-                                           std::unique_ptr<ASTNode> &&RHS) {
-  return std::make_unique<ASTBinaryOperator>(Type, std::move(LHS),
-                                             std::move(RHS));
+static ASTNode *MakeBinary(TokenType Type, ASTNode *LHS, ASTNode *RHS) {
+  return TestContext.Make<ASTBinaryOperator>(Type, LHS, RHS);
 }
 
-static std::unique_ptr<ASTNode> MakeUnary(ASTUnaryOperator::UnaryType Type,
-                                          TokenType Operation,
-                                          std::unique_ptr<ASTNode> &&Operand) {
-  return std::make_unique<ASTUnaryOperator>(Type, Operation,
-                                            std::move(Operand));
+static ASTNode *MakeUnary(ASTUnaryOperator::UnaryType Type,
+                          TokenType Operation, ASTNode *Operand) {
+  return TestContext.Make<ASTUnaryOperator>(Type, Operation, Operand);
 }
 
-static std::unique_ptr<ASTCompoundStmt>
-MakeCompound(std::vector<std::unique_ptr<ASTNode>> &&Nodes) {
-  return std::make_unique<ASTCompoundStmt>(std::move(Nodes));
+static ASTCompoundStmt *MakeCompound(const std::vector<ASTNode *> &Nodes) {
+  return TestContext.Make<ASTCompoundStmt>(TestContext.MakeList(Nodes));
 }
 
-static std::unique_ptr<ASTNode>
-MakeIf(std::unique_ptr<ASTNode> &&Condition,
-       std::unique_ptr<ASTCompoundStmt> &&ThenBody,
-       std::unique_ptr<ASTCompoundStmt> &&ElseBody) {
-  return std::make_unique<ASTIfStmt>(std::move(Condition), std::move(ThenBody),
-                                     std::move(ElseBody));
+static ASTNode *MakeIf(ASTNode *Condition, ASTCompoundStmt *ThenBody,
+                       ASTCompoundStmt *ElseBody) {
+  return TestContext.Make<ASTIfStmt>(Condition, ThenBody, ElseBody);
 }
 
-static std::unique_ptr<ASTNode>
-MakeFor(std::unique_ptr<ASTNode> &&Init, std::unique_ptr<ASTNode> &&Condition,
-        std::unique_ptr<ASTNode> &&Increment,
-        std::unique_ptr<ASTCompoundStmt> &&TheBody) {
-  return std::make_unique<ASTForStmt>(std::move(Init), std::move(Condition),
-                                      std::move(Increment), std::move(TheBody));
+static ASTNode *MakeFor(ASTNode *Init, ASTNode *Condition, ASTNode *Increment,
+                        ASTCompoundStmt *TheBody) {
+  return TestContext.Make<ASTForStmt>(Init, Condition, Increment, TheBody);
 }
 
-static std::unique_ptr<ASTNode>
-MakeWhile(std::unique_ptr<ASTNode> &&Condition,
-          std::unique_ptr<ASTCompoundStmt> &&Body) {
-  return std::make_unique<ASTWhileStmt>(std::move(Condition), std::move(Body));
+static ASTNode *MakeWhile(ASTNode *Condition, ASTCompoundStmt *Body) {
+  return TestContext.Make<ASTWhileStmt>(Condition, Body);
 }
 
-static std::unique_ptr<ASTNode>
-MakeDoWhile(std::unique_ptr<ASTCompoundStmt> &&Body,
-            std::unique_ptr<ASTNode> &&Condition) {
-  return std::make_unique<ASTDoWhileStmt>(std::move(Body),
-                                          std::move(Condition));
+static ASTNode *MakeDoWhile(ASTCompoundStmt *Body, ASTNode *Condition) {
+  return TestContext.Make<ASTDoWhileStmt>(Body, Condition);
 }
 
-static std::unique_ptr<ASTNode>
-MakeVarDecl(TokenType DataType, std::string &&SymbolName,
-            std::unique_ptr<ASTNode> &&DeclareBody) {
-  return std::make_unique<ASTVarDecl>(DataType, std::move(SymbolName),
-                                      std::move(DeclareBody));
+static ASTNode *MakeVarDecl(TokenType DataType, std::string_view SymbolName,
+                            ASTNode *DeclareBody) {
+  return TestContext.Make<ASTVarDecl>(
+      DataType, TestContext.MakeString(SymbolName), DeclareBody);
 }
 
-static std::unique_ptr<ASTNode>
-MakeFunction(TokenType ReturnType, std::string &&Name,
-             std::vector<std::unique_ptr<ASTNode>> &&Arguments,
-             std::unique_ptr<ASTCompoundStmt> &&Body) {
-  return std::make_unique<ASTFunctionDecl>(
-      ReturnType, std::move(Name), std::move(Arguments), std::move(Body));
+static ASTNode *MakeFunction(TokenType ReturnType, std::string_view Name,
+                             const std::vector<ASTNode *> &Arguments,
+                             ASTCompoundStmt *Body) {
+  return TestContext.Make<ASTFunctionDecl>(
+      ReturnType, TestContext.MakeString(Name),
+      TestContext.MakeList(Arguments), Body);
 }
 
-static std::unique_ptr<ASTNode>
-MakeFunctionCall(std::string &&Name,
-                 std::vector<std::unique_ptr<ASTNode>> &&Arguments) {
-  return std::make_unique<ASTFunctionCall>(std::move(Name),
-                                           std::move(Arguments));
+static ASTNode *MakeFunctionCall(std::string_view Name,
+                                 const std::vector<ASTNode *> &Arguments) {
+  return TestContext.Make<ASTFunctionCall>(TestContext.MakeString(Name),
+                                           TestContext.MakeList(Arguments));
 }
 
 #endif // WEAK_COMPILER_TESTS_FRONTEND_AST_MAKE_FUNCTIONS_HPP
\ No newline at end of file
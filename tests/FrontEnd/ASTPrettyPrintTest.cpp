@@ -6,7 +6,7 @@
 
 using weak::frontEnd::TokenType;
 
-void ASTPrettyPrintToStdout(const std::unique_ptr<ASTNode> &AST) {
+void ASTPrettyPrintToStdout(const ASTNode *AST) {
   ASTPrettyPrint(AST, std::cout);
 }
 
@@ -33,34 +33,34 @@ int main() {
   }
 
   SECTION(IfStmt) {
-    std::vector<std::unique_ptr<ASTNode>> IfBlockStmts;
-    std::vector<std::unique_ptr<ASTNode>> ElseBlockStmts;
+    std::vector<ASTNode *> IfBlockStmts;
+    std::vector<ASTNode *> ElseBlockStmts;
 
     for (signed It = 0; It < 5; ++It)
       IfBlockStmts.push_back(MakeInteger(It));
     for (signed It = 5; It >= 0; --It)
       ElseBlockStmts.push_back(MakeInteger(It));
 
-    std::vector<std::unique_ptr<ASTNode>> IfBlockStmts2;
-    std::vector<std::unique_ptr<ASTNode>> ElseBlockStmts2;
+    std::vector<ASTNode *> IfBlockStmts2;
+    std::vector<ASTNode *> ElseBlockStmts2;
 
     for (signed It = 0; It < 5; ++It)
       IfBlockStmts2.push_back(MakeInteger(It));
     for (signed It = 5; It >= 0; --It)
       ElseBlockStmts2.push_back(MakeInteger(It));
 
-    auto If = MakeIf(MakeInteger(0), MakeCompound(std::move(IfBlockStmts2)),
-                     MakeCompound(std::move(ElseBlockStmts2)));
+    auto If = MakeIf(MakeInteger(0), MakeCompound(IfBlockStmts2),
+                     MakeCompound(ElseBlockStmts2));
 
-    ElseBlockStmts.push_back(std::move(If));
+    ElseBlockStmts.push_back(If);
     ElseBlockStmts.push_back(MakeString("Хоп хей"));
 
-    ASTPrettyPrintToStdout(MakeIf(MakeInteger(0), MakeCompound(std::move(IfBlockStmts)),
-                          MakeCompound(std::move(ElseBlockStmts))));
+    ASTPrettyPrintToStdout(MakeIf(MakeInteger(0), MakeCompound(IfBlockStmts),
+                          MakeCompound(ElseBlockStmts)));
   }
 
   SECTION(ForStmt) {
-    std::vector<std::unique_ptr<ASTNode>> ForBlockStmts;
+    std::vector<ASTNode *> ForBlockStmts;
 
     for (signed It = 0; It < 5; ++It)
       ForBlockStmts.push_back(MakeInteger(It));
@@ -70,27 +70,27 @@ int main() {
                 MakeBinary(TokenType::NEQ, MakeInteger(1), MakeInteger(2)),
                 MakeUnary(ASTUnaryOperator::UnaryType::POSTFIX, TokenType::INC,
                           MakeString("123")),
-                MakeCompound(std::move(ForBlockStmts))));
+                MakeCompound(ForBlockStmts)));
   }
 
   SECTION(WhileStmt) {
-    std::vector<std::unique_ptr<ASTNode>> WhileBlockStmts;
+    std::vector<ASTNode *> WhileBlockStmts;
 
     for (signed It = 0; It < 5; ++It)
       WhileBlockStmts.push_back(MakeInteger(It));
 
     ASTPrettyPrintToStdout(
-        MakeWhile(MakeInteger(1), MakeCompound(std::move(WhileBlockStmts))));
+        MakeWhile(MakeInteger(1), MakeCompound(WhileBlockStmts)));
   }
 
   SECTION(DoWhileStmt) {
-    std::vector<std::unique_ptr<ASTNode>> WhileBlockStmts;
+    std::vector<ASTNode *> WhileBlockStmts;
 
     for (signed It = 0; It < 5; ++It)
       WhileBlockStmts.push_back(MakeInteger(It));
 
     ASTPrettyPrintToStdout(
-        MakeDoWhile(MakeCompound(std::move(WhileBlockStmts)), MakeInteger(1)));
+        MakeDoWhile(MakeCompound(WhileBlockStmts), MakeInteger(1)));
   }
 
   SECTION(ReturnStmt) {
@@ -108,23 +108,22 @@ int main() {
   }
 
   SECTION(FunctionDecl) {
-    std::vector<std::unique_ptr<ASTNode>> Arguments, Body;
+    std::vector<ASTNode *> Arguments, Body;
     Arguments.push_back(MakeString("Arg"));
     Body.push_back(
         MakeBinary(TokenType::PLUS_ASSIGN, MakeInteger(10), MakeInteger(20)));
 
     ASTPrettyPrintToStdout(MakeFunction(TokenType::VOID, "FunctionName",
-                                std::move(Arguments),
-                                MakeCompound(std::move(Body))));
+                                        Arguments, MakeCompound(Body)));
   }
 
   SECTION(FunctionCall) {
-    std::vector<std::unique_ptr<ASTNode>> Arguments;
+    std::vector<ASTNode *> Arguments;
     Arguments.push_back(MakeString("Arg"));
     Arguments.push_back(MakeString("Arg"));
     Arguments.push_back(MakeString("Arg"));
     Arguments.push_back(MakeString("Arg"));
     std::ostringstream Stream;
-    ASTPrettyPrint(MakeFunctionCall("Fun", std::move(Arguments)), Stream);
+    ASTPrettyPrint(MakeFunctionCall("Fun", Arguments), Stream);
   }
 }
@@ -0,0 +1,198 @@
+#include "FrontEnd/AST/ASTReader.hpp"
+#include "FrontEnd/AST/ASTBinaryFormat.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTPrettyPrint.hpp"
+#include "FrontEnd/AST/ASTWriter.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+#include "DeclarationRecorder.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static const char *Program = "int f(int a, float b, string c, bool d) {\n"
+                             "  int i = 0;\n"
+                             "  for (;;) { break; }\n"
+                             "  for (int j = 0; j < 10; ++j) { continue; }\n"
+                             "  while (i < 100) { i++; --i; i += 2; }\n"
+                             "  do { i = i << 1; } while (i != 0);\n"
+                             "  if (d) { b = 1.25; } else { c = \"s\"; }\n"
+                             "  if (true && d || false) { f(a, b, c, d); }\n"
+                             "  return i * 2 + 2147483647;\n"
+                             "}\n"
+                             "\n"
+                             "void g() {\n"
+                             "  string s = \"s\";\n"
+                             "  s = t;\n"
+                             "  return;\n"
+                             "}\n";
+
+/// Tree and declaration indices of its variables.
+static std::string Dump(const ASTNode *AST) {
+  std::ostringstream Stream;
+  ASTPrettyPrint(AST, Stream);
+  DeclarationRecorder Recorder;
+  Recorder.Traverse(AST);
+  for (const std::string &Record : Recorder.Records)
+    Stream << Record << '\n';
+  return Stream.str();
+}
+
+/// Parse input and write it to AST file.
+static std::string Serialize(std::string_view Input, std::string *Expected,
+                             bool ErrorRecovery = false) {
+  SourceBuffer Buffer("<test>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  ASTContext Context;
+  Parser Parse(&Context, &Buffer, &S, Tokens.data(),
+               Tokens.data() + Tokens.size());
+  if (ErrorRecovery)
+    Parse.EnableErrorRecovery();
+  ASTCompoundStmt *AST = Parse.Parse();
+  *Expected = Dump(AST);
+  std::ostringstream Stream;
+  ASTWrite(AST, Stream);
+  return Stream.str();
+}
+
+static std::string WriteTemporaryFile(std::string_view Content) {
+  char Path[] = "/tmp/weak_compiler_ast_XXXXXX";
+  int Descriptor = mkstemp(Path);
+  close(Descriptor);
+  std::ofstream(Path, std::ios::binary) << Content;
+  return Path;
+}
+
+int main() {
+  SECTION(RoundTrip) {
+    std::string Expected;
+    std::string Data = Serialize(Program, &Expected);
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    TEST_CASE(Reader.OpenBuffer(Data));
+    TEST_CASE(Reader.GetFunctionCount() == 2U);
+    TEST_CASE(Dump(Reader.ReadAll()) == Expected);
+  }
+  SECTION(ErrorNodes) {
+    std::string Expected;
+    std::string Data = Serialize("int f() { 1 +; return 1; }\n"
+                                 "+\n"
+                                 "void g() {}\n",
+                                 &Expected, /*ErrorRecovery=*/true);
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    TEST_CASE(Reader.OpenBuffer(Data));
+    TEST_CASE(Dump(Reader.ReadAll()) == Expected);
+  }
+  SECTION(LazyFunctions) {
+    std::string Expected;
+    std::string Data = Serialize(Program, &Expected);
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    TEST_CASE(Reader.OpenBuffer(Data));
+    std::size_t HeaderBytes = Context.TotalAllocated();
+    ASTNode *G = Reader.GetFunction(1U);
+    std::size_t GBytes = Context.TotalAllocated();
+    TEST_CASE(GBytes > HeaderBytes);
+    TEST_CASE(Reader.GetFunction(1U) == G);
+    TEST_CASE(Context.TotalAllocated() == GBytes);
+    ASTCompoundStmt *AST = Reader.ReadAll();
+    TEST_CASE(AST->GetStmts()[1] == G);
+    TEST_CASE(Dump(AST) == Expected);
+  }
+  SECTION(MappedFile) {
+    std::string Expected;
+    std::string Path = WriteTemporaryFile(Serialize(Program, &Expected));
+    ASTContext Context;
+    ASTCompoundStmt *AST = nullptr;
+    {
+      ASTReader Reader(&Context);
+      TEST_CASE(Reader.OpenFile(Path));
+      AST = Reader.ReadAll();
+    }
+    /// Tree outlives the mapping.
+    TEST_CASE(Dump(AST) == Expected);
+    std::remove(Path.c_str());
+  }
+  SECTION(EmptyTranslationUnit) {
+    ASTContext WriteContext;
+    std::ostringstream Stream;
+    ASTWrite(WriteContext.Make<ASTCompoundStmt>(ASTNodeList()), Stream);
+    ASTContext Context;
+    ASTReader Reader(&Context);
+    TEST_CASE(Reader.OpenBuffer(Stream.str()));
+    TEST_CASE(Reader.GetFunctionCount() == 0U);
+    TEST_CASE(Reader.ReadAll()->GetStmts().empty());
+  }
+  SECTION(RejectedFiles) {
+    std::string Expected;
+    std::string Data = Serialize(Program, &Expected);
+    ASTContext Context;
+    {
+      ASTReader Reader(&Context);
+      TEST_CASE(!Reader.OpenFile("/nonexistent/file.ast"));
+    }
+    {
+      ASTReader Reader(&Context);
+      TEST_CASE(!Reader.OpenBuffer("int f() {}"));
+    }
+    {
+      std::string OtherVersion = Data;
+      OtherVersion[sizeof(astBinary::Magic)] += 1;
+      ASTReader Reader(&Context);
+      TEST_CASE(!Reader.OpenBuffer(OtherVersion));
+    }
+    for (std::size_t Size = 0U; Size < Data.size(); ++Size) {
+      ASTReader Reader(&Context);
+      TEST_CASE(!Reader.OpenBuffer(std::string_view(Data).substr(0U, Size)));
+    }
+  }
+  SECTION(CorruptedFunctions) {
+    std::string Expected;
+    std::string Data = Serialize(Program, &Expected);
+    {
+      /// Varint at the end of the last function is not terminated.
+      std::string Corrupted = Data;
+      Corrupted.back() = static_cast<char>(0x80);
+      ASTContext Context;
+      ASTReader Reader(&Context);
+      TEST_CASE(Reader.OpenBuffer(Corrupted));
+      TEST_CASE(Reader.GetFunction(0U) != nullptr);
+      TEST_CASE(Reader.GetFunction(1U) == nullptr);
+      TEST_CASE(Reader.ReadAll() == nullptr);
+    }
+    /// Any byte of any function can be broken. Header is checked on open,
+    /// and body is checked when function is built.
+    unsigned CorruptedCount = 0U;
+    for (std::size_t I = 0U; I < Data.size(); ++I) {
+      for (unsigned char Byte : {0x00U, 0x7FU, 0x80U, 0xFFU}) {
+        std::string Corrupted = Data;
+        Corrupted[I] = static_cast<char>(Byte);
+        ASTContext Context;
+        ASTReader Reader(&Context);
+        if (Reader.OpenBuffer(Corrupted) && !Reader.ReadAll())
+          ++CorruptedCount;
+      }
+    }
+    TEST_CASE(CorruptedCount > 0U);
+  }
+  SECTION(Varints) {
+    using namespace astBinary;
+    for (std::int64_t Value : {0L, 1L, -1L, 63L, -64L, 1L << 40, -(1L << 40)})
+      TEST_CASE(ZigZagDecode(ZigZagEncode(Value)) == Value);
+    TEST_CASE(ZigZagEncode(-1L) == 1U);
+    TEST_CASE(ZigZagEncode(1L) == 2U);
+    std::string Out;
+    WriteVarint(Out, 127U);
+    TEST_CASE(Out.size() == 1U);
+    WriteVarint(Out, 128U);
+    TEST_CASE(Out.size() == 3U);
+  }
+}
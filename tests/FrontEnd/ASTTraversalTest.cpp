@@ -0,0 +1,153 @@
+#include "FrontEnd/AST/ASTTraversal.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+#include <algorithm>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static ASTCompoundStmt *
+Parse(ASTContext *Context, std::string_view Input,
+      unsigned DepthLimit = Parser::DefaultDepthLimit) {
+  Storage S;
+  SourceBuffer Buffer("<test>", Input);
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  Parser Parse(Context, &Buffer, &S, Tokens.data(),
+               Tokens.data() + Tokens.size());
+  Parse.EnableDepthLimit(DepthLimit);
+  return Parse.Parse();
+}
+
+template <typename Range> static std::vector<ASTType> Types(Range &&R) {
+  std::vector<ASTType> Result;
+  for (const ASTNode *Node : R)
+    Result.push_back(Node->GetASTType());
+  return Result;
+}
+
+namespace {
+
+/// Remember all nodes, but do not enter function calls.
+class TypeRecorder : public RecursiveASTVisitor<TypeRecorder> {
+public:
+  using RecursiveASTVisitor::Visit;
+
+  void Traverse(const ASTNode *Node) {
+    if (Node)
+      Types.push_back(Node->GetASTType());
+    RecursiveASTVisitor::Traverse(Node);
+  }
+
+  void Visit(const ASTFunctionCall *) { ++Calls; }
+
+  std::vector<ASTType> Types;
+  unsigned Calls = 0U;
+};
+
+} // namespace
+
+int main() {
+  SECTION(Orders) {
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, "int f(int a) {\n"
+                                           "  for (;;) { a = a + 1; }\n"
+                                           "  return ++a;\n"
+                                           "}\n");
+    std::vector<ASTType> PreOrderTypes = {
+        ASTType::COMPOUND_STMT,   ASTType::FUNCTION_DECL,
+        ASTType::VAR_DECL,        ASTType::COMPOUND_STMT,
+        ASTType::FOR_STMT,        ASTType::COMPOUND_STMT,
+        ASTType::BINARY,          ASTType::SYMBOL,
+        ASTType::BINARY,          ASTType::SYMBOL,
+        ASTType::INTEGER_LITERAL, ASTType::RETURN_STMT,
+        ASTType::PREFIX_UNARY,    ASTType::SYMBOL,
+    };
+    TEST_CASE(Types(PreOrder(AST)) == PreOrderTypes);
+
+    std::vector<ASTType> PostOrderTypes = {
+        ASTType::VAR_DECL,      ASTType::SYMBOL,
+        ASTType::SYMBOL,        ASTType::INTEGER_LITERAL,
+        ASTType::BINARY,        ASTType::BINARY,
+        ASTType::COMPOUND_STMT, ASTType::FOR_STMT,
+        ASTType::SYMBOL,        ASTType::PREFIX_UNARY,
+        ASTType::RETURN_STMT,   ASTType::COMPOUND_STMT,
+        ASTType::FUNCTION_DECL, ASTType::COMPOUND_STMT,
+    };
+    TEST_CASE(Types(PostOrder(AST)) == PostOrderTypes);
+
+    TEST_CASE(PreOrder(nullptr).begin() == PreOrder(nullptr).end());
+  }
+  SECTION(Walker) {
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, "void f() {\n"
+                                           "  while (1) { g(a, b); }\n"
+                                           "}\n");
+    std::vector<ASTType> Entered;
+    unsigned Left = 0U;
+    for (ASTWalker Walker(AST); Walker.Next();) {
+      if (Walker.IsLeaving()) {
+        ++Left;
+        continue;
+      }
+      const ASTNode *Node = Walker.GetNode();
+      Entered.push_back(Node->GetASTType());
+      if (Node->GetASTType() == ASTType::WHILE_STMT) {
+        TEST_CASE(Walker.GetDepth() == 3U);
+        TEST_CASE(Walker.GetParent()->GetASTType() == ASTType::COMPOUND_STMT);
+      }
+      if (Node->GetASTType() == ASTType::FUNCTION_CALL)
+        Walker.SkipChildren();
+    }
+    std::vector<ASTType> Expected = {
+        ASTType::COMPOUND_STMT,   ASTType::FUNCTION_DECL,
+        ASTType::COMPOUND_STMT,   ASTType::WHILE_STMT,
+        ASTType::INTEGER_LITERAL, ASTType::COMPOUND_STMT,
+        ASTType::FUNCTION_CALL,
+    };
+    TEST_CASE(Entered == Expected);
+    TEST_CASE(Left == Entered.size());
+  }
+  SECTION(RecursiveVisitor) {
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, "int f(int a) {\n"
+                                           "  if (a) { g(a, 1); } else {}\n"
+                                           "  do { a--; } while (a > 0);\n"
+                                           "  return a;\n"
+                                           "}\n");
+    TypeRecorder Recorder;
+    Recorder.Traverse(AST);
+    TEST_CASE(Recorder.Calls == 1U);
+
+    /// Arguments of call are skipped.
+    std::vector<ASTType> Expected;
+    for (auto It = PreOrder(AST).begin(); It != PreOrder(AST).end(); ++It)
+      if (!It.GetParent() ||
+          It.GetParent()->GetASTType() != ASTType::FUNCTION_CALL)
+        Expected.push_back((*It)->GetASTType());
+    TEST_CASE(Recorder.Types == Expected);
+  }
+  SECTION(LongOperatorChain) {
+    /// Tree is as deep as chain is long. Parser counts each operator as
+    /// nesting level, so limit is raised to accept it.
+    constexpr unsigned Length = 100000U;
+    std::string Input = "int f(int a) { return a";
+    for (unsigned I = 1U; I < Length; ++I)
+      Input += " + a";
+    Input += "; }\n";
+
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, Input, 2U * Length);
+    unsigned Symbols = 0U;
+    unsigned MaxDepth = 0U;
+    for (auto It = PreOrder(AST).begin(); It != PreOrder(AST).end(); ++It) {
+      Symbols += (*It)->GetASTType() == ASTType::SYMBOL;
+      MaxDepth = std::max(MaxDepth, It.GetDepth());
+    }
+    TEST_CASE(Symbols == Length);
+    TEST_CASE(MaxDepth == Length + 3U);
+  }
+}
@@ -0,0 +1,68 @@
+#include "FrontEnd/Lex/CharClass.hpp"
+#include "TestHelpers.hpp"
+#include <cctype>
+#include <string>
+
+using namespace weak::frontEnd;
+
+/// Compare bulk function with scalar one from each start position, so
+/// that every alignment and tail length is covered.
+template <typename Fn1, typename Fn2>
+static bool SameAtEachOffset(const std::string &Input, Fn1 &&Bulk,
+                             Fn2 &&Scalar) {
+  const char *End = Input.data() + Input.size();
+  for (const char *Ptr = Input.data(); Ptr != End; ++Ptr)
+    if (Bulk(Ptr, End) != Scalar(Ptr, End))
+      return false;
+  return true;
+}
+
+int main() {
+  SECTION(ClassTable) {
+    for (int C = 0; C < 128; ++C) {
+      TEST_CASE(IsSpace(C) == !!std::isspace(C));
+      TEST_CASE(IsDigit(C) == !!std::isdigit(C));
+      TEST_CASE(IsLetter(C) == !!std::isalpha(C));
+      TEST_CASE(IsIdentifierBody(C) == (std::isalnum(C) || C == '_'));
+    }
+    for (int C = 128; C < 256; ++C)
+      TEST_CASE(CharClassTable[C] == CHAR_NONE);
+  }
+  SECTION(SkipWhitespace) {
+    std::string Input = "  \t\t\n\r\v\f                                     "
+                        "x                                         \n\n\xA0"
+                        "  ";
+    TEST_CASE(SameAtEachOffset(Input, scan::SkipWhitespace,
+                               scan::SkipWhitespaceScalar));
+  }
+  SECTION(SkipIdentifierBody) {
+    std::string Input = "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                        "0123456789@[`{/:_a\xC1\xE1 abcdefghijklmnopqrstu"
+                        "vwxyz0123456789_xyz";
+    TEST_CASE(SameAtEachOffset(Input, scan::SkipIdentifierBody,
+                               scan::SkipIdentifierBodyScalar));
+  }
+  SECTION(SkipStringLiteralBody) {
+    std::string Input = "plain text of string literal, followed by \\ and \""
+                        " and newline\n and more plain text to not fit in 32";
+    Input += '\0';
+    Input += "and text after null-terminator";
+    TEST_CASE(SameAtEachOffset(Input, scan::SkipStringLiteralBody,
+                               scan::SkipStringLiteralBodyScalar));
+  }
+  SECTION(CountNewlines) {
+    std::string Input;
+    for (unsigned It = 0U; It < 200U; ++It)
+      Input += std::string(It % 37, 'a') + '\n';
+    TEST_CASE(SameAtEachOffset(Input, scan::CountNewlines,
+                               scan::CountNewlinesScalar));
+    TEST_CASE(scan::CountNewlines(Input.data(), Input.data() + Input.size()) ==
+              200U);
+    TEST_CASE(SameAtEachOffset(Input, scan::FindNewline,
+                               [](const char *Ptr, const char *End) {
+                                 while (Ptr != End && *Ptr != '\n')
+                                   ++Ptr;
+                                 return Ptr;
+                               }));
+  }
+}
@@ -0,0 +1,38 @@
+#ifndef WEAK_COMPILER_TESTS_FRONTEND_DECLARATION_RECORDER_HPP
+#define WEAK_COMPILER_TESTS_FRONTEND_DECLARATION_RECORDER_HPP
+
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "FrontEnd/AST/ASTVarDecl.hpp"
+#include "FrontEnd/AST/RecursiveASTVisitor.hpp"
+#include <string>
+#include <vector>
+
+/// Record declarations and symbols with their declaration indices in
+/// pre-order.
+class DeclarationRecorder
+    : public weak::frontEnd::RecursiveASTVisitor<DeclarationRecorder> {
+public:
+  using RecursiveASTVisitor::Visit;
+
+  void Visit(const weak::frontEnd::ASTVarDecl *VarDecl) {
+    Record("decl " + std::string(VarDecl->GetSymbolName()),
+           VarDecl->GetDeclaration());
+    RecursiveASTVisitor::Visit(VarDecl);
+  }
+
+  void Visit(const weak::frontEnd::ASTSymbol *Symbol) {
+    Record(std::string(Symbol->GetName()), Symbol->GetDeclaration());
+  }
+
+  std::vector<std::string> Records;
+
+private:
+  void Record(std::string What, unsigned Declaration) {
+    if (Declaration == weak::frontEnd::ASTVarDecl::NoDeclaration)
+      Records.push_back(What + " ?");
+    else
+      Records.push_back(What + " " + std::to_string(Declaration));
+  }
+};
+
+#endif // WEAK_COMPILER_TESTS_FRONTEND_DECLARATION_RECORDER_HPP
@@ -0,0 +1,79 @@
+#include "FrontEnd/AST/FlatAST.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTFunctionDecl.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+int main() {
+  SECTION(PreOrder) {
+    std::string_view Input = "int f(int a) {\n"
+                             "  for (;;) { a = a + 1.5; }\n"
+                             "  return ++a;\n"
+                             "}\n";
+    Storage S;
+    SourceBuffer Buffer("<test>", Input);
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parser(&Context, &Buffer, &S, Tokens.data(),
+                                  Tokens.data() + Tokens.size())
+                               .Parse();
+    FlatAST Flat(AST);
+
+    std::vector<ASTType> Types;
+    for (FlatAST::NodeIndex I = 0U; I < Flat.Size(); ++I)
+      Types.push_back(Flat.GetType(I));
+    std::vector<ASTType> Expected = {
+        ASTType::COMPOUND_STMT,
+        ASTType::FUNCTION_DECL,
+        ASTType::VAR_DECL,
+        ASTType::BASE_NODE,
+        ASTType::COMPOUND_STMT,
+        ASTType::FOR_STMT,
+        ASTType::BASE_NODE,
+        ASTType::BASE_NODE,
+        ASTType::BASE_NODE,
+        ASTType::COMPOUND_STMT,
+        ASTType::BINARY,
+        ASTType::SYMBOL,
+        ASTType::BINARY,
+        ASTType::SYMBOL,
+        ASTType::FLOATING_POINT_LITERAL,
+        ASTType::RETURN_STMT,
+        ASTType::PREFIX_UNARY,
+        ASTType::SYMBOL,
+    };
+    TEST_CASE(Types == Expected);
+
+    /// Function: argument, then body.
+    TEST_CASE(Flat.GetNode(1U) == AST->GetStmts()[0]);
+    TEST_CASE(Flat.GetString(1U) == "f");
+    TEST_CASE(Flat.GetOperation(1U) == TokenType::INT);
+    TEST_CASE(Flat.GetChildrenCount(1U) == 2U);
+    TEST_CASE(Flat.GetChild(1U, 0U) == 2U);
+    TEST_CASE(Flat.GetChild(1U, 1U) == 4U);
+    TEST_CASE(Flat.GetNode(4U) ==
+              static_cast<ASTFunctionDecl *>(AST->GetStmts()[0])->GetBody());
+
+    /// Placeholders take positions of absent children.
+    TEST_CASE(Flat.GetNode(3U) == nullptr);
+    TEST_CASE(Flat.GetChildrenCount(5U) == 4U);
+    TEST_CASE(Flat.GetChild(5U, 3U) == 9U);
+    TEST_CASE(Flat.GetFirstChild(6U) == FlatAST::None);
+
+    TEST_CASE(Flat.GetLineNo(5U) == 2U);
+    TEST_CASE(Flat.GetColumnNo(5U) == 3U);
+    TEST_CASE(Flat.GetOperation(10U) == TokenType::ASSIGN);
+    TEST_CASE(Flat.GetString(11U) == "a");
+    TEST_CASE(Flat.GetDeclaration(2U) == 0U);
+    TEST_CASE(Flat.GetDeclaration(11U) == 0U);
+    TEST_CASE(Flat.GetFloat(14U) == 1.5);
+    TEST_CASE(Flat.GetOperation(16U) == TokenType::INC);
+    TEST_CASE(Flat.GetNextSibling(4U) == FlatAST::None);
+    TEST_CASE(Flat.GetNextSibling(5U) == 15U);
+  }
+}
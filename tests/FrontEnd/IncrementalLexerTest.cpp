@@ -0,0 +1,160 @@
+#include "FrontEnd/Lex/IncrementalLexer.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+/// Payloads depend on order, in which symbols and literals were added to
+/// storage, so tokens are compared by the values they refer to.
+static bool SameToken(const SourceBuffer *Buffer, const Storage *LS,
+                      const Token &L, const Storage *RS, const Token &R) {
+  if (L.Type != R.Type || L.Loc != R.Loc || L.Length != R.Length)
+    return false;
+  switch (L.Type) {
+  case TokenType::STRING_LITERAL:
+    return GetStringLiteral(Buffer, LS, L) == GetStringLiteral(Buffer, RS, R);
+  case TokenType::FLOATING_POINT_LITERAL:
+    return GetFloatingPointValue(LS, L) == GetFloatingPointValue(RS, R);
+  case TokenType::INTEGRAL_LITERAL:
+    return GetIntegralValue(L) == GetIntegralValue(R);
+  case TokenType::ERROR:
+    /// Diagnostics are compared separately, in the same order.
+    return L.Payload == R.Payload;
+  default:
+    return true;
+  }
+}
+
+static void RunIncrementalLexerTest(std::string_view Input,
+                                    const TextEdit &Edit) {
+  Storage S;
+  SourceBuffer OldBuffer("<test>", Input);
+  Lexer OldLex(&S, &OldBuffer);
+  OldLex.EnableErrorRecovery();
+  auto OldTokens = OldLex.Analyze();
+
+  std::string Edited = ApplyEdit(Input, Edit);
+  SourceBuffer Buffer("<test>", Edited);
+  IncrementalLexer Incremental(&S, &Buffer);
+  Incremental.EnableErrorRecovery(OldLex.GetDiagnostics());
+  auto Tokens = Incremental.Relex(OldTokens, Edit);
+
+  Storage ExpectedStorage;
+  Lexer Lex(&ExpectedStorage, &Buffer);
+  Lex.EnableErrorRecovery();
+  auto Expected = Lex.Analyze();
+
+  TEST_CASE(Tokens.size() == Expected.size());
+  for (std::size_t I = 0U; I < Tokens.size(); ++I)
+    TEST_CASE(SameToken(&Buffer, &S, Tokens[I], &ExpectedStorage, Expected[I]));
+
+  const auto &Diagnostics = Incremental.GetDiagnostics();
+  const auto &ExpectedDiagnostics = Lex.GetDiagnostics();
+  TEST_CASE(Diagnostics.size() == ExpectedDiagnostics.size());
+  for (std::size_t I = 0U; I < Diagnostics.size(); ++I) {
+    TEST_CASE(Diagnostics[I].Loc == ExpectedDiagnostics[I].Loc);
+    TEST_CASE(Diagnostics[I].Message == ExpectedDiagnostics[I].Message);
+  }
+}
+
+int main() {
+  std::string_view Input = "int main(int argc) {\n"
+                           "  string s = \"text \\\" literal\";\n"
+                           "  float f = 1.5;\n"
+                           "  while (argc < 10) { argc += 1; }\n"
+                           "  return argc;\n"
+                           "}\n";
+  SECTION(ApplyEdit) {
+    TEST_CASE(ApplyEdit("abcdef", {2U, 2U, "XYZ"}) == "abXYZef");
+    TEST_CASE(ApplyEdit("abc", {3U, 0U, "d"}) == "abcd");
+    TEST_CASE(ApplyEdit("abc", {0U, 3U, ""}).empty());
+  }
+  SECTION(EmptyEdit) {
+    RunIncrementalLexerTest(Input, {10U, 0U, ""});
+  }
+  SECTION(ExtendingSymbol) {
+    /// "argc" -> "argcs" inside parameter list.
+    RunIncrementalLexerTest(Input, {17U, 0U, "s"});
+  }
+  SECTION(JoiningOperators) {
+    /// "<" -> "<=", then "<" -> "<<=".
+    RunIncrementalLexerTest(Input, {85U, 0U, "="});
+    RunIncrementalLexerTest(Input, {85U, 0U, "<="});
+  }
+  SECTION(SplittingSymbol) {
+    RunIncrementalLexerTest(Input, {2U, 0U, " "});
+  }
+  SECTION(ChangingLiteral) {
+    /// "1.5" -> "12.75", and string literal contents.
+    RunIncrementalLexerTest(Input, {65U, 3U, "12.75"});
+    RunIncrementalLexerTest(Input, {35U, 4U, "other \\\\ text"});
+  }
+  SECTION(InsertingTokensAtBoundaries) {
+    RunIncrementalLexerTest(Input, {0U, 0U, "void f() {}\n"});
+    SourceLocation End = Input.size();
+    RunIncrementalLexerTest(Input, {End, 0U, "int x;"});
+  }
+  SECTION(RemovingLines) {
+    RunIncrementalLexerTest(Input, {21U, 49U, ""});
+    RunIncrementalLexerTest(Input, {0U, SourceLocation(Input.size()), ""});
+  }
+  SECTION(ReplacingBodyWithLiterals) {
+    RunIncrementalLexerTest(Input, {21U, 84U, "\"a b c\" \"d\" 1 2 3\n"});
+  }
+  SECTION(EachOffset) {
+    /// Without literals, which any of these insertions could make invalid.
+    std::string_view Plain = "int main(int argc) {\n"
+                             "  while (argc <= 10) { argc += 1; }\n"
+                             "  return argc;\n"
+                             "}\n";
+    for (SourceLocation Offset = 0U; Offset <= Plain.size(); ++Offset) {
+      RunIncrementalLexerTest(Plain, {Offset, 0U, " "});
+      RunIncrementalLexerTest(Plain, {Offset, 0U, "+="});
+      RunIncrementalLexerTest(Plain, {Offset, 0U, "("});
+      if (Offset != Plain.size())
+        RunIncrementalLexerTest(Plain, {Offset, 1U, ""});
+    }
+  }
+  SECTION(Errors) {
+    std::string_view Broken = "int main() {\n"
+                              "  int a = 1 $ 2;\n"
+                              "  string s = \"open\n"
+                              "  float f = 1.5.5 @@ 3;\n"
+                              "}\n";
+    /// Fix, break and shift errors before, between and after others.
+    RunIncrementalLexerTest(Broken, {25U, 1U, "+"});
+    RunIncrementalLexerTest(Broken, {13U, 0U, "#"});
+    RunIncrementalLexerTest(Broken, {48U, 0U, "\""});
+    RunIncrementalLexerTest(Broken, {67U, 2U, ""});
+    RunIncrementalLexerTest(Broken, {0U, 0U, "` "});
+    RunIncrementalLexerTest(Broken, {25U, 1U, "$$$ ~ `"});
+    for (SourceLocation Offset = 0U; Offset <= Broken.size(); ++Offset) {
+      RunIncrementalLexerTest(Broken, {Offset, 0U, "$"});
+      RunIncrementalLexerTest(Broken, {Offset, 0U, " "});
+      if (Offset != Broken.size())
+        RunIncrementalLexerTest(Broken, {Offset, 1U, ""});
+    }
+  }
+  SECTION(LiteralsReused) {
+    /// Literals of replaced tokens are given to new ones, so storage does
+    /// not grow while the same text is edited.
+    Storage S;
+    std::string Text = "string s = \"a\\n\"; float f = 1.5;\n";
+    SourceBuffer OldBuffer("<test>", Text);
+    auto Tokens = Lexer(&S, &OldBuffer).Analyze();
+    for (unsigned I = 0U; I < 100U; ++I) {
+      TextEdit Edit{12U, 1U, I % 2U ? "b" : "c"};
+      Text = ApplyEdit(Text, Edit);
+      SourceBuffer Buffer("<test>", Text);
+      Tokens = IncrementalLexer(&S, &Buffer).Relex(std::move(Tokens), Edit);
+      Edit = {30U, 1U, I % 2U ? "7" : "8"};
+      Text = ApplyEdit(Text, Edit);
+      SourceBuffer Edited("<test>", Text);
+      Tokens = IncrementalLexer(&S, &Edited).Relex(std::move(Tokens), Edit);
+    }
+    TEST_CASE(S.AddStringLiteral("x") <= 1U);
+    TEST_CASE(S.AddFloatingPointLiteral(0.0) <= 1U);
+  }
+}
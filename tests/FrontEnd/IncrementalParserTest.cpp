@@ -0,0 +1,223 @@
+#include "FrontEnd/Parse/IncrementalParser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTPrettyPrint.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+#include "DeclarationRecorder.hpp"
+#include <sstream>
+#include <utility>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+/// Versions of input, parsed one after another by the same parser.
+struct Version {
+  std::string Text;
+  SourceBuffer Buffer;
+  Storage S;
+  std::vector<Token> Tokens;
+
+  Version(std::string Input)
+      : Text(std::move(Input)), Buffer("<test>", Text), S(), Tokens() {
+    Tokens = Lexer(&S, &Buffer).Analyze();
+  }
+
+  const Token *begin() const { return Tokens.data(); }
+  const Token *end() const { return Tokens.data() + Tokens.size(); }
+};
+
+/// Tree and declaration indices of its variables.
+static std::string Dump(const ASTNode *AST) {
+  std::ostringstream Stream;
+  ASTPrettyPrint(AST, Stream);
+  DeclarationRecorder Recorder;
+  Recorder.Traverse(AST);
+  for (const std::string &Record : Recorder.Records)
+    Stream << Record << '\n';
+  return Stream.str();
+}
+
+/// Compare tree and diagnostics with ones of fresh parse. Parser must be
+/// in error recovery mode if ErrorRecovery is set.
+static ASTCompoundStmt *Reparse(IncrementalParser &Parse, const Version &V,
+                                bool ErrorRecovery = false) {
+  ASTCompoundStmt *AST = Parse.Reparse(&V.Buffer, &V.S, V.begin(), V.end());
+  ASTContext Context;
+  Parser Fresh(&Context, &V.Buffer, &V.S, V.begin(), V.end());
+  if (ErrorRecovery)
+    Fresh.EnableErrorRecovery();
+  TEST_CASE(Dump(AST) == Dump(Fresh.Parse()));
+
+  const auto &Diagnostics = Parse.GetDiagnostics();
+  const auto &ExpectedDiagnostics = Fresh.GetDiagnostics();
+  TEST_CASE(Diagnostics.size() == ExpectedDiagnostics.size());
+  for (std::size_t I = 0U; I < Diagnostics.size(); ++I) {
+    TEST_CASE(Diagnostics[I].Loc == ExpectedDiagnostics[I].Loc);
+    TEST_CASE(Diagnostics[I].Message == ExpectedDiagnostics[I].Message);
+  }
+  return AST;
+}
+
+int main() {
+  SECTION(NothingReusedFirstTime) {
+    Version V("int f() { return 1; }\n"
+              "int g() { return 2; }\n");
+    IncrementalParser Parse;
+    Reparse(Parse, V);
+    TEST_CASE(Parse.GetReusedCount() == 0U);
+  }
+  SECTION(EditedFunctionIsParsed) {
+    Version Old("int f() { return 1; }\n"
+                "int g() { return 2; }\n"
+                "int h() { return 3; }\n");
+    Version New("int f() { return 1; }\n"
+                "int g() { return 2 + 2; }\n"
+                "int h() { return 3; }\n");
+    IncrementalParser Parse;
+    ASTCompoundStmt *OldAST = Reparse(Parse, Old);
+    std::size_t OldHash = Parse.GetFunctionHash(1U);
+    ASTNode *F = OldAST->GetStmts()[0];
+    ASTNode *H = OldAST->GetStmts()[2];
+
+    ASTCompoundStmt *NewAST = Reparse(Parse, New);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+    TEST_CASE(NewAST->GetStmts()[0] == F);
+    TEST_CASE(NewAST->GetStmts()[2] == H);
+    TEST_CASE(Parse.GetFunctionHash(1U) != OldHash);
+  }
+  SECTION(LinesAreShifted) {
+    Version Old("int f() { return 1; }\n"
+                "int g() {\n"
+                "  int a = 1;\n"
+                "  while (a < 10) { a = a + 1; }\n"
+                "  return a;\n"
+                "}\n");
+    Version New("\n"
+                "\n"
+                "int f() { return 1; }\n"
+                "\n"
+                "int g() {\n"
+                "  int a = 1;\n"
+                "  while (a < 10) { a = a + 1; }\n"
+                "  return a;\n"
+                "}\n");
+    IncrementalParser Parse;
+    Reparse(Parse, Old);
+    std::size_t OldHash = Parse.GetFunctionHash(1U);
+    Reparse(Parse, New);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+    TEST_CASE(Parse.GetFunctionHash(1U) == OldHash);
+    /// Lines go back.
+    Reparse(Parse, Old);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+  }
+  SECTION(DeclarationsAreRenumbered) {
+    Version Old("int f(int a) { return a; }\n"
+                "int g(int a) { int b = a; return b; }\n"
+                "int h(int a) { return a; }\n");
+    Version New("int f(int a) { int b = a; int c = b; return c; }\n"
+                "int g(int a) { int b = a; return b; }\n"
+                "int h(int a) { return a; }\n");
+    IncrementalParser Parse;
+    Reparse(Parse, Old);
+    Reparse(Parse, New);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+    Reparse(Parse, Old);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+  }
+  SECTION(ColumnChangeIsReparse) {
+    Version Old("int f() { return 1; }\n");
+    Version New("  int f() { return 1; }\n");
+    IncrementalParser Parse;
+    Reparse(Parse, Old);
+    Reparse(Parse, New);
+    TEST_CASE(Parse.GetReusedCount() == 0U);
+  }
+  SECTION(SameFunctionTextTwice) {
+    Version Old("int f() { return 1; }\n");
+    Version New("int f() { return 1; }\n"
+                "int f() { return 1; }\n");
+    IncrementalParser Parse;
+    ASTCompoundStmt *OldAST = Reparse(Parse, Old);
+    ASTCompoundStmt *NewAST = Reparse(Parse, New);
+    /// One subtree cannot be in two places.
+    TEST_CASE(Parse.GetReusedCount() == 1U);
+    TEST_CASE(NewAST->GetStmts()[0] == OldAST->GetStmts()[0]);
+    TEST_CASE(NewAST->GetStmts()[1] != OldAST->GetStmts()[0]);
+    TEST_CASE(Parse.GetFunctionHash(0U) == Parse.GetFunctionHash(1U));
+  }
+  SECTION(SyntaxErrorIsFixed) {
+    Version Correct("int f() { return 1; }\n"
+                    "int g(int a) { return a + 1; }\n"
+                    "int h() { return 3; }\n");
+    Version Broken("int f() { return 1; }\n"
+                   "int g(int a) { return a + ; }\n"
+                   "int h() { return 3; }\n");
+    /// Broken function is reused and its error is moved.
+    Version Moved("int f() {\n"
+                  "  return 1;\n"
+                  "}\n"
+                  "int g(int a) { return a + ; }\n"
+                  "int h() { return 3; }\n");
+    IncrementalParser Parse;
+    Parse.EnableErrorRecovery();
+    Reparse(Parse, Correct, /*ErrorRecovery=*/true);
+    Reparse(Parse, Broken, /*ErrorRecovery=*/true);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+    TEST_CASE(Parse.GetDiagnostics().size() == 1U);
+    Reparse(Parse, Moved, /*ErrorRecovery=*/true);
+    TEST_CASE(Parse.GetReusedCount() == 2U);
+    TEST_CASE(Parse.GetDiagnostics().size() == 1U);
+    Reparse(Parse, Correct, /*ErrorRecovery=*/true);
+    TEST_CASE(Parse.GetReusedCount() == 1U);
+    TEST_CASE(Parse.GetDiagnostics().empty());
+  }
+  SECTION(GlobalEntitiesBeforeFunction) {
+    Version Correct("int f() { return 1; }\n"
+                    "int g() { return 2; }\n");
+    Version Broken("int f() { return 1; }\n"
+                   "int a = 1;\n"
+                   "int g() { return 2; }\n"
+                   "return 3;\n");
+    IncrementalParser Parse;
+    Parse.EnableErrorRecovery();
+    Reparse(Parse, Correct, /*ErrorRecovery=*/true);
+    Reparse(Parse, Broken, /*ErrorRecovery=*/true);
+    TEST_CASE(!Parse.GetDiagnostics().empty());
+    Reparse(Parse, Broken, /*ErrorRecovery=*/true);
+    TEST_CASE(Parse.GetReusedCount() == 3U);
+    Reparse(Parse, Correct, /*ErrorRecovery=*/true);
+    TEST_CASE(Parse.GetDiagnostics().empty());
+  }
+  SECTION(UnbalancedBrackets) {
+    Version Broken("int f() { return 1; }\n"
+                   "int g() { return 2;\n");
+    IncrementalParser Parse;
+    Parse.EnableErrorRecovery();
+    Reparse(Parse, Broken, /*ErrorRecovery=*/true);
+    TEST_CASE(!Parse.GetDiagnostics().empty());
+  }
+  SECTION(ManyEdits) {
+    /// Garbage is collected many times.
+    IncrementalParser Parse(/*MinGarbageSize=*/1024U);
+    unsigned TotalReused = 0U;
+    for (unsigned I = 0U; I < 300U; ++I) {
+      std::string Input;
+      for (unsigned J = 0U; J < 50U; ++J) {
+        std::string N = std::to_string(J);
+        std::string Value = std::to_string(J == I % 50U ? I : J);
+        Input += "int f" + N + "(int a) {\n"
+                 "  for (int i = 0; i < a; ++i) { a = a * " + Value + "; }\n"
+                 "  return a;\n"
+                 "}\n";
+      }
+      Version V(Input);
+      Reparse(Parse, V);
+      TotalReused += Parse.GetReusedCount();
+    }
+    TEST_CASE(TotalReused > 0U);
+    TEST_CASE(TotalReused < 299U * 49U);
+  }
+}
@@ -1,34 +1,55 @@
 #include "FrontEnd/Lex/Lexer.hpp"
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "TestHelpers.hpp"
+#include <cstring>
 
 using namespace weak::frontEnd;
 using namespace weak::middleEnd;
 
-static Lexer CreateLexer(Storage *S, std::string_view Input) {
-  Lexer Lex(S, Input.begin(), Input.end());
-  return Lex;
+/// Token text for comparison. Keywords and operators are defined by type
+/// only, and string literals are compared by their value.
+struct ExpectedToken {
+  std::string_view Data;
+  TokenType Type;
+};
+
+static ExpectedToken MakeToken(std::string_view Data, TokenType Type) {
+  return {Data, Type};
 }
 
-static Token MakeToken(std::string_view Data, TokenType Type) {
-  return {Data, Type, 0U, 0U};
+static std::string_view GetData(const SourceBuffer *Buffer, const Storage *S,
+                                const Token &T) {
+  switch (T.Type) {
+  case TokenType::INTEGRAL_LITERAL:
+  case TokenType::FLOATING_POINT_LITERAL:
+  case TokenType::SYMBOL:
+    return GetTokenText(Buffer, T);
+  case TokenType::STRING_LITERAL:
+    return GetStringLiteral(Buffer, S, T);
+  default:
+    return "";
+  }
 }
 
 static void RunLexerTest(std::string_view Input,
-                         const std::vector<Token> &ExpectedTokens) {
+                         const std::vector<ExpectedToken> &ExpectedTokens) {
   Storage S;
-  auto Tokens = CreateLexer(&S, Input).Analyze();
+  SourceBuffer Buffer("<test>", Input);
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
   if (Tokens.size() != ExpectedTokens.size()) {
     std::cerr << "Output size mismatch: got " << Tokens.size()
               << " but expected " << ExpectedTokens.size();
     exit(-1);
   }
   for (size_t I = 0; I < Tokens.size(); ++I) {
-    std::cout << "Token at line " << Tokens[I].LineNo << ", column "
-              << Tokens[I].ColumnNo << ": " << TokenToString(Tokens[I].Type)
+    std::cout << "Token at line " << Buffer.GetLineNo(Tokens[I].Loc)
+              << ", column " << Buffer.GetColumnNo(Tokens[I].Loc) << ": "
+              << TokenToString(Tokens[I].Type)
               << std::endl;
-    if (Tokens[I] != ExpectedTokens[I]) {
-      std::cerr << "got " << Tokens[I].Data << ", but expected "
+    std::string_view Data = GetData(&Buffer, &S, Tokens[I]);
+    if (Tokens[I].Type != ExpectedTokens[I].Type ||
+        Data != ExpectedTokens[I].Data) {
+      std::cerr << "got " << Data << ", but expected "
                 << ExpectedTokens[I].Data;
       exit(-1);
     }
@@ -37,63 +58,242 @@ static void RunLexerTest(std::string_view Input,
 
 int main() {
   SECTION(LexingIntegralConstant) {
-    std::vector<Token> Assertion = {
+    std::vector<ExpectedToken> Assertion = {
         MakeToken("1", TokenType::INTEGRAL_LITERAL),
         MakeToken("22", TokenType::INTEGRAL_LITERAL),
         MakeToken("333", TokenType::INTEGRAL_LITERAL)};
     RunLexerTest("1 22 333", Assertion);
   }
   SECTION(LexingFloatingPointConstant) {
-    std::vector<Token> Assertion = {
+    std::vector<ExpectedToken> Assertion = {
         MakeToken("1.1", TokenType::FLOATING_POINT_LITERAL),
         MakeToken("22.22", TokenType::FLOATING_POINT_LITERAL),
         MakeToken("333.333", TokenType::FLOATING_POINT_LITERAL)};
     RunLexerTest("1.1 22.22 333.333", Assertion);
   }
+  SECTION(DecodingIntegralConstant) {
+    Storage S;
+    SourceBuffer Buffer("<test>", "0 7 12345678 123456789 2147483647 "
+                                  "00000000000000000042 987654321");
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    TEST_CASE(Tokens.size() == 7);
+    TEST_CASE(GetIntegralValue(Tokens[0]) == 0);
+    TEST_CASE(GetIntegralValue(Tokens[1]) == 7);
+    TEST_CASE(GetIntegralValue(Tokens[2]) == 12345678);
+    TEST_CASE(GetIntegralValue(Tokens[3]) == 123456789);
+    TEST_CASE(GetIntegralValue(Tokens[4]) == 2147483647);
+    TEST_CASE(GetIntegralValue(Tokens[5]) == 42);
+    TEST_CASE(GetIntegralValue(Tokens[6]) == 987654321);
+  }
+  SECTION(DecodingFloatingPointConstant) {
+    Storage S;
+    SourceBuffer Buffer("<test>", "1.5 0.1 123456789.125 1.7976931348623157");
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    TEST_CASE(Tokens.size() == 4);
+    TEST_CASE(GetFloatingPointValue(&S, Tokens[0]) == 1.5);
+    TEST_CASE(GetFloatingPointValue(&S, Tokens[1]) == 0.1);
+    TEST_CASE(GetFloatingPointValue(&S, Tokens[2]) == 123456789.125);
+    TEST_CASE(GetFloatingPointValue(&S, Tokens[3]) == 1.7976931348623157);
+  }
   SECTION(LexingEmptyStringLiteral) {
-    std::vector<Token> Assertion = {MakeToken("", TokenType::STRING_LITERAL)};
+    std::vector<ExpectedToken> Assertion = {
+        MakeToken("", TokenType::STRING_LITERAL)};
     RunLexerTest("\"\"", Assertion);
   }
   SECTION(LexingStringLiteral) {
-    std::vector<Token> Assertion = {MakeToken("a", TokenType::STRING_LITERAL),
-                                    MakeToken("b", TokenType::STRING_LITERAL),
-                                    MakeToken("c", TokenType::STRING_LITERAL)};
+    std::vector<ExpectedToken> Assertion = {
+        MakeToken("a", TokenType::STRING_LITERAL),
+        MakeToken("b", TokenType::STRING_LITERAL),
+        MakeToken("c", TokenType::STRING_LITERAL)};
     RunLexerTest(R"("a" "b" "c")", Assertion);
   }
   SECTION(LexingStringLiteral) {
-    std::vector<Token> Assertion = {MakeToken("text \" with escaped character ",
-                                              TokenType::STRING_LITERAL)};
+    std::vector<ExpectedToken> Assertion = {MakeToken(
+        "text \" with escaped character ", TokenType::STRING_LITERAL)};
     RunLexerTest(R"("text \" with escaped character ")", Assertion);
   }
   SECTION(LexingEscapeSequenceInStringLiteral) {
-    std::vector<Token> Assertion = {
+    std::vector<ExpectedToken> Assertion = {
         MakeToken("\\escaped\\", TokenType::STRING_LITERAL)};
     RunLexerTest(R"("\\escaped\\")", Assertion);
   }
+  SECTION(LexingWithoutCopying) {
+    Storage S;
+    std::string_view Input = R"(symbol 123 "literal" "escaped\"literal")";
+    SourceBuffer Buffer("<test>", Input);
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    TEST_CASE(Tokens.size() == 4);
+    /// Plain tokens have nothing to store, their text is in input buffer.
+    TEST_CASE(GetTokenText(&Buffer, Tokens[0]) == "symbol");
+    TEST_CASE(GetTokenText(&Buffer, Tokens[1]) == "123");
+    TEST_CASE(Tokens[2].Payload == Token::NoPayload);
+    TEST_CASE(GetStringLiteral(&Buffer, &S, Tokens[2]).data() ==
+              Input.data() + 12);
+    /// Escaped literal cannot view input, since its value differs.
+    TEST_CASE(Tokens[3].Payload != Token::NoPayload);
+    TEST_CASE(GetStringLiteral(&Buffer, &S, Tokens[3]) == "escaped\"literal");
+    TEST_CASE(GetTokenText(&Buffer, Tokens[3]) == R"("escaped\"literal")");
+  }
+  SECTION(CopyingTokensAsBytes) {
+    Storage S;
+    SourceBuffer Buffer("<test>", "int a = 1.5; string b = \"\\\"\";");
+    auto Tokens = Lexer(&S, &Buffer).Analyze();
+    std::vector<Token> Copy(Tokens.size());
+    std::memcpy(Copy.data(), Tokens.data(), Tokens.size() * sizeof(Token));
+    TEST_CASE(Copy == Tokens);
+    TEST_CASE(GetFloatingPointValue(&S, Copy[3]) == 1.5);
+    TEST_CASE(GetStringLiteral(&Buffer, &S, Copy[8]) == "\"");
+  }
+  SECTION(RecoveringFromErrors) {
+    Storage S;
+    std::string_view Input = "int a = 1.2.3;\n"
+                             "a = 12abc @# 2;\n"
+                             "string s = \"unterminated\n"
+                             "a = 99999999999 + 1;";
+    SourceBuffer Buffer("<test>", Input);
+    Lexer Lex(&S, &Buffer);
+    Lex.EnableErrorRecovery();
+    auto Tokens = Lex.Analyze();
+    std::vector<TokenType> Types = {
+        TokenType::INT,       TokenType::SYMBOL,
+        TokenType::ASSIGN,    TokenType::ERROR,
+        TokenType::SEMICOLON, TokenType::SYMBOL,
+        TokenType::ASSIGN,    TokenType::ERROR,
+        TokenType::ERROR,     TokenType::INTEGRAL_LITERAL,
+        TokenType::SEMICOLON, TokenType::STRING,
+        TokenType::SYMBOL,    TokenType::ASSIGN,
+        TokenType::ERROR,     TokenType::SYMBOL,
+        TokenType::ASSIGN,    TokenType::ERROR,
+        TokenType::PLUS,      TokenType::INTEGRAL_LITERAL,
+        TokenType::SEMICOLON};
+    TEST_CASE(Tokens.size() == Types.size());
+    for (std::size_t I = 0U; I < Tokens.size(); ++I)
+      TEST_CASE(Tokens[I].Type == Types[I]);
+
+    /// Malformed input is covered by ERROR tokens, and each refers to its
+    /// diagnostic.
+    std::vector<std::size_t> Errors = {3U, 7U, 8U, 14U, 17U};
+    std::vector<std::string_view> Texts = {"1.2.3", "12abc", "@#",
+                                           "\"unterminated", "99999999999"};
+    std::vector<std::size_t> Locations = {
+        Input.find(".3"), Input.find("abc"), Input.find("@#"),
+        Input.find("\na = 9"), Input.find("99999999999")};
+    const auto &Diagnostics = Lex.GetDiagnostics();
+    TEST_CASE(Diagnostics.size() == Errors.size());
+    for (std::size_t I = 0U; I < Errors.size(); ++I) {
+      const Token &T = Tokens[Errors[I]];
+      TEST_CASE(GetTokenText(&Buffer, T) == Texts[I]);
+      TEST_CASE(T.Payload == I);
+      TEST_CASE(Diagnostics[I].Loc == Locations[I]);
+    }
+    TEST_CASE(Diagnostics[0].Message == "Extra \".\" in digit");
+    TEST_CASE(Diagnostics[1].Message == "Digit as last character expected");
+    TEST_CASE(Diagnostics[2].Message == "Unknown character sequence: @#");
+    TEST_CASE(Diagnostics[3].Message == "Closing \" expected");
+    TEST_CASE(Diagnostics[4].Message ==
+              "Integral literal is out of range: 99999999999");
+  }
   SECTION(LexingSymbols) {
-    std::vector<Token> Assertion = {MakeToken("a", TokenType::SYMBOL),
+    std::vector<ExpectedToken> Assertion = {MakeToken("a", TokenType::SYMBOL),
                                     MakeToken("b", TokenType::SYMBOL),
                                     MakeToken("c", TokenType::SYMBOL)};
     RunLexerTest("a b c", Assertion);
   }
   SECTION(LexingKeywords) {
-    std::vector<Token> Assertion = {MakeToken("", TokenType::BOOLEAN),
+    std::vector<ExpectedToken> Assertion = {MakeToken("", TokenType::BOOLEAN),
                                     MakeToken("", TokenType::CHAR),
                                     MakeToken("", TokenType::WHILE)};
     RunLexerTest("bool\nchar\nwhile", Assertion);
   }
+  SECTION(LexingAllKeywords) {
+    std::vector<ExpectedToken> Assertion = {
+        MakeToken("", TokenType::BOOLEAN),  MakeToken("", TokenType::BREAK),
+        MakeToken("", TokenType::CHAR),     MakeToken("", TokenType::CONTINUE),
+        MakeToken("", TokenType::DO),       MakeToken("", TokenType::ELSE),
+        MakeToken("", TokenType::FALSE),    MakeToken("", TokenType::FLOAT),
+        MakeToken("", TokenType::FOR),      MakeToken("", TokenType::IF),
+        MakeToken("", TokenType::INT),      MakeToken("", TokenType::RETURN),
+        MakeToken("", TokenType::STRING),   MakeToken("", TokenType::TRUE),
+        MakeToken("", TokenType::VOID),     MakeToken("", TokenType::WHILE)};
+    RunLexerTest("bool break char continue do else false float for if int "
+                 "return string true void while",
+                 Assertion);
+  }
+  SECTION(LexingKeywordLikeSymbols) {
+    std::vector<ExpectedToken> Assertion = {MakeToken("i", TokenType::SYMBOL),
+                                    MakeToken("fo", TokenType::SYMBOL),
+                                    MakeToken("whiles", TokenType::SYMBOL),
+                                    MakeToken("Void", TokenType::SYMBOL),
+                                    MakeToken("d", TokenType::SYMBOL),
+                                    MakeToken("int_", TokenType::SYMBOL)};
+    RunLexerTest("i fo whiles Void d int_", Assertion);
+  }
+  SECTION(LexingAllOperators) {
+    std::vector<ExpectedToken> Assertion = {
+        MakeToken("", TokenType::ASSIGN),
+        MakeToken("", TokenType::MUL_ASSIGN),
+        MakeToken("", TokenType::DIV_ASSIGN),
+        MakeToken("", TokenType::MOD_ASSIGN),
+        MakeToken("", TokenType::PLUS_ASSIGN),
+        MakeToken("", TokenType::MINUS_ASSIGN),
+        MakeToken("", TokenType::SHL_ASSIGN),
+        MakeToken("", TokenType::SHR_ASSIGN),
+        MakeToken("", TokenType::BIT_AND_ASSIGN),
+        MakeToken("", TokenType::BIT_OR_ASSIGN),
+        MakeToken("", TokenType::XOR_ASSIGN),
+        MakeToken("", TokenType::AND),
+        MakeToken("", TokenType::OR),
+        MakeToken("", TokenType::XOR),
+        MakeToken("", TokenType::BIT_AND),
+        MakeToken("", TokenType::BIT_OR),
+        MakeToken("", TokenType::EQ),
+        MakeToken("", TokenType::NEQ),
+        MakeToken("", TokenType::GT),
+        MakeToken("", TokenType::LT),
+        MakeToken("", TokenType::GE),
+        MakeToken("", TokenType::LE),
+        MakeToken("", TokenType::SHR),
+        MakeToken("", TokenType::SHL),
+        MakeToken("", TokenType::PLUS),
+        MakeToken("", TokenType::MINUS),
+        MakeToken("", TokenType::STAR),
+        MakeToken("", TokenType::SLASH),
+        MakeToken("", TokenType::MOD),
+        MakeToken("", TokenType::INC),
+        MakeToken("", TokenType::DEC),
+        MakeToken("", TokenType::COMMA),
+        MakeToken("", TokenType::SEMICOLON),
+        MakeToken("", TokenType::NOT),
+        MakeToken("", TokenType::OPEN_BOX_BRACKET),
+        MakeToken("", TokenType::CLOSE_BOX_BRACKET),
+        MakeToken("", TokenType::OPEN_CURLY_BRACKET),
+        MakeToken("", TokenType::CLOSE_CURLY_BRACKET),
+        MakeToken("", TokenType::OPEN_PAREN),
+        MakeToken("", TokenType::CLOSE_PAREN)};
+    RunLexerTest("= *= /= %= += -= <<= >>= &= |= ^= && || ^ & | == != > < >= "
+                 "<= >> << + - * / % ++ -- , ; ! [ ] { } ( )",
+                 Assertion);
+  }
+  SECTION(LexingLongestOperatorMatch) {
+    std::vector<ExpectedToken> Assertion = {
+        MakeToken("", TokenType::SHL_ASSIGN), MakeToken("", TokenType::SHL),
+        MakeToken("", TokenType::AND),        MakeToken("", TokenType::BIT_AND),
+        MakeToken("", TokenType::NEQ),        MakeToken("", TokenType::ASSIGN),
+        MakeToken("", TokenType::GT)};
+    RunLexerTest("<<=<<&&&!==>", Assertion);
+  }
   SECTION(LexingOperators) {
-    std::vector<Token> Assertion_1 = {MakeToken("", TokenType::PLUS),
+    std::vector<ExpectedToken> Assertion_1 = {MakeToken("", TokenType::PLUS),
                                       MakeToken("", TokenType::MINUS),
                                       MakeToken("", TokenType::SLASH)};
     RunLexerTest("+-/", Assertion_1);
-    std::vector<Token> Assertion_2 = {
+    std::vector<ExpectedToken> Assertion_2 = {
         MakeToken("", TokenType::INC), MakeToken("", TokenType::INC),
         MakeToken("", TokenType::INC), MakeToken("", TokenType::PLUS)};
     RunLexerTest("+++++++", Assertion_2);
   }
   SECTION(LexingCompoundInput) {
-    std::vector<Token> Assertion = {
+    std::vector<ExpectedToken> Assertion = {
         MakeToken("", TokenType::VOID),
         MakeToken("main", TokenType::SYMBOL),
         MakeToken("", TokenType::OPEN_PAREN),
@@ -147,6 +347,7 @@ int main() {
     for (size_t It = 0; It < 16; ++It)
       Body += std::string(Body);
     printf("Body size: %zu\n", Body.size());
-    CreateLexer(&S, Body).Analyze();
+    SourceBuffer Buffer("<test>", Body);
+    Lexer(&S, &Buffer).Analyze();
   }
 }
@@ -0,0 +1,97 @@
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Lex/ParallelLexer.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "TestHelpers.hpp"
+#include <atomic>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static void RunParallelLexerTest(const std::string &Input,
+                                 unsigned MinChunkSize) {
+  SourceBuffer Buffer("<test>", Input);
+
+  Storage SequentialStorage;
+  auto Expected = Lexer(&SequentialStorage, &Buffer).Analyze();
+
+  weak::ThreadPool Pool(4U);
+  Storage ParallelStorage;
+  auto Tokens =
+      ParallelLexer(&ParallelStorage, &Buffer, &Pool, MinChunkSize).Analyze();
+
+  TEST_CASE(Tokens == Expected);
+  TEST_CASE(ParallelStorage.TotalVariables() ==
+            SequentialStorage.TotalVariables());
+}
+
+int main() {
+  SECTION(ThreadPool) {
+    weak::ThreadPool Pool(3U);
+    std::atomic<unsigned> Counter{0U};
+    for (unsigned I = 0U; I < 100U; ++I)
+      Pool.Submit([&Counter] { ++Counter; });
+    Pool.Wait();
+    TEST_CASE(Counter == 100U);
+  }
+  SECTION(SingleChunk) {
+    RunParallelLexerTest("int a = 1;\nint b = 2;\n", 1024U);
+  }
+  SECTION(ManyChunks) {
+    std::string Input;
+    for (unsigned I = 0U; I < 500U; ++I) {
+      Input += "int var" + std::to_string(I % 37) + " = " +
+               std::to_string(I) + ";\n";
+      Input += "string s = \"line " + std::to_string(I) + "\";\n";
+      Input += "float f = 1.5; while (var1 <<= 2) { shared += 1; }\n";
+    }
+    RunParallelLexerTest(Input, 64U);
+  }
+  SECTION(EscapedLiterals) {
+    std::string Input;
+    for (unsigned I = 0U; I < 100U; ++I)
+      Input += "\"escaped \\\" literal " + std::to_string(I) + "\"\n";
+    RunParallelLexerTest(Input, 32U);
+
+    SourceBuffer Buffer("<test>", Input);
+    weak::ThreadPool Pool(4U);
+    Storage S;
+    auto Tokens = ParallelLexer(&S, &Buffer, &Pool, 32U).Analyze();
+    TEST_CASE(GetStringLiteral(&Buffer, &S, Tokens[99]) ==
+              "escaped \" literal 99");
+  }
+  SECTION(Diagnostics) {
+    std::string Input;
+    for (unsigned I = 0U; I < 200U; ++I)
+      Input += "int a" + std::to_string(I) + " = " + std::to_string(I) +
+               (I % 7 == 0 ? "abc @;\n" : ";\n");
+    SourceBuffer Buffer("<test>", Input);
+
+    Storage SequentialStorage;
+    Lexer Lex(&SequentialStorage, &Buffer);
+    Lex.EnableErrorRecovery();
+    auto Expected = Lex.Analyze();
+
+    weak::ThreadPool Pool(4U);
+    Storage ParallelStorage;
+    ParallelLexer Parallel(&ParallelStorage, &Buffer, &Pool, 64U);
+    Parallel.EnableErrorRecovery();
+    auto Tokens = Parallel.Analyze();
+
+    TEST_CASE(Tokens == Expected);
+    const auto &Diagnostics = Parallel.GetDiagnostics();
+    TEST_CASE(Diagnostics.size() == Lex.GetDiagnostics().size());
+    TEST_CASE(Diagnostics.size() == 2U * 29U);
+    for (std::size_t I = 0U; I < Diagnostics.size(); ++I) {
+      TEST_CASE(Diagnostics[I].Loc == Lex.GetDiagnostics()[I].Loc);
+      TEST_CASE(Diagnostics[I].Message == Lex.GetDiagnostics()[I].Message);
+    }
+  }
+  SECTION(NoTrailingNewline) {
+    std::string Input;
+    for (unsigned I = 0U; I < 100U; ++I)
+      Input += "a b c d e f g\n";
+    Input += "last";
+    RunParallelLexerTest(Input, 16U);
+  }
+}
@@ -0,0 +1,98 @@
+#include "FrontEnd/Parse/ParallelParser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTPrettyPrint.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "TestHelpers.hpp"
+#include "DeclarationRecorder.hpp"
+#include <sstream>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static void RunParallelParserTest(const std::string &Input,
+                                  std::size_t MinChunkSize,
+                                  bool ErrorRecovery = false) {
+  SourceBuffer Buffer("<test>", Input);
+  Storage S;
+  auto Tokens = Lexer(&S, &Buffer).Analyze();
+  const Token *Begin = Tokens.data();
+  const Token *End = Tokens.data() + Tokens.size();
+
+  ASTContext SequentialContext;
+  Parser Sequential(&SequentialContext, &Buffer, &S, Begin, End);
+  if (ErrorRecovery)
+    Sequential.EnableErrorRecovery();
+  std::ostringstream Expected;
+  DeclarationRecorder ExpectedDeclarations;
+  ASTNode *SequentialAST = Sequential.Parse();
+  ASTPrettyPrint(SequentialAST, Expected);
+  ExpectedDeclarations.Traverse(SequentialAST);
+
+  weak::ThreadPool Pool(4U);
+  ASTContext ParallelContext;
+  ParallelParser Parallel(&ParallelContext, &Buffer, &S, Begin, End, &Pool,
+                          MinChunkSize);
+  if (ErrorRecovery)
+    Parallel.EnableErrorRecovery();
+  std::ostringstream Output;
+  DeclarationRecorder Declarations;
+  ASTNode *ParallelAST = Parallel.Parse();
+  ASTPrettyPrint(ParallelAST, Output);
+  Declarations.Traverse(ParallelAST);
+
+  TEST_CASE(Output.str() == Expected.str());
+  TEST_CASE(Declarations.Records == ExpectedDeclarations.Records);
+
+  const auto &Diagnostics = Parallel.GetDiagnostics();
+  const auto &ExpectedDiagnostics = Sequential.GetDiagnostics();
+  TEST_CASE(Diagnostics.size() == ExpectedDiagnostics.size());
+  for (std::size_t I = 0U; I < Diagnostics.size(); ++I) {
+    TEST_CASE(Diagnostics[I].Loc == ExpectedDiagnostics[I].Loc);
+    TEST_CASE(Diagnostics[I].Message == ExpectedDiagnostics[I].Message);
+  }
+}
+
+int main() {
+  SECTION(EmptyInput) {
+    RunParallelParserTest("", 1U);
+    RunParallelParserTest("  \n\t\n", 1U);
+  }
+  SECTION(SingleChunk) {
+    RunParallelParserTest("int f() { return 1; }\n"
+                          "void g(int a) { a = 2; }\n",
+                          1024U);
+  }
+  SECTION(ManyChunks) {
+    std::string Input;
+    for (unsigned I = 0U; I < 200U; ++I) {
+      std::string N = std::to_string(I);
+      Input += "int f" + N + "(int a, float b) {\n";
+      Input += "  while (a < " + N + ") {\n";
+      Input += "    if (a == 2) { break; } else { a += 1; }\n";
+      Input += "  }\n";
+      Input += "  string s = \"text " + N + "\";\n";
+      Input += "  return a * 2.5 + b;\n";
+      Input += "}\n";
+    }
+    RunParallelParserTest(Input, 16U);
+  }
+  SECTION(EmptyFunctions) {
+    std::string Input;
+    for (unsigned I = 0U; I < 50U; ++I)
+      Input += "void f() {}\n";
+    RunParallelParserTest(Input, 1U);
+  }
+  SECTION(ErrorsInManyChunks) {
+    std::string Input;
+    for (unsigned I = 0U; I < 15U; ++I) {
+      Input += "int f(int a) {\n";
+      Input += "  a = " + std::string(I % 3U == 0U ? "" : "1") + ";\n";
+      Input += "  return a;\n";
+      Input += "}\n";
+    }
+    RunParallelParserTest(Input, 8U, /*ErrorRecovery=*/true);
+  }
+}
@@ -1,28 +1,76 @@
 #include "FrontEnd/Parse/Parser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
 #include "FrontEnd/AST/ASTPrettyPrint.hpp"
+#include "FrontEnd/AST/FlatAST.hpp"
 #include "FrontEnd/Lex/Lexer.hpp"
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "../TestHelpers.hpp"
+#include "DeclarationRecorder.hpp"
 #include <sstream>
 #include <iostream>
 
 using namespace weak::frontEnd;
 using namespace weak::middleEnd;
 
-static Lexer CreateLexer(Storage *S, std::string_view Input) {
-  Lexer Lex(S, Input.begin(), Input.end());
-  return Lex;
-}
-
 static void TestAST(std::string_view String, std::string_view Expected) {
   Storage Storage;
-  auto Tokens = CreateLexer(&Storage, String).Analyze();
-  Parser Parse(&*Tokens.begin(), &*Tokens.end());
+  SourceBuffer Buffer("<test>", String);
+  auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+  ASTContext Context;
+  Parser Parse(&Context, &Buffer, &Storage, &*Tokens.begin(), &*Tokens.end());
+  ASTCompoundStmt *AST = Parse.Parse();
   std::ostringstream OutStream;
-  ASTPrettyPrint(Parse.Parse(), OutStream);
+  ASTPrettyPrint(AST, OutStream);
   std::string Output = OutStream.str();
   std::cout << Output << std::endl;
   TEST_CASE(OutStream.str() == Expected);
+
+  /// The same, printed from flat representation.
+  std::ostringstream FlatOutStream;
+  ASTPrettyPrint(FlatAST(AST), FlatOutStream);
+  TEST_CASE(FlatOutStream.str() == Expected);
+
+  /// The same, but with tokens lexed on demand.
+  weak::middleEnd::Storage StreamStorage;
+  Lexer Lex(&StreamStorage, &Buffer);
+  ASTContext StreamContext;
+  Parser StreamParse(&StreamContext, &Buffer, &Lex);
+  std::ostringstream StreamOutStream;
+  ASTPrettyPrint(StreamParse.Parse(), StreamOutStream);
+  TEST_CASE(StreamOutStream.str() == Expected);
+}
+
+/// Parse in error recovery mode and compare AST and all diagnostics.
+static void TestRecovery(std::string_view String, std::string_view Expected,
+                         const std::vector<std::string> &ExpectedErrors,
+                         unsigned ErrorLimit = Parser::DefaultErrorLimit,
+                         unsigned DepthLimit = 0U) {
+  Storage Storage;
+  SourceBuffer Buffer("<test>", String);
+  auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+  ASTContext Context;
+  Parser Parse(&Context, &Buffer, &Storage, &*Tokens.begin(), &*Tokens.end());
+  Parse.EnableErrorRecovery(ErrorLimit);
+  if (DepthLimit > 0U)
+    Parse.EnableDepthLimit(DepthLimit);
+  ASTCompoundStmt *AST = Parse.Parse();
+  std::ostringstream OutStream;
+  ASTPrettyPrint(AST, OutStream);
+  std::cout << OutStream.str() << std::endl;
+  TEST_CASE(OutStream.str() == Expected);
+
+  std::ostringstream FlatOutStream;
+  ASTPrettyPrint(FlatAST(AST), FlatOutStream);
+  TEST_CASE(FlatOutStream.str() == Expected);
+
+  std::vector<std::string> Errors;
+  for (const ParseDiagnostic &D : Parse.GetDiagnostics()) {
+    auto [LineNo, ColumnNo] = Buffer.GetLineAndColumn(D.Loc);
+    Errors.push_back(std::to_string(LineNo) + ":" + std::to_string(ColumnNo) +
+                     ": " + D.Message);
+    std::cout << Errors.back() << std::endl;
+  }
+  TEST_CASE(Errors == ExpectedErrors);
 }
 
 int main() {
@@ -142,6 +190,95 @@ int main() {
             "                  Symbol <line:2, col:54> f\n"
             "                  Symbol <line:2, col:59> g\n");
   }
+  SECTION(AllPrecedenceLevels) {
+    TestAST("void f() {\n"
+            "  a = b += c || d && e | f ^ g & h == i != j < k;\n"
+            "  a = k >= l << m >> n + o - p * q / r % s;\n"
+            "  a = b * c + d < e == f & g ^ h | i && j || k;\n"
+            "  a = (b - c) - d - ++e * f--;\n"
+            "}\n",
+            "CompoundStmt <line:0, col:0>\n"
+            "  FunctionDecl <line:1, col:1>\n"
+            "    FunctionRetType <line:1, col:1> <VOID>\n"
+            "    FunctionName <line:1, col:1> f\n"
+            "    FunctionArgs <line:1, col:1>\n"
+            "    FunctionBody <line:1, col:1>\n"
+            "      CompoundStmt <line:1, col:10>\n"
+            "        BinaryOperator <line:2, col:5> =\n"
+            "          Symbol <line:2, col:3> a\n"
+            "          BinaryOperator <line:2, col:9> +=\n"
+            "            Symbol <line:2, col:7> b\n"
+            "            BinaryOperator <line:2, col:14> ||\n"
+            "              Symbol <line:2, col:12> c\n"
+            "              BinaryOperator <line:2, col:19> &&\n"
+            "                Symbol <line:2, col:17> d\n"
+            "                BinaryOperator <line:2, col:24> |\n"
+            "                  Symbol <line:2, col:22> e\n"
+            "                  BinaryOperator <line:2, col:28> ^\n"
+            "                    Symbol <line:2, col:26> f\n"
+            "                    BinaryOperator <line:2, col:32> &\n"
+            "                      Symbol <line:2, col:30> g\n"
+            "                      BinaryOperator <line:2, col:36> ==\n"
+            "                        Symbol <line:2, col:34> h\n"
+            "                        BinaryOperator <line:2, col:41> !=\n"
+            "                          Symbol <line:2, col:39> i\n"
+            "                          BinaryOperator <line:2, col:46> <\n"
+            "                            Symbol <line:2, col:44> j\n"
+            "                            Symbol <line:2, col:48> k\n"
+            "        BinaryOperator <line:3, col:5> =\n"
+            "          Symbol <line:3, col:3> a\n"
+            "          BinaryOperator <line:3, col:9> >=\n"
+            "            Symbol <line:3, col:7> k\n"
+            "            BinaryOperator <line:3, col:14> >>\n"
+            "              Symbol <line:3, col:12> l\n"
+            "              BinaryOperator <line:3, col:19> <<\n"
+            "                Symbol <line:3, col:17> m\n"
+            "                BinaryOperator <line:3, col:24> +\n"
+            "                  Symbol <line:3, col:22> n\n"
+            "                  BinaryOperator <line:3, col:28> -\n"
+            "                    Symbol <line:3, col:26> o\n"
+            "                    BinaryOperator <line:3, col:32> *\n"
+            "                      Symbol <line:3, col:30> p\n"
+            "                      BinaryOperator <line:3, col:36> /\n"
+            "                        Symbol <line:3, col:34> q\n"
+            "                        BinaryOperator <line:3, col:40> %\n"
+            "                          Symbol <line:3, col:38> r\n"
+            "                          Symbol <line:3, col:42> s\n"
+            "        BinaryOperator <line:4, col:5> =\n"
+            "          Symbol <line:4, col:3> a\n"
+            "          BinaryOperator <line:4, col:43> ||\n"
+            "            BinaryOperator <line:4, col:38> &&\n"
+            "              BinaryOperator <line:4, col:34> |\n"
+            "                BinaryOperator <line:4, col:30> ^\n"
+            "                  BinaryOperator <line:4, col:26> &\n"
+            "                    BinaryOperator <line:4, col:21> ==\n"
+            "                      BinaryOperator <line:4, col:17> <\n"
+            "                        BinaryOperator <line:4, col:13> +\n"
+            "                          BinaryOperator <line:4, col:9> *\n"
+            "                            Symbol <line:4, col:7> b\n"
+            "                            Symbol <line:4, col:11> c\n"
+            "                          Symbol <line:4, col:15> d\n"
+            "                        Symbol <line:4, col:19> e\n"
+            "                      Symbol <line:4, col:24> f\n"
+            "                    Symbol <line:4, col:28> g\n"
+            "                  Symbol <line:4, col:32> h\n"
+            "                Symbol <line:4, col:36> i\n"
+            "              Symbol <line:4, col:41> j\n"
+            "            Symbol <line:4, col:46> k\n"
+            "        BinaryOperator <line:5, col:5> =\n"
+            "          Symbol <line:5, col:3> a\n"
+            "          BinaryOperator <line:5, col:15> -\n"
+            "            BinaryOperator <line:5, col:10> -\n"
+            "              Symbol <line:5, col:8> b\n"
+            "              Symbol <line:5, col:12> c\n"
+            "            BinaryOperator <line:5, col:19> -\n"
+            "              Symbol <line:5, col:17> d\n"
+            "              BinaryOperator <line:5, col:25> *\n"
+            "                Prefix UnaryOperator <line:5, col:21> ++\n"
+            "                  Symbol <line:5, col:23> e\n"
+            "                Postfix UnaryOperator <line:5, col:28> --\n"
+            "                  Symbol <line:5, col:27> f\n");
+  }
   SECTION(UnaryOperators) {
     TestAST("void f() {\n"
             "  int var1 = 0;\n"
@@ -361,4 +498,151 @@ int main() {
             "              Symbol <line:13, col:12> b\n"
             "              Symbol <line:13, col:16> a\n");
   }
-}
\ No newline at end of file
+  SECTION(ErrorRecovery) {
+    TestRecovery("int f(int a) {\n"
+                 "  int x = ;\n"
+                 "  a = 1;\n"
+                 "  while (a < 10 {\n"
+                 "    a += 1;\n"
+                 "  }\n"
+                 "  if (a == 1) { a = 2; } else { a = ; }\n"
+                 "  return a;\n"
+                 "}\n"
+                 "x = 1;\n"
+                 "int g(int a b, int c) { return 0; }\n"
+                 "void h() { f(1, 2; }\n"
+                 "int k() { return 1; }\n",
+                 "CompoundStmt <line:0, col:0>\n"
+                 "  FunctionDecl <line:1, col:1>\n"
+                 "    FunctionRetType <line:1, col:1> <INT>\n"
+                 "    FunctionName <line:1, col:1> f\n"
+                 "    FunctionArgs <line:1, col:1>\n"
+                 "      VarDeclStmt <line:1, col:7> <INT> a\n"
+                 "    FunctionBody <line:1, col:1>\n"
+                 "      CompoundStmt <line:1, col:14>\n"
+                 "        ErrorNode <line:2, col:3>\n"
+                 "        BinaryOperator <line:3, col:5> =\n"
+                 "          Symbol <line:3, col:3> a\n"
+                 "          IntegerLiteral <line:3, col:7> 1\n"
+                 "        ErrorNode <line:4, col:3>\n"
+                 "        IfStmt <line:7, col:3>\n"
+                 "          IfStmtCondition <line:7, col:9>\n"
+                 "            BinaryOperator <line:7, col:9> ==\n"
+                 "              Symbol <line:7, col:7> a\n"
+                 "              IntegerLiteral <line:7, col:12> 1\n"
+                 "          IfStmtThenBody <line:7, col:15>\n"
+                 "            CompoundStmt <line:7, col:15>\n"
+                 "              BinaryOperator <line:7, col:19> =\n"
+                 "                Symbol <line:7, col:17> a\n"
+                 "                IntegerLiteral <line:7, col:21> 2\n"
+                 "          IfStmtElseBody <line:7, col:31>\n"
+                 "            CompoundStmt <line:7, col:31>\n"
+                 "              ErrorNode <line:7, col:33>\n"
+                 "        ReturnStmt <line:8, col:3>\n"
+                 "          Symbol <line:8, col:10> a\n"
+                 "    ErrorNode <line:10, col:1>\n"
+                 "    ErrorNode <line:11, col:1>\n"
+                 "    FunctionDecl <line:12, col:1>\n"
+                 "      FunctionRetType <line:12, col:1> <VOID>\n"
+                 "      FunctionName <line:12, col:1> h\n"
+                 "      FunctionArgs <line:12, col:1>\n"
+                 "      FunctionBody <line:12, col:1>\n"
+                 "        CompoundStmt <line:12, col:10>\n"
+                 "          ErrorNode <line:12, col:12>\n"
+                 "      FunctionDecl <line:13, col:1>\n"
+                 "        FunctionRetType <line:13, col:1> <INT>\n"
+                 "        FunctionName <line:13, col:1> k\n"
+                 "        FunctionArgs <line:13, col:1>\n"
+                 "        FunctionBody <line:13, col:1>\n"
+                 "          CompoundStmt <line:13, col:9>\n"
+                 "            ReturnStmt <line:13, col:11>\n"
+                 "              IntegerLiteral <line:13, col:18> 1\n",
+                 {"2:11: Literal expected.",
+                  "4:17: Expected ()), got {",
+                  "7:37: Literal expected.",
+                  "10:1: Functions as global statements supported only.",
+                  "11:13: Data type expected.",
+                  "12:18: Expected (,), ()), got ;"});
+  }
+  SECTION(ErrorLimit) {
+    TestRecovery("void f() {\n"
+                 "  a = ;\n"
+                 "  b = ;\n"
+                 "  c = ;\n"
+                 "}\n",
+                 "CompoundStmt <line:0, col:0>\n"
+                 "  ErrorNode <line:1, col:1>\n",
+                 {"2:7: Literal expected.", "3:7: Literal expected."}, 2U);
+  }
+  SECTION(EndOfInputRecovery) {
+    TestRecovery("void f() {\n"
+                 "  a = 1;\n",
+                 "CompoundStmt <line:0, col:0>\n"
+                 "  ErrorNode <line:1, col:1>\n",
+                 {"3:1: End of buffer reached."});
+  }
+  SECTION(DepthLimit) {
+    TestRecovery("void f() {\n"
+                 "  if (a) { if (a) { a = 1; } }\n"
+                 "  a = (((1)));\n"
+                 "  b = 1 + 2 + 3 + 4;\n"
+                 "  c = d++++++;\n"
+                 "  e = 2;\n"
+                 "}\n",
+                 "CompoundStmt <line:0, col:0>\n"
+                 "  FunctionDecl <line:1, col:1>\n"
+                 "    FunctionRetType <line:1, col:1> <VOID>\n"
+                 "    FunctionName <line:1, col:1> f\n"
+                 "    FunctionArgs <line:1, col:1>\n"
+                 "    FunctionBody <line:1, col:1>\n"
+                 "      CompoundStmt <line:1, col:10>\n"
+                 "        IfStmt <line:2, col:3>\n"
+                 "          IfStmtCondition <line:2, col:7>\n"
+                 "            Symbol <line:2, col:7> a\n"
+                 "          IfStmtThenBody <line:2, col:10>\n"
+                 "            CompoundStmt <line:2, col:10>\n"
+                 "              IfStmt <line:2, col:12>\n"
+                 "                IfStmtCondition <line:2, col:16>\n"
+                 "                  Symbol <line:2, col:16> a\n"
+                 "                IfStmtThenBody <line:2, col:19>\n"
+                 "                  CompoundStmt <line:2, col:19>\n"
+                 "                    BinaryOperator <line:2, col:23> =\n"
+                 "                      Symbol <line:2, col:21> a\n"
+                 "                      IntegerLiteral <line:2, col:25> 1\n"
+                 "        ErrorNode <line:3, col:3>\n"
+                 "        ErrorNode <line:4, col:3>\n"
+                 "        ErrorNode <line:5, col:3>\n"
+                 "        BinaryOperator <line:6, col:5> =\n"
+                 "          Symbol <line:6, col:3> e\n"
+                 "          IntegerLiteral <line:6, col:7> 2\n",
+                 {"3:10: Nesting is too deep.", "4:17: Nesting is too deep.",
+                  "5:12: Nesting is too deep."},
+                 Parser::DefaultErrorLimit, /*DepthLimit=*/5U);
+  }
+  SECTION(Shadowing) {
+    Storage Storage;
+    SourceBuffer Buffer("<test>", "int f(int a) {\n"
+                                  "  int b = a;\n"
+                                  "  if (b) {\n"
+                                  "    int a = a + 1;\n"
+                                  "    b = a;\n"
+                                  "  }\n"
+                                  "  for (int a = 0; a < b; a++) { c = a; }\n"
+                                  "  return a;\n"
+                                  "}\n"
+                                  "int g(int b) { return b; }\n");
+    auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+    ASTContext Context;
+    Parser Parse(&Context, &Buffer, &Storage, &*Tokens.begin(),
+                 &*Tokens.end());
+    DeclarationRecorder Recorder;
+    Recorder.Traverse(Parse.Parse());
+    /// Initializer sees outer variable, declarations of block and 'for'
+    /// are forgotten after them, numbering goes through whole input.
+    std::vector<std::string> Expected = {
+        "decl a 0", "decl b 1", "a 0",      "b 1",      "decl a 2", "a 0",
+        "b 1",      "a 2",      "decl a 3", "a 3",      "b 1",      "a 3",
+        "c ?",      "a 3",      "a 0",      "decl b 4", "b 4"};
+    TEST_CASE(Recorder.Records == Expected);
+  }
+}
@@ -0,0 +1,65 @@
+#include "FrontEnd/Lex/SourceManager.hpp"
+#include "TestHelpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace weak::frontEnd;
+
+static std::string WriteTemporaryFile(std::string_view Content) {
+  char Path[] = "/tmp/weak_compiler_sm_XXXXXX";
+  int Descriptor = mkstemp(Path);
+  close(Descriptor);
+  std::ofstream(Path) << Content;
+  return Path;
+}
+
+int main() {
+  SECTION(LineAndColumn) {
+    SourceBuffer Buffer("<test>", "ab\ncd\n\nef");
+    TEST_CASE(Buffer.GetLineAndColumn(0) == std::make_pair(1U, 1U));
+    TEST_CASE(Buffer.GetLineAndColumn(1) == std::make_pair(1U, 2U));
+    TEST_CASE(Buffer.GetLineAndColumn(2) == std::make_pair(1U, 3U));
+    TEST_CASE(Buffer.GetLineAndColumn(3) == std::make_pair(2U, 1U));
+    TEST_CASE(Buffer.GetLineAndColumn(6) == std::make_pair(3U, 1U));
+    TEST_CASE(Buffer.GetLineAndColumn(8) == std::make_pair(4U, 2U));
+    TEST_CASE(Buffer.GetLineNo(4) == 2U);
+    TEST_CASE(Buffer.GetColumnNo(4) == 2U);
+  }
+  SECTION(InMemoryBuffer) {
+    SourceManager SM;
+    FileID First = SM.AddBuffer("first", "int a");
+    FileID Second = SM.AddBuffer("second", "int b");
+    TEST_CASE(First != Second);
+    TEST_CASE(SM.TotalBuffers() == 2U);
+    TEST_CASE(SM.GetBuffer(First)->GetText() == "int a");
+    TEST_CASE(SM.GetBuffer(Second)->GetName() == "second");
+    TEST_CASE(*SM.GetBuffer(Second)->GetBufferEnd() == '\0');
+  }
+  SECTION(MappedFile) {
+    std::string Path = WriteTemporaryFile("void f() {\n  return;\n}\n");
+    SourceManager SM;
+    const SourceBuffer *Buffer = SM.GetBuffer(SM.AddFile(Path));
+    TEST_CASE(Buffer->GetText() == "void f() {\n  return;\n}\n");
+    TEST_CASE(*Buffer->GetBufferEnd() == '\0');
+    TEST_CASE(Buffer->GetLineNo(13) == 2U);
+    std::remove(Path.c_str());
+  }
+  SECTION(PageSizedFile) {
+    std::string Content(sysconf(_SC_PAGESIZE), 'a');
+    std::string Path = WriteTemporaryFile(Content);
+    SourceManager SM;
+    const SourceBuffer *Buffer = SM.GetBuffer(SM.AddFile(Path));
+    TEST_CASE(Buffer->GetText() == Content);
+    TEST_CASE(*Buffer->GetBufferEnd() == '\0');
+    std::remove(Path.c_str());
+  }
+  SECTION(EmptyFile) {
+    std::string Path = WriteTemporaryFile("");
+    SourceManager SM;
+    const SourceBuffer *Buffer = SM.GetBuffer(SM.AddFile(Path));
+    TEST_CASE(Buffer->GetText().empty());
+    TEST_CASE(*Buffer->GetBufferEnd() == '\0');
+    std::remove(Path.c_str());
+  }
+}
@@ -0,0 +1,43 @@
+#include "FrontEnd/Lex/TokenSet.hpp"
+#include "TestHelpers.hpp"
+
+using namespace weak::frontEnd;
+
+static constexpr TokenSet Brackets = {TokenType::OPEN_PAREN,
+                                      TokenType::CLOSE_PAREN};
+
+static_assert(Brackets.Contains(TokenType::CLOSE_PAREN),
+              "Set should be usable at compile time");
+
+int main() {
+  SECTION(EmptySet) {
+    TokenSet Set;
+    TEST_CASE(Set.Empty());
+    TEST_CASE(!Set.Contains(TokenType::NONE));
+    TEST_CASE(!Set.Contains(TokenType::CLOSE_PAREN));
+  }
+  SECTION(SingleToken) {
+    TokenSet Set = TokenType::SEMICOLON;
+    TEST_CASE(!Set.Empty());
+    TEST_CASE(Set.Contains(TokenType::SEMICOLON));
+    TEST_CASE(!Set.Contains(TokenType::COMMA));
+  }
+  SECTION(TokensFromBothWords) {
+    /// First and last token types are stored in different words.
+    TokenSet Set = {TokenType::NONE, TokenType::CLOSE_PAREN};
+    for (unsigned I = 0U; I <= unsigned(TokenType::CLOSE_PAREN); ++I) {
+      auto T = static_cast<TokenType>(I);
+      TEST_CASE(Set.Contains(T) ==
+                (T == TokenType::NONE || T == TokenType::CLOSE_PAREN));
+    }
+  }
+  SECTION(Union) {
+    TokenSet Set = Brackets | TokenType::COMMA;
+    TEST_CASE(Set.Contains(TokenType::OPEN_PAREN));
+    TEST_CASE(Set.Contains(TokenType::CLOSE_PAREN));
+    TEST_CASE(Set.Contains(TokenType::COMMA));
+    TEST_CASE(!Set.Contains(TokenType::SEMICOLON));
+    TEST_CASE(Set != Brackets);
+    TEST_CASE((Set | Brackets) == Set);
+  }
+}
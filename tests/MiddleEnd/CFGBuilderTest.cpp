@@ -1,23 +1,26 @@
 #include "FrontEnd/Parse/Parser.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
 #include "FrontEnd/AST/ASTPrettyPrint.hpp"
 #include "FrontEnd/Lex/Lexer.hpp"
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "MiddleEnd/Analysis/CFGBuilder.hpp"
+#include "MiddleEnd/Analysis/SemanticAnalyzer.hpp"
+#include "FrontEnd/AST/FlatAST.hpp"
+#include "TestHelpers.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 using namespace weak::frontEnd;
 using namespace weak::middleEnd;
 
-static Lexer CreateLexer(Storage *S, std::string_view Input) {
-  Lexer Lex(S, Input.begin(), Input.end());
-  return Lex;
-}
-
 static void CreateCFG(std::string_view String) {
   Storage Storage;
-  auto Tokens = CreateLexer(&Storage, String).Analyze();
-  Parser Parse(&*Tokens.begin(), &*Tokens.end());
+  SourceBuffer Buffer("<test>", String);
+  auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+  ASTContext Context;
+  Parser Parse(&Context, &Buffer, &Storage, &*Tokens.begin(), &*Tokens.end());
   auto AST = Parse.Parse();
 
   CFGBuilder Builder(AST->GetStmts());
@@ -28,7 +31,97 @@ static void CreateCFG(std::string_view String) {
   std::remove("CFG.gv");
 }
 
+static std::string BuildCFG(std::string_view String, bool UseFlatAST) {
+  Storage Storage;
+  SourceBuffer Buffer("<test>", String);
+  auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+  ASTContext Context;
+  Parser Parse(&Context, &Buffer, &Storage, &*Tokens.begin(), &*Tokens.end());
+  auto AST = Parse.Parse();
+  SemanticAnalyzer(AST).Analyze();
+
+  FlatAST Flat(AST);
+  CFGBuilder Builder = UseFlatAST ? CFGBuilder(&Flat)
+                                  : CFGBuilder(AST->GetStmts());
+  Builder.Build();
+  return CFGToDot(&Builder.GetCFG());
+}
+
+/// Phi operands and blocks are ordered by addresses, so sort them.
+static std::vector<std::string> Normalize(const std::string &Dot) {
+  std::vector<std::string> Lines;
+  std::istringstream Stream(Dot);
+  for (std::string Line; std::getline(Stream, Line);) {
+    if (auto Open = Line.find("φ("); Open != std::string::npos) {
+      Open += std::string_view("φ(").size();
+      std::vector<std::string> Operands;
+      std::istringstream OperandStream(
+          Line.substr(Open, Line.rfind(')') - Open));
+      for (std::string Operand; std::getline(OperandStream, Operand, ',');)
+        Operands.push_back(Operand.substr(Operand.find_first_not_of(' ')));
+      std::sort(Operands.begin(), Operands.end());
+      Line.erase(Open);
+      for (const auto &Operand : Operands)
+        Line += Operand + ", ";
+    }
+    Lines.push_back(Line);
+  }
+  std::sort(Lines.begin(), Lines.end());
+  return Lines;
+}
+
+/// Graph built from flat AST should be the same.
+static void CompareWithFlatAST(std::string_view String) {
+  TEST_CASE(Normalize(BuildCFG(String, /*UseFlatAST=*/false)) ==
+            Normalize(BuildCFG(String, /*UseFlatAST=*/true)));
+}
+
 int main() {
+  SECTION(FlatAST) {
+    CompareWithFlatAST("void f() {"
+                       "  int a = 1;"
+                       "  int b = 2;"
+                       "  if (1 + 2) {"
+                       "    int c = a + b + 2;"
+                       "    a = c;"
+                       "  } else {"
+                       "    b = 888;"
+                       "  }"
+                       "  a = 7;"
+                       "}");
+    CompareWithFlatAST("void f() {"
+                       "  int a = 1;"
+                       "  int b = 2;"
+                       "  for (int i = 0; i < 10; i = i + 1) {"
+                       "    do {"
+                       "      a = 7;"
+                       "      while (9 + 10) {"
+                       "        b = 12;"
+                       "      }"
+                       "    } while (5 + 6);"
+                       "    a = a + i;"
+                       "  }"
+                       "  a = b;"
+                       "}");
+  }
+  SECTION(Shadowing) {
+    /// Inner 'a' is numbered on its own, so the second definition of outer
+    /// 'a' is the number 1 and condition refers to the first one.
+    std::string Input = "void f() {"
+                        "  int a = 1;"
+                        "  if (a < 2) {"
+                        "    int a = 2;"
+                        "    a = 3;"
+                        "  }"
+                        "  a = 4;"
+                        "}";
+    std::string Dot = BuildCFG(Input, /*UseFlatAST=*/false);
+    TEST_CASE(Dot.find("Branch(a#0<2)") != std::string::npos);
+    TEST_CASE(Dot.find("a#1 = 3") != std::string::npos);
+    TEST_CASE(Dot.find("a#1 = 4") != std::string::npos);
+    CompareWithFlatAST(Input);
+  }
+
 //  CreateCFG("void f() {"
 //            "  int a = 1;"
 //            "  int b = 2;"
@@ -0,0 +1,116 @@
+#include "MiddleEnd/Analysis/SemanticAnalyzer.hpp"
+#include "FrontEnd/AST/ASTContext.hpp"
+#include "FrontEnd/AST/ASTTraversal.hpp"
+#include "FrontEnd/Lex/Lexer.hpp"
+#include "FrontEnd/Parse/Parser.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "TestHelpers.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+static ASTCompoundStmt *Parse(ASTContext *Context, std::string_view String) {
+  Storage Storage;
+  SourceBuffer Buffer("<test>", String);
+  auto Tokens = Lexer(&Storage, &Buffer).Analyze();
+  return Parser(Context, &Buffer, &Storage, &*Tokens.begin(), &*Tokens.end())
+      .Parse();
+}
+
+/// Analyze in error recovery mode and compare all diagnostics.
+static void TestErrors(std::string_view String,
+                       const std::vector<std::string> &ExpectedErrors) {
+  ASTContext Context;
+  SemanticAnalyzer Analyzer(Parse(&Context, String));
+  Analyzer.EnableErrorRecovery();
+  Analyzer.Analyze();
+
+  std::vector<std::string> Errors;
+  for (const SemanticDiagnostic &D : Analyzer.GetDiagnostics()) {
+    Errors.push_back(std::to_string(D.LineNo) + ":" +
+                     std::to_string(D.ColumnNo) + ": " + D.Message);
+    std::cout << Errors.back() << std::endl;
+  }
+  TEST_CASE(Errors == ExpectedErrors);
+}
+
+int main() {
+  SECTION(Types) {
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, "int f(int a, float b) {\n"
+                                           "  float c = a + b;\n"
+                                           "  bool d = a < 2;\n"
+                                           "  if (d) {\n"
+                                           "    string a = \"s\";\n"
+                                           "    d = a == \"t\";\n"
+                                           "  }\n"
+                                           "  return a;\n"
+                                           "}\n");
+    SemanticAnalyzer Analyzer(AST);
+    Analyzer.EnableErrorRecovery();
+    Analyzer.Analyze();
+    TEST_CASE(Analyzer.GetDiagnostics().empty());
+
+    /// Statements have no type. Inner variable shadows parameter.
+    std::vector<TokenType> Types;
+    for (const ASTNode *Node : PreOrder(AST))
+      if (Node->GetExprType() != TokenType::NONE)
+        Types.push_back(Node->GetExprType());
+    std::vector<TokenType> Expected = {
+        TokenType::FLOAT,   TokenType::INT,     TokenType::FLOAT,
+        TokenType::BOOLEAN, TokenType::INT,     TokenType::INT,
+        TokenType::BOOLEAN, TokenType::STRING,  TokenType::BOOLEAN,
+        TokenType::BOOLEAN, TokenType::BOOLEAN, TokenType::STRING,
+        TokenType::STRING,  TokenType::INT};
+    TEST_CASE(Types == Expected);
+  }
+  SECTION(SingleFunction) {
+    /// Declarations of the second function do not start from zero.
+    ASTContext Context;
+    ASTCompoundStmt *AST = Parse(&Context, "int f(int a) { return a; }\n"
+                                           "int g(int a) {\n"
+                                           "  string s = \"s\";\n"
+                                           "  return a;\n"
+                                           "}\n");
+    ASTNode *G = AST->GetStmts()[1];
+    SemanticAnalyzer Analyzer(G);
+    Analyzer.EnableErrorRecovery();
+    Analyzer.Analyze();
+    TEST_CASE(Analyzer.GetDiagnostics().empty());
+
+    std::vector<TokenType> Types;
+    for (const ASTNode *Node : PreOrder(G))
+      if (Node->GetExprType() != TokenType::NONE)
+        Types.push_back(Node->GetExprType());
+    std::vector<TokenType> Expected = {TokenType::STRING, TokenType::INT};
+    TEST_CASE(Types == Expected);
+  }
+  SECTION(Errors) {
+    TestErrors("void g(int x) {}\n"
+               "int h() {\n"
+               "  string s = 1;\n"
+               "  s = s + 1;\n"
+               "  s = 1++;\n"
+               "  y = 1;\n"
+               "  g(s);\n"
+               "  g();\n"
+               "  k();\n"
+               "  while (s) {}\n"
+               "  return;\n"
+               "}\n"
+               "void w() { return 1; }\n",
+               {"3:14: Cannot convert <INT> to <STRING>",
+                "4:9: Invalid operands of +: <STRING> and <INT>",
+                "5:7: Expression is not assignable",
+                "6:3: Variable not declared: y",
+                "7:5: Cannot convert <STRING> to <INT>",
+                "8:3: Expected 1 arguments, got 0",
+                "9:3: Function not declared: k",
+                "10:10: Condition must be scalar, got <STRING>",
+                "11:3: Return value expected",
+                "13:19: Void function cannot return value"});
+  }
+}
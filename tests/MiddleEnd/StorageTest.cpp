@@ -1,6 +1,8 @@
 #include "MiddleEnd/Symbols/Storage.hpp"
 #include "TestHelpers.hpp"
 #include <cassert>
+#include <string>
+#include <vector>
 
 using namespace weak::frontEnd;
 using namespace weak::middleEnd;
@@ -70,4 +72,84 @@ int main() {
 
     Pool.ScopeEnd();
   }
-}
\ No newline at end of file
+  SECTION(ScopeUndo) {
+    Storage Pool;
+    unsigned Outer = Pool.AddSymbol("outer");
+
+    constexpr unsigned Depth = 100U;
+    for (unsigned I = 0U; I < Depth; ++I) {
+      Pool.ScopeBegin();
+      Pool.AddSymbol("v" + std::to_string(I));
+      TEST_CASE(Pool.AddSymbol("outer") == Outer);
+    }
+    TEST_CASE(Pool.TotalVariables() == Depth + 1U);
+
+    Pool.ScopeEnd();
+    TEST_CASE(Pool.TotalVariables() == Depth);
+    /// Attribute of destroyed variable is not reused.
+    unsigned Readded = Pool.AddSymbol("v99");
+    TEST_CASE(Readded == Depth + 1U);
+    TEST_CASE(Pool.GetSymbolName(Readded) == Pool.GetSymbolName(Depth));
+
+    for (unsigned I = 0U; I < Depth - 1U; ++I)
+      Pool.ScopeEnd();
+    TEST_CASE(Pool.TotalVariables() == 1U);
+  }
+  SECTION(Merge) {
+    Storage Pool;
+    Pool.AddSymbol("a");
+    Storage Other;
+    Other.AddSymbol("b");
+    Other.AddSymbol("a");
+    std::vector<unsigned> Attributes = Pool.MergeSymbols(Other);
+    TEST_CASE(Attributes == std::vector<unsigned>({1U, 0U}));
+    TEST_CASE(Pool.TotalVariables() == 2U);
+  }
+  SECTION(MergeClosedScope) {
+    Storage Pool;
+    Pool.AddSymbol("a");
+    Storage Other;
+    Other.ScopeBegin();
+    Other.AddSymbol("c");
+    Other.ScopeEnd();
+    Other.AddSymbol("b");
+    std::vector<unsigned> Attributes = Pool.MergeSymbols(Other);
+    TEST_CASE(Attributes.size() == 2U);
+    TEST_CASE(Pool.GetSymbolName(Attributes[0]) == Other.GetSymbolName(0U));
+    TEST_CASE(Pool.GetSymbolName(Attributes[1]) == Other.GetSymbolName(1U));
+    TEST_CASE(Attributes[0] != 0U);
+  }
+  SECTION(ManyNames) {
+    /// Names are looked up through growth of table and scope ends.
+    Storage Pool;
+    constexpr unsigned Count = 10000U;
+    std::vector<unsigned> Outer;
+    for (unsigned I = 0U; I < Count; ++I)
+      Outer.push_back(Pool.AddSymbol("n" + std::to_string(I)));
+    Pool.ScopeBegin();
+    for (unsigned I = 0U; I < Count; I += 2U)
+      Pool.AddDeclaration(Pool.GetSymbolName(Outer[I]));
+    for (unsigned I = 0U; I < Count; ++I) {
+      unsigned Found = Pool.Lookup(Pool.GetSymbolName(Outer[I]));
+      TEST_CASE((Found == Outer[I]) == (I % 2U == 1U));
+    }
+    Pool.ScopeEnd();
+    for (unsigned I = 0U; I < Count; ++I)
+      TEST_CASE(Pool.Lookup(Pool.GetSymbolName(Outer[I])) == Outer[I]);
+    TEST_CASE(Pool.Lookup(weak::StringInterner::Global().Intern("absent")) ==
+              Storage::NoAttribute);
+  }
+  SECTION(ShadowedType) {
+    /// Shadowed variable is still alive, so its type can be set.
+    Storage Pool;
+    auto Name = weak::StringInterner::Global().Intern("x");
+    unsigned Outer = Pool.AddDeclaration(Name);
+    Pool.ScopeBegin();
+    unsigned Inner = Pool.AddDeclaration(Name);
+    Pool.SetSymbolType(Outer, TokenType::INT);
+    Pool.SetSymbolType(Inner, TokenType::STRING);
+    Pool.ScopeEnd();
+    TEST_CASE(Pool.GetSymbolType(Outer) == TokenType::INT);
+    TEST_CASE(Pool.GetSymbolType(Inner) == TokenType::STRING);
+  }
+}
@@ -0,0 +1,87 @@
+#include "Utility/StringInterner.hpp"
+#include "FrontEnd/AST/ASTSymbol.hpp"
+#include "MiddleEnd/Symbols/Storage.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "TestHelpers.hpp"
+#include <string>
+#include <vector>
+
+using namespace weak;
+using namespace weak::frontEnd;
+using namespace weak::middleEnd;
+
+int main() {
+  SECTION(Basic) {
+    StringInterner Interner;
+    StringInterner::ID A = Interner.Intern("variable");
+    StringInterner::ID B = Interner.Intern("other");
+    std::string Copy = "variable";
+    TEST_CASE(A != B);
+    TEST_CASE(Interner.Intern(Copy) == A);
+    TEST_CASE(Interner.GetString(A) == "variable");
+    TEST_CASE(Interner.GetString(A).data() != Copy.data());
+    TEST_CASE(Interner.GetString(Interner.Intern("")).empty());
+    TEST_CASE(Interner.Size() == 3U);
+  }
+  SECTION(Growth) {
+    StringInterner Interner;
+    std::vector<std::string_view> Views;
+    for (unsigned I = 0U; I < 100000U; ++I) {
+      StringInterner::ID Identifier = Interner.Intern("v" + std::to_string(I));
+      TEST_CASE(Identifier == I);
+      Views.push_back(Interner.GetString(Identifier));
+    }
+    /// Strings never move.
+    for (unsigned I = 0U; I < 100000U; I += 997U) {
+      TEST_CASE(Views[I] == "v" + std::to_string(I));
+      TEST_CASE(Interner.Intern(Views[I]) == I);
+    }
+  }
+  SECTION(Threads) {
+    StringInterner Interner;
+    ThreadPool Pool(4U);
+    std::vector<std::vector<StringInterner::ID>> Results(8U);
+    for (auto &Result : Results)
+      Pool.Submit([&Interner, &Result] {
+        for (unsigned I = 0U; I < 10000U; ++I)
+          Result.push_back(Interner.Intern("v" + std::to_string(I)));
+      });
+    Pool.Wait();
+    TEST_CASE(Interner.Size() == 10000U);
+    for (const auto &Result : Results)
+      TEST_CASE(Result == Results.front());
+  }
+  SECTION(ThreadsLookup) {
+    StringInterner Interner;
+    ThreadPool Pool(4U);
+    /// Enough strings to fill several pages of identifiers.
+    constexpr unsigned Count = 40000U;
+    std::vector<std::vector<StringInterner::ID>> Results(4U);
+    for (unsigned T = 0U; T < Results.size(); ++T)
+      Pool.Submit([&Interner, &Results, T] {
+        for (unsigned I = 0U; I < Count; ++I) {
+          std::string Own = std::to_string(T) + "_" + std::to_string(I);
+          std::string Shared = "v" + std::to_string(I);
+          StringInterner::ID OwnID = Interner.Intern(Own);
+          StringInterner::ID SharedID = Interner.Intern(Shared);
+          TEST_CASE(Interner.GetString(OwnID) == Own);
+          TEST_CASE(Interner.GetString(SharedID) == Shared);
+          Results[T].push_back(SharedID);
+        }
+      });
+    Pool.Wait();
+    TEST_CASE(Interner.Size() == Count * 5U);
+    for (const auto &Result : Results)
+      TEST_CASE(Result == Results.front());
+    /// Identifiers stay dense.
+    for (StringInterner::ID I = 0U; I < Interner.Size(); ++I)
+      TEST_CASE(Interner.Intern(Interner.GetString(I)) == I);
+  }
+  SECTION(SharedNames) {
+    Storage S;
+    unsigned Attribute = S.AddSymbol("shared");
+    ASTSymbol Symbol("shared");
+    TEST_CASE(S.GetSymbolName(Attribute) == Symbol.GetNameID());
+    TEST_CASE(Symbol.GetName() == "shared");
+  }
+}